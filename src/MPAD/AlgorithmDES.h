@@ -9,13 +9,17 @@
 #define	ALGORITHMDES_H
 
 // include the AlgorithmInterface header file.
-#include "AlgorithmInterface.h";
+#include "AlgorithmInterface.h"
 
 class AlgorithmDES : public AlgorithmInterface
 {
     public:
-        std::string encrpyt(std::string rawString, const char* key, int keyLength);
-        std::string decrypt(std::string encryptedString, const char* key, int keyLength);
+        std::string encrpyt(const std::string& rawString, const char* key, int keyLength);
+        std::string decrypt(const std::string& encryptedString, const char* key, int keyLength);
+        size_t encrypt(const unsigned char* input, size_t length, unsigned char* output, const char* key, int keyLength);
+        size_t decrypt(const unsigned char* input, size_t length, unsigned char* output, const char* key, int keyLength);
+        bool searchKeys(const unsigned char* raw, size_t rawLength, const unsigned char* encrypted, size_t encryptedLength, const KeyPattern& pattern, uint64_t firstCandidate, uint64_t lastCandidate, uint64_t& foundCandidate);
+        bool searchKeys(const std::string& rawString, const std::string& encryptedString, const KeyPattern& pattern, uint64_t firstCandidate, uint64_t lastCandidate, uint64_t& foundCandidate);
 };
 
 #endif	/* ALGORITHMDES_H */
\ No newline at end of file
@@ -0,0 +1,666 @@
+/**
+ * File: AlgorithmDESBitslice.cpp
+ * 
+ * Source code file for the AlgorithmDESBitslice class.
+ * 
+ * @version 0.1
+ */
+
+// include the string library for the std::string class.
+#include <string>
+
+// include the vector library.
+#include <vector>
+
+// include the signature of the class.
+#include "AlgorithmDESBitslice.h"
+
+// include the reference implementation and the bitsliced kernel.
+#include "AlgorithmDES.h"
+#include "DESCore.h"
+#include "BitsliceDES.h"
+
+// include the PasswordPipeline class signature.
+#include "PasswordPipeline.h"
+
+/**
+ * Portable kernel, 64 lanes per pass in a uint64_t.
+ */
+uint64_t bitsliceSearchScalar(uint64_t ipPlain, uint64_t ipCipher, const KeyPattern& pattern, uint64_t base, uint64_t batches, uint64_t* match)
+{
+    return bitsliceSearchBatches<uint64_t>(ipPlain, ipCipher, pattern, base, batches, match);
+}
+
+/**
+ * Portable kernel against a table of ciphertext blocks.
+ */
+uint64_t bitsliceSearchTableScalar(uint64_t ipPlain, const BitsliceBlockTable& table, const KeyPattern& pattern, uint64_t base, uint64_t batches, uint64_t* match)
+{
+    return bitsliceSearchBatchesTable<uint64_t>(ipPlain, table, pattern, base, batches, match);
+}
+
+/**
+ * Portable kernel over a list of keys.
+ */
+uint64_t bitsliceSearchListScalar(uint64_t ipPlain, uint64_t ipCipher, const uint64_t* keys, uint64_t batches, uint64_t* match)
+{
+    return bitsliceSearchBatchesList<uint64_t>(ipPlain, ipCipher, keys, batches, match);
+}
+
+/**
+ * Portable kernel that encrypts or decrypts 64 blocks per pass.
+ */
+void bitsliceCryptScalar(const uint64_t* keySlices, const unsigned char* input, unsigned char* output, size_t blocks, bool decrypt)
+{
+    bitsliceCryptBlocks<uint64_t>(keySlices, input, output, blocks, decrypt);
+}
+
+/**
+ * Number of kernel passes between two looks at the cancel flag: 16K to 128K
+ * keys, well under a millisecond of work.
+ */
+static const uint64_t passesPerPoll = 256;
+
+/**
+ * Constructor method of the class. Picks the widest key-test kernel the CPU
+ * supports (the CPUID checks are done by the compiler runtime).
+ */
+AlgorithmDESBitslice::AlgorithmDESBitslice()
+{
+    this->cancelFlag = NULL;
+    
+    // take the widest kernel there is; the portable one runs everywhere.
+    if (! this->useKernel("avx512") && ! this->useKernel("avx2")) {
+        this->useKernel("scalar");
+    }
+}
+
+/**
+ * Switches to the named key-test kernel ("avx512", "avx2" or "scalar"), for
+ * benchmarking one against the other.
+ * 
+ * @return Whether the kernel exists and the CPU supports it; if not, the
+ * kernel in use stays.
+ */
+bool AlgorithmDESBitslice::useKernel(const char* name)
+{
+    if (0 == strcmp(name, "scalar")) {
+        this->kernelName = "scalar";
+        this->lanes = 64;
+        this->searchKernel = bitsliceSearchScalar;
+        this->tableKernel = bitsliceSearchTableScalar;
+        this->listKernel = bitsliceSearchListScalar;
+        this->cryptKernel = bitsliceCryptScalar;
+        return true;
+    }
+    
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (0 == strcmp(name, "avx512") && __builtin_cpu_supports("avx512f")) {
+        this->kernelName = "avx512";
+        this->lanes = 512;
+        this->searchKernel = bitsliceSearchAVX512;
+        this->tableKernel = bitsliceSearchTableAVX512;
+        this->listKernel = bitsliceSearchListAVX512;
+        this->cryptKernel = bitsliceCryptAVX512;
+        return true;
+    }
+    if (0 == strcmp(name, "avx2") && __builtin_cpu_supports("avx2")) {
+        this->kernelName = "avx2";
+        this->lanes = 256;
+        this->searchKernel = bitsliceSearchAVX2;
+        this->tableKernel = bitsliceSearchTableAVX2;
+        this->listKernel = bitsliceSearchListAVX2;
+        this->cryptKernel = bitsliceCryptAVX2;
+        return true;
+    }
+#endif
+    
+    return false;
+}
+
+/**
+ * Returns the name of the key-test kernel in use.
+ */
+const char* AlgorithmDESBitslice::getKernelName()
+{
+    return this->kernelName;
+}
+
+/**
+ * Returns the number of candidate keys the kernel tests in one pass.
+ */
+int AlgorithmDESBitslice::getLanes()
+{
+    return this->lanes;
+}
+
+/**
+ * Sets a flag that searchKeys checks every few hundred kernel passes; once
+ * it is set, searchKeys gives up and returns false.
+ * 
+ * @param cancelFlag The flag, or NULL to never give up.
+ */
+void AlgorithmDESBitslice::setCancelFlag(const std::atomic<bool>* cancelFlag)
+{
+    this->cancelFlag = cancelFlag;
+}
+
+/**
+ * Encrypts the raw string (padded with spaces to whole blocks) with the given
+ * key string.
+ */
+std::string AlgorithmDESBitslice::encrpyt(const std::string& rawString, const char* key, int keyLength)
+{
+    std::string data(AlgorithmInterface::encryptedLength(rawString.size()), '\0');
+    this->encrypt((const unsigned char*) rawString.data(), rawString.size(), (unsigned char*) &data[0], key, keyLength);
+    
+    return data;
+}
+
+/**
+ * Decrypts the encrypted string with the given key string and trims the
+ * padding, exactly as AlgorithmDES does.
+ */
+std::string AlgorithmDESBitslice::decrypt(const std::string& encryptedString, const char* key, int keyLength)
+{
+    std::string data(encryptedString.size() - encryptedString.size() % 8, '\0');
+    this->decrypt((const unsigned char*) encryptedString.data(), encryptedString.size(), (unsigned char*) &data[0], key, keyLength);
+    
+    size_t start, end;
+    AlgorithmInterface::trimBounds((const unsigned char*) data.data(), data.size(), start, end);
+    
+    return data.substr(start, end - start);
+}
+
+/**
+ * Encrypts a buffer, padded with spaces to whole blocks, into
+ * encryptedLength(length) bytes of the output buffer.
+ * 
+ * @return The number of bytes written.
+ */
+size_t AlgorithmDESBitslice::encrypt(const unsigned char* input, size_t length, unsigned char* output, const char* key, int keyLength)
+{
+    size_t whole = length - length % 8;
+    this->crypt(input, whole, output, key, keyLength, false);
+    
+    // pad the last block with spaces, just like the Des class does.
+    if (whole < length) {
+        unsigned char block[8];
+        memset(block, ' ', sizeof(block));
+        memcpy(block, input + whole, length - whole);
+        this->crypt(block, 8, output + whole, key, keyLength, false);
+        whole += 8;
+    }
+    
+    return whole;
+}
+
+/**
+ * Decrypts the whole blocks of a buffer; the padding is left in place.
+ * 
+ * @return The number of bytes written.
+ */
+size_t AlgorithmDESBitslice::decrypt(const unsigned char* input, size_t length, unsigned char* output, const char* key, int keyLength)
+{
+    size_t whole = length - length % 8;
+    this->crypt(input, whole, output, key, keyLength, true);
+    
+    return whole;
+}
+
+/**
+ * Encrypts or decrypts the whole blocks of a buffer with a single key, 64
+ * blocks per pass.
+ * 
+ * @param length Length of the buffer; whole blocks only.
+ */
+void AlgorithmDESBitslice::crypt(const unsigned char* input, size_t length, unsigned char* output, const char* key, int keyLength, bool decrypt)
+{
+    this->cryptBlocks(DESCore::keyFromString(key, keyLength), input, output, length / 8, decrypt);
+}
+
+/**
+ * Encrypts or decrypts whole blocks with a single key, as many per pass as
+ * the kernel has lanes. The output may be the input.
+ * 
+ * @param key The 64-bit DES key.
+ * @param blocks Number of 8-byte blocks.
+ */
+void AlgorithmDESBitslice::cryptBlocks(uint64_t key, const unsigned char* input, unsigned char* output, size_t blocks, bool decrypt)
+{
+    // every lane uses the same key; so each key slice is all ones or zeros.
+    uint64_t keySlices[64];
+    for (int position = 0; position < 64; position++) {
+        keySlices[position] = ((key >> (63 - position)) & 1) ? ~0ULL : 0ULL;
+    }
+    
+    this->cryptKernel(keySlices, input, output, blocks, decrypt);
+}
+
+/**
+ * Tests the candidate keys against a known raw/encrypted string pair; see the
+ * buffer version below.
+ */
+bool AlgorithmDESBitslice::searchKeys(const std::string& rawString, const std::string& encryptedString, const KeyPattern& pattern, uint64_t firstCandidate, uint64_t lastCandidate, uint64_t& foundCandidate)
+{
+    return this->searchKeys((const unsigned char*) rawString.data(), rawString.size(), (const unsigned char*) encryptedString.data(), encryptedString.size(), pattern, firstCandidate, lastCandidate, foundCandidate);
+}
+
+/**
+ * Tests the candidate keys in [firstCandidate, lastCandidate) one kernel pass
+ * at a time against the first block of the known raw/encrypted pair. Lanes
+ * that match are confirmed against the whole text before they are reported.
+ * 
+ * @param foundCandidate Receives the matching candidate, if any.
+ * @return Whether a matching candidate was found.
+ */
+bool AlgorithmDESBitslice::searchKeys(const unsigned char* raw, size_t rawLength, const unsigned char* encrypted, size_t encryptedLength, const KeyPattern& pattern, uint64_t firstCandidate, uint64_t lastCandidate, uint64_t& foundCandidate)
+{
+    // the reference implementation does the whole job if there isn't a full
+    // block to work with.
+    if (8 > rawLength || 8 > encryptedLength) {
+        return this->reference.searchKeys(raw, rawLength, encrypted, encryptedLength, pattern, firstCandidate, lastCandidate, foundCandidate);
+    }
+    
+    // the first blocks of the raw and the encrypted text form the known
+    // plaintext/ciphertext pair; they are compared in the permuted domain.
+    uint64_t ipPlain = bitslicePermute(bitsliceLoadBlock(raw), bitsliceIP);
+    uint64_t ipCipher = bitslicePermute(bitsliceLoadBlock(encrypted), bitsliceIP);
+    
+    // the lanes that survive are decrypted in full into a scratch buffer.
+    ArenaScope scope(this->scratch);
+    size_t dataLength = encryptedLength - encryptedLength % 8;
+    unsigned char* data = this->scratch.allocateArray<unsigned char>(dataLength);
+    DESCore crypto;
+    
+    const uint64_t lanes = this->lanes;
+    uint64_t base = firstCandidate & ~(lanes - 1);
+    while (base < lastCandidate) {
+        // stop early if the search has been cancelled.
+        if (NULL != this->cancelFlag && this->cancelFlag->load(std::memory_order_relaxed)) {
+            return false;
+        }
+        
+        // run the kernel up to the first batch that has a matching lane, but
+        // no further than the next look at the cancel flag.
+        uint64_t batches = (lastCandidate - base + lanes - 1) / lanes;
+        if (NULL != this->cancelFlag && batches > passesPerPoll) {
+            batches = passesPerPoll;
+        }
+        uint64_t match[8];
+        uint64_t batch = this->searchKernel(ipPlain, ipCipher, pattern, base, batches, match);
+        if (batch == batches) {
+            base += batches * lanes;
+            continue;
+        }
+        base += batch * lanes;
+        
+        for (uint64_t word = 0; word < lanes / 64; word++) {
+            uint64_t wordBase = base + word * 64;
+            
+            // drop the lanes that are outside of the requested range.
+            if (wordBase + 64 <= firstCandidate || wordBase >= lastCandidate) {
+                continue;
+            }
+            if (wordBase < firstCandidate) {
+                match[word] &= ~0ULL << (firstCandidate - wordBase);
+            }
+            if (lastCandidate - wordBase < 64) {
+                match[word] &= (1ULL << (lastCandidate - wordBase)) - 1;
+            }
+            
+            // confirm every lane that survived against the whole text.
+            while (0 != match[word]) {
+                uint64_t candidate = wordBase + __builtin_ctzll(match[word]);
+                match[word] &= match[word] - 1;
+                
+                crypto.setKey(pattern.getKey(candidate));
+                crypto.decrypt(encrypted, data, dataLength);
+                if (AlgorithmInterface::matchesRawString(raw, rawLength, data, dataLength)) {
+                    foundCandidate = candidate;
+                    return true;
+                }
+            }
+        }
+        
+        // a false alarm; carry on with the next batch.
+        base += lanes;
+    }
+    
+    return false;
+}
+
+/**
+ * Tests the keys on lines [firstCandidate, lastCandidate) of a key list, one
+ * kernel pass at a time, against the first block of the known raw/encrypted
+ * pair. Lanes that match are confirmed against the whole text before they
+ * are reported.
+ * 
+ * @param foundCandidate Receives the line of the matching key, if any.
+ * @return Whether a matching key was found.
+ */
+bool AlgorithmDESBitslice::searchKeyList(const std::string& rawString, const std::string& encryptedString, const KeyList& keys, uint64_t firstCandidate, uint64_t lastCandidate, uint64_t& foundCandidate)
+{
+    // the keys of the kernel passes between two looks at the cancel flag are
+    // decoded into a scratch buffer, no larger than the chunk.
+    ArenaScope scope(this->scratch);
+    const uint64_t batchSize = this->getBatchSize(lastCandidate - firstCandidate);
+    uint64_t* buffer = this->scratch.allocateArray<uint64_t>(batchSize);
+    for (uint64_t base = firstCandidate; base < lastCandidate; base += batchSize) {
+        if (NULL != this->cancelFlag && this->cancelFlag->load(std::memory_order_relaxed)) {
+            return false;
+        }
+        
+        uint64_t count = lastCandidate - base;
+        if (count > batchSize) {
+            count = batchSize;
+        }
+        keys.getKeys(base, count, buffer);
+        
+        // a line that isn't a valid key was tested as key zero; it can't be
+        // reported.
+        uint64_t key;
+        for (uint64_t index = 0; this->searchKeyArray(rawString, encryptedString, buffer, count, index); index++) {
+            if (keys.getKey(base + index, key)) {
+                foundCandidate = base + index;
+                return true;
+            }
+        }
+    }
+    
+    return false;
+}
+
+/**
+ * Tests the keys of the words that start in [firstCandidate, lastCandidate)
+ * of a word list against the first block of the known raw/encrypted pair,
+ * while a PasswordPipeline derives the keys of the next words. Lanes that
+ * match are confirmed against the whole text before they are reported.
+ * 
+ * @param foundCandidate Receives the offset of the matching word, if any.
+ * @return Whether a matching word was found.
+ */
+bool AlgorithmDESBitslice::searchWordList(const std::string& rawString, const std::string& encryptedString, const WordList& words, uint64_t firstCandidate, uint64_t lastCandidate, uint64_t& foundCandidate)
+{
+    // a batch is as many keys as the kernel passes between two looks at the
+    // cancel flag, or as the words of a short chunk: every word takes up
+    // two bytes at least, with its newline.
+    ArenaScope scope(this->scratch);
+    PasswordPipeline pipeline(words, firstCandidate, lastCandidate, this->getBatchSize((lastCandidate - firstCandidate) / 2 + 1), this->scratch);
+    const uint64_t* keys;
+    const uint64_t* positions;
+    size_t count;
+    while (pipeline.next(keys, positions, count)) {
+        if (NULL != this->cancelFlag && this->cancelFlag->load(std::memory_order_relaxed)) {
+            return false;
+        }
+        
+        uint64_t index = 0;
+        if (this->searchKeyArray(rawString, encryptedString, keys, count, index)) {
+            foundCandidate = positions[index];
+            return true;
+        }
+        pipeline.release();
+    }
+    
+    return false;
+}
+
+/**
+ * Returns the number of keys of the kernel passes between two looks at the
+ * cancel flag, or of the fewest whole passes that test the given number of
+ * keys if that is less.
+ */
+uint64_t AlgorithmDESBitslice::getBatchSize(uint64_t keys)
+{
+    const uint64_t lanes = this->lanes;
+    uint64_t passes = (keys + lanes - 1) / lanes;
+    return ((passes < passesPerPoll) ? passes : passesPerPoll) * lanes;
+}
+
+/**
+ * Tests keys[index] to keys[count - 1], one kernel pass at a time, against
+ * the first block of the known raw/encrypted pair, and confirms the lanes
+ * that match against the whole text.
+ * 
+ * @param keys The keys, with room for whole kernel passes; the ones from
+ * count on are ignored.
+ * @param index The first key to test; receives the index of the matching
+ * key, if any.
+ * @return Whether a matching key was found.
+ */
+bool AlgorithmDESBitslice::searchKeyArray(const std::string& rawString, const std::string& encryptedString, const uint64_t* keys, uint64_t count, uint64_t& index)
+{
+    const unsigned char* raw = (const unsigned char*) rawString.data();
+    const unsigned char* encrypted = (const unsigned char*) encryptedString.data();
+    ArenaScope scope(this->scratch);
+    size_t dataLength = encryptedString.size() - encryptedString.size() % 8;
+    unsigned char* data = this->scratch.allocateArray<unsigned char>(dataLength);
+    DESCore crypto;
+    
+    // without a full block to work with, every key is tried in full.
+    if (8 > rawString.size() || 8 > encryptedString.size()) {
+        for (uint64_t candidate = index; candidate < count; candidate++) {
+            crypto.setKey(keys[candidate]);
+            crypto.decrypt(encrypted, data, dataLength);
+            if (AlgorithmInterface::matchesRawString(raw, rawString.size(), data, dataLength)) {
+                index = candidate;
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    uint64_t ipPlain = bitslicePermute(bitsliceLoadBlock(raw), bitsliceIP);
+    uint64_t ipCipher = bitslicePermute(bitsliceLoadBlock(encrypted), bitsliceIP);
+    
+    const uint64_t lanes = this->lanes;
+    const uint64_t first = index;
+    uint64_t base = first & ~(lanes - 1);
+    while (base < count) {
+        uint64_t batches = (count - base + lanes - 1) / lanes;
+        uint64_t match[8];
+        uint64_t batch = this->listKernel(ipPlain, ipCipher, keys + base, batches, match);
+        if (batch == batches) {
+            break;
+        }
+        base += batch * lanes;
+        
+        for (uint64_t word = 0; word < lanes / 64; word++) {
+            uint64_t wordBase = base + word * 64;
+            if (wordBase + 64 <= first || wordBase >= count) {
+                continue;
+            }
+            if (wordBase < first) {
+                match[word] &= ~0ULL << (first - wordBase);
+            }
+            if (count - wordBase < 64) {
+                match[word] &= (1ULL << (count - wordBase)) - 1;
+            }
+            
+            while (0 != match[word]) {
+                uint64_t candidate = wordBase + __builtin_ctzll(match[word]);
+                match[word] &= match[word] - 1;
+                
+                crypto.setKey(keys[candidate]);
+                crypto.decrypt(encrypted, data, dataLength);
+                if (AlgorithmInterface::matchesRawString(raw, rawString.size(), data, dataLength)) {
+                    index = candidate;
+                    return true;
+                }
+            }
+        }
+        
+        base += lanes;
+    }
+    
+    return false;
+}
+
+/**
+ * Tests the candidate keys in [firstCandidate, lastCandidate) against every
+ * target of a batch that doesn't have its key yet: one kernel pass per group
+ * of targets that share a first plaintext block, the result looked up among
+ * the first ciphertext blocks of the group. Lanes that hit are confirmed
+ * against the whole text of the target before they are reported to the set.
+ * 
+ * @return The number of targets whose key was found.
+ */
+int AlgorithmDESBitslice::searchTargets(TargetSet& targets, const KeyPattern& pattern, uint64_t firstCandidate, uint64_t lastCandidate)
+{
+    int numberFound = 0;
+    DESCore crypto;
+    
+    for (int group = 0; group < targets.getNumberOfGroups(); group++) {
+        const std::vector<int>& members = targets.getGroupTargets(group);
+        
+        // a group of one is searched the usual way, with the kernel that
+        // rejects most lanes before the last round.
+        if (1 == members.size()) {
+            uint64_t candidate;
+            if (! targets.isFound(members[0]) && this->searchKeys(targets.getRawString(members[0]), targets.getEncryptedString(members[0]), pattern, firstCandidate, lastCandidate, candidate)
+                && targets.reportFound(members[0], candidate)) {
+                numberFound++;
+            }
+            continue;
+        }
+        
+        const uint64_t ipPlain = targets.getGroupPlain(group);
+        const BitsliceBlockTable& table = targets.getGroupTable(group);
+        const uint64_t lanes = this->lanes;
+        uint64_t base = firstCandidate & ~(lanes - 1);
+        while (base < lastCandidate && ! targets.isGroupDone(group)) {
+            if (NULL != this->cancelFlag && this->cancelFlag->load(std::memory_order_relaxed)) {
+                return numberFound;
+            }
+            
+            uint64_t batches = (lastCandidate - base + lanes - 1) / lanes;
+            if (NULL != this->cancelFlag && batches > passesPerPoll) {
+                batches = passesPerPoll;
+            }
+            uint64_t match[8];
+            uint64_t batch = this->tableKernel(ipPlain, table, pattern, base, batches, match);
+            if (batch == batches) {
+                base += batches * lanes;
+                continue;
+            }
+            base += batch * lanes;
+            
+            for (uint64_t word = 0; word < lanes / 64; word++) {
+                uint64_t wordBase = base + word * 64;
+                if (wordBase + 64 <= firstCandidate || wordBase >= lastCandidate) {
+                    continue;
+                }
+                if (wordBase < firstCandidate) {
+                    match[word] &= ~0ULL << (firstCandidate - wordBase);
+                }
+                if (lastCandidate - wordBase < 64) {
+                    match[word] &= (1ULL << (lastCandidate - wordBase)) - 1;
+                }
+                
+                // a lane that hits the table hits one or more of the
+                // targets; each of them is confirmed on its own.
+                while (0 != match[word]) {
+                    uint64_t candidate = wordBase + __builtin_ctzll(match[word]);
+                    match[word] &= match[word] - 1;
+                    
+                    crypto.setKey(pattern.getKey(candidate));
+                    unsigned char block[8];
+                    crypto.encryptBlock((const unsigned char*) targets.getRawString(members[0]).data(), block);
+                    uint64_t ipCipher = bitslicePermute(bitsliceLoadBlock(block), bitsliceIP);
+                    
+                    for (size_t i = 0; i < members.size(); i++) {
+                        if (ipCipher != targets.getCipherBlock(members[i]) || targets.isFound(members[i])) {
+                            continue;
+                        }
+                        const std::string& raw = targets.getRawString(members[i]);
+                        const std::string& encrypted = targets.getEncryptedString(members[i]);
+                        ArenaScope scope(this->scratch);
+                        size_t dataLength = encrypted.size() - encrypted.size() % 8;
+                        unsigned char* data = this->scratch.allocateArray<unsigned char>(dataLength);
+                        crypto.decrypt((const unsigned char*) encrypted.data(), data, dataLength);
+                        if (AlgorithmInterface::matchesRawString((const unsigned char*) raw.data(), raw.size(), data, dataLength)
+                            && targets.reportFound(members[i], candidate)) {
+                            numberFound++;
+                        }
+                    }
+                }
+            }
+            
+            base += lanes;
+        }
+    }
+    
+    return numberFound;
+}
+
+/**
+ * Known-answer test of the bitsliced code: encrypts a fixed block under 64
+ * different keys in one pass and compares every lane with the result of
+ * AlgorithmDES, then checks that the selected key-test kernel picks out known
+ * keys from a batch.
+ * 
+ * @return Whether every check agrees with AlgorithmDES.
+ */
+bool AlgorithmDESBitslice::selfTest()
+{
+    const int keyLength = 56;
+    const KeyPattern pattern(keyLength);
+    const uint64_t base = 0x3C5A96F0E1D000ULL;
+    const char plainText[] = "MPAD-KAT";
+    
+    // 64 consecutive candidates, one per lane, all encrypting the same block.
+    uint64_t keySlices[64], slices[64];
+    bitsliceLoadCandidates(keySlices, pattern, base);
+    uint64_t plainBlock = bitsliceLoadBlock((const unsigned char*) plainText);
+    for (int position = 0; position < 64; position++) {
+        slices[position] = ((plainBlock >> (63 - position)) & 1) ? ~0ULL : 0ULL;
+    }
+    bitsliceCrypt(keySlices, slices, false);
+    
+    // after the transposition, the block of lane j is word 63 - j.
+    bitsliceTranspose64(slices);
+    
+    AlgorithmDES reference;
+    char candidateKey[65];
+    for (int lane = 0; lane < 64; lane++) {
+        unsigned char block[8];
+        bitsliceStoreBlock(slices[63 - lane], block);
+        
+        AlgorithmInterface::candidateToKey(base + lane, keyLength, candidateKey);
+        unsigned char expected[8];
+        reference.encrypt((const unsigned char*) plainText, 8, expected, candidateKey, keyLength);
+        
+        if (0 != memcmp(block, expected, 8)) {
+            return false;
+        }
+    }
+    
+    // plant a key in the first, a middle and the last lane of a kernel batch;
+    // the kernel must report that lane and only keys that differ from it in
+    // the (ignored) parity bits.
+    const uint64_t parityBits = 0x0101010101010101ULL;
+    const uint64_t ipPlain = bitslicePermute(plainBlock, bitsliceIP);
+    const int lanes[3] = { 0, this->lanes / 2 + 5, this->lanes - 1 };
+    for (int i = 0; i < 3; i++) {
+        AlgorithmInterface::candidateToKey(base + lanes[i], keyLength, candidateKey);
+        unsigned char cipherText[8];
+        this->encrypt((const unsigned char*) plainText, 8, cipherText, candidateKey, keyLength);
+        uint64_t ipCipher = bitslicePermute(bitsliceLoadBlock(cipherText), bitsliceIP);
+        
+        uint64_t match[8];
+        this->searchKernel(ipPlain, ipCipher, pattern, base, 1, match);
+        
+        uint64_t plantedKey = pattern.getKey(base + lanes[i]);
+        for (int lane = 0; lane < this->lanes; lane++) {
+            uint64_t laneKey = pattern.getKey(base + lane);
+            bool expected = (0 == ((laneKey ^ plantedKey) & ~parityBits));
+            if (expected != (0 != ((match[lane / 64] >> (lane % 64)) & 1))) {
+                return false;
+            }
+        }
+    }
+    
+    return true;
+}
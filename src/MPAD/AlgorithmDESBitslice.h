@@ -0,0 +1,257 @@
+/**
+ * File: AlgorithmDESBitslice.h
+ * 
+ * Header file for the AlgorithmDESBitslice class.
+ * 
+ * @version 0.1
+ */
+
+// make sure that the signature of the class is defined only once.
+#ifndef ALGORITHMDESBITSLICE_H
+#define	ALGORITHMDESBITSLICE_H
+
+// include the AlgorithmInterface header file.
+#include "AlgorithmInterface.h"
+
+// include the reference implementation.
+#include "AlgorithmDES.h"
+
+// include the kernel declarations.
+#include "BitsliceKernels.h"
+
+// include the TargetSet class signature.
+#include "TargetSet.h"
+
+// include the KeyList class signature.
+#include "KeyList.h"
+
+// include the WordList class signature.
+#include "WordList.h"
+
+// include the atomic library for the cancel flag.
+#include <atomic>
+
+/**
+ * Signature of the AlgorithmDESBitslice class.
+ * 
+ * AlgorithmDESBitslice is a bitsliced DES engine: every bit of the DES state
+ * lives in its own 64-bit word and the S-boxes are evaluated as boolean
+ * circuits, so 64 independent DES operations run side by side. For the key
+ * search those are consecutive candidate keys; for encrpyt/decrypt they are
+ * blocks of the text under the same key.
+ * 
+ * The key search and encrpyt/decrypt use the widest kernel the CPU supports
+ * (AVX-512, AVX2 or the portable uint64_t one), chosen once when the engine
+ * is constructed.
+ * 
+ * @since version 0.1
+ * @see AlgorithmDES
+ */
+class AlgorithmDESBitslice : public AlgorithmInterface
+{
+    // public attributes and methods of the class.
+    public:
+        
+        /**
+         * Constructor method of the class. Picks the widest key-test kernel
+         * the CPU supports.
+         */
+        AlgorithmDESBitslice();
+        
+        /**
+         * Returns the name of the key-test kernel in use.
+         */
+        const char* getKernelName();
+        
+        /**
+         * Switches to the named key-test kernel ("avx512", "avx2" or
+         * "scalar"), for benchmarking one against the other.
+         * 
+         * @return Whether the kernel exists and the CPU supports it; if not,
+         * the kernel in use stays.
+         */
+        bool useKernel(const char* name);
+        
+        /**
+         * Returns the number of candidate keys the kernel tests in one pass.
+         */
+        int getLanes();
+        
+        /**
+         * Sets a flag that searchKeys checks every few hundred kernel
+         * passes; once it is set, searchKeys gives up and returns false.
+         * 
+         * @param cancelFlag The flag, or NULL to never give up.
+         */
+        void setCancelFlag(const std::atomic<bool>* cancelFlag);
+        
+        /**
+         * Encrypts the raw string (padded with spaces to whole blocks) with
+         * the given key string.
+         */
+        std::string encrpyt(const std::string& rawString, const char* key, int keyLength);
+        
+        /**
+         * Decrypts the encrypted string with the given key string and trims
+         * the padding, exactly as AlgorithmDES does.
+         */
+        std::string decrypt(const std::string& encryptedString, const char* key, int keyLength);
+        
+        /**
+         * Encrypts a buffer, padded with spaces to whole blocks, into
+         * encryptedLength(length) bytes of the output buffer.
+         * 
+         * @return The number of bytes written.
+         */
+        size_t encrypt(const unsigned char* input, size_t length, unsigned char* output, const char* key, int keyLength);
+        
+        /**
+         * Decrypts the whole blocks of a buffer; the padding is left in
+         * place.
+         * 
+         * @return The number of bytes written.
+         */
+        size_t decrypt(const unsigned char* input, size_t length, unsigned char* output, const char* key, int keyLength);
+        
+        /**
+         * Encrypts or decrypts whole blocks with a single key, as many per
+         * pass as the kernel has lanes (ECB). The output may be the input.
+         * 
+         * @param key The 64-bit DES key.
+         * @param blocks Number of 8-byte blocks.
+         */
+        void cryptBlocks(uint64_t key, const unsigned char* input, unsigned char* output, size_t blocks, bool decrypt);
+        
+        /**
+         * Tests the candidate keys in [firstCandidate, lastCandidate) one
+         * kernel pass at a time against the first block of the known
+         * raw/encrypted pair. Lanes that match are confirmed against the
+         * whole text before they are reported.
+         * 
+         * @param foundCandidate Receives the matching candidate, if any.
+         * @return Whether a matching candidate was found.
+         */
+        bool searchKeys(const unsigned char* raw, size_t rawLength, const unsigned char* encrypted, size_t encryptedLength, const KeyPattern& pattern, uint64_t firstCandidate, uint64_t lastCandidate, uint64_t& foundCandidate);
+        bool searchKeys(const std::string& rawString, const std::string& encryptedString, const KeyPattern& pattern, uint64_t firstCandidate, uint64_t lastCandidate, uint64_t& foundCandidate);
+        
+        /**
+         * Tests the keys on lines [firstCandidate, lastCandidate) of a key
+         * list, one kernel pass at a time, against the first block of the
+         * known raw/encrypted pair. Lanes that match are confirmed against
+         * the whole text before they are reported.
+         * 
+         * @param foundCandidate Receives the line of the matching key, if
+         * any.
+         * @return Whether a matching key was found.
+         */
+        bool searchKeyList(const std::string& rawString, const std::string& encryptedString, const KeyList& keys, uint64_t firstCandidate, uint64_t lastCandidate, uint64_t& foundCandidate);
+        
+        /**
+         * Tests the keys of the words that start in [firstCandidate,
+         * lastCandidate) of a word list against the first block of the
+         * known raw/encrypted pair, while a PasswordPipeline derives the
+         * keys of the next words. Lanes that match are confirmed against the
+         * whole text before they are reported.
+         * 
+         * @param foundCandidate Receives the offset of the matching word, if
+         * any.
+         * @return Whether a matching word was found.
+         */
+        bool searchWordList(const std::string& rawString, const std::string& encryptedString, const WordList& words, uint64_t firstCandidate, uint64_t lastCandidate, uint64_t& foundCandidate);
+        
+        /**
+         * Tests the candidate keys in [firstCandidate, lastCandidate) against
+         * every target of a batch that doesn't have its key yet: one kernel
+         * pass per group of targets that share a first plaintext block, the
+         * result looked up among the first ciphertext blocks of the group.
+         * Lanes that hit are confirmed against the whole text of the target
+         * before they are reported to the set.
+         * 
+         * @return The number of targets whose key was found.
+         */
+        int searchTargets(TargetSet& targets, const KeyPattern& pattern, uint64_t firstCandidate, uint64_t lastCandidate);
+        
+        /**
+         * Known-answer test of the bitsliced code: encrypts a fixed block
+         * under 64 different keys in one pass and compares every lane with
+         * the result of AlgorithmDES, then checks that the selected key-test
+         * kernel picks out known keys from a batch.
+         * 
+         * @return Whether every check agrees with AlgorithmDES.
+         */
+        bool selfTest();
+        
+    // private attributes and methods of the class.
+    private:
+        
+        /**
+         * Name of the key-test kernel in use.
+         */
+        const char* kernelName;
+        
+        /**
+         * Number of candidate keys the kernel tests in one pass.
+         */
+        int lanes;
+        
+        /**
+         * The key-test kernel in use.
+         */
+        BitsliceSearchKernel searchKernel;
+        
+        /**
+         * The key-test kernel in use for batches of targets.
+         */
+        BitsliceTableKernel tableKernel;
+        
+        /**
+         * The key-test kernel in use for key lists.
+         */
+        BitsliceListKernel listKernel;
+        
+        /**
+         * The kernel in use for encrpyt/decrypt.
+         */
+        BitsliceCryptKernel cryptKernel;
+        
+        /**
+         * The flag that cancels a running search, if any.
+         */
+        const std::atomic<bool>* cancelFlag;
+        
+        /**
+         * The engine that searches the texts shorter than a block.
+         */
+        AlgorithmDES reference;
+        
+        /**
+         * Encrypts or decrypts the whole blocks of a buffer with a single
+         * key, as many blocks per pass as the kernel has lanes.
+         * 
+         * @param length Length of the buffer; whole blocks only.
+         */
+        void crypt(const unsigned char* input, size_t length, unsigned char* output, const char* key, int keyLength, bool decrypt);
+        
+        /**
+         * Returns the number of keys of the kernel passes between two looks
+         * at the cancel flag, or of the fewest whole passes that test the
+         * given number of keys if that is less.
+         */
+        uint64_t getBatchSize(uint64_t keys);
+        
+        /**
+         * Tests keys[index] to keys[count - 1], one kernel pass at a time,
+         * against the first block of the known raw/encrypted pair, and
+         * confirms the lanes that match against the whole text.
+         * 
+         * @param keys The keys, with room for whole kernel passes; the ones
+         * from count on are ignored.
+         * @param index The first key to test; receives the index of the
+         * matching key, if any.
+         * @return Whether a matching key was found.
+         */
+        bool searchKeyArray(const std::string& rawString, const std::string& encryptedString, const uint64_t* keys, uint64_t count, uint64_t& index);
+};
+
+// end of the class signature.
+#endif	/* ALGORITHMDESBITSLICE_H */
@@ -0,0 +1,27 @@
+/* 
+ * File:   AlgorithmDESLegacy.h
+ * Author: onuryaman
+ *
+ * Created on December 12, 2011, 11:15 AM
+ * 
+ * The original bit-per-int DES implementation (see AlgorithmDESLegacy.cpp).
+ */
+
+#ifndef ALGORITHMDESLEGACY_H
+#define	ALGORITHMDESLEGACY_H
+
+// include the AlgorithmInterface header file.
+#include "AlgorithmInterface.h"
+
+class AlgorithmDESLegacy : public AlgorithmInterface
+{
+    public:
+        std::string encrpyt(const std::string& rawString, const char* key, int keyLength);
+        std::string decrypt(const std::string& encryptedString, const char* key, int keyLength);
+        size_t encrypt(const unsigned char* input, size_t length, unsigned char* output, const char* key, int keyLength);
+        size_t decrypt(const unsigned char* input, size_t length, unsigned char* output, const char* key, int keyLength);
+        bool searchKeys(const unsigned char* raw, size_t rawLength, const unsigned char* encrypted, size_t encryptedLength, const KeyPattern& pattern, uint64_t firstCandidate, uint64_t lastCandidate, uint64_t& foundCandidate);
+        bool searchKeys(const std::string& rawString, const std::string& encryptedString, const KeyPattern& pattern, uint64_t firstCandidate, uint64_t lastCandidate, uint64_t& foundCandidate);
+};
+
+#endif	/* ALGORITHMDESLEGACY_H */
\ No newline at end of file
@@ -9,13 +9,196 @@
 #define	ALGORITHMINTERFACE_H
 
 // include the string library for the std::string class.
+#include <string>
+
+// include the fixed-width integer types.
+#include <stdint.h>
+
+// include the size_t type.
+#include <stddef.h>
+
+// include the memcmp and strlen functions.
 #include <string.h>
 
+// include the KeyPattern class signature.
+#include "KeyPattern.h"
+
+// include the Arena class signature.
+#include "Arena.h"
+
+/**
+ * The methods every algorithm provides. The buffer methods take a pointer
+ * and a length, never look for a terminating NUL and write into a buffer the
+ * caller owns, so binary ciphertext is handled as it is and nothing is
+ * allocated per call. The std::string methods are wrappers around them.
+ * 
+ * The methods are virtual, so that an engine picked from the
+ * AlgorithmRegistry can be used through this interface. The key search
+ * calls its engine's searchKeys directly instead (see AlgorithmEngine), so
+ * that nothing is dispatched at run time while it runs.
+ * 
+ * Every engine has an arena for the scratch buffers of its searches. A
+ * worker has an engine of its own and searches chunk after chunk with it, so
+ * once the first chunk has sized the arena, its searches don't allocate.
+ */
 class AlgorithmInterface
 {
     public:
-        std::string encrpyt(std::string rawString, const char* key, int keyLength);
-        std::string decrypt(std::string encryptedString, const char* key, int keyLength);
+        virtual ~AlgorithmInterface()
+        {
+        }
+        
+        virtual std::string encrpyt(const std::string& rawString, const char* key, int keyLength) = 0;
+        virtual std::string decrypt(const std::string& encryptedString, const char* key, int keyLength) = 0;
+        
+        /**
+         * Encrypts a buffer, padded with spaces to whole blocks.
+         * 
+         * @param output Receives encryptedLength(length) bytes.
+         * @return The number of bytes written.
+         */
+        virtual size_t encrypt(const unsigned char* input, size_t length, unsigned char* output, const char* key, int keyLength) = 0;
+        
+        /**
+         * Decrypts the whole blocks of a buffer. The padding is left in
+         * place; see trimBounds.
+         * 
+         * @param output Receives length - length % 8 bytes.
+         * @return The number of bytes written.
+         */
+        virtual size_t decrypt(const unsigned char* input, size_t length, unsigned char* output, const char* key, int keyLength) = 0;
+        
+        /**
+         * Tests the candidate keys in [firstCandidate, lastCandidate) against
+         * a known raw/encrypted pair. Candidate i stands for the key the key
+         * pattern gives it (see KeyPattern). A candidate matches if the
+         * decrypted text equals the raw text once trimmed (see
+         * matchesRawString).
+         * 
+         * @param foundCandidate Receives the matching candidate, if any.
+         * @return Whether a matching candidate was found.
+         */
+        virtual bool searchKeys(const unsigned char* raw, size_t rawLength, const unsigned char* encrypted, size_t encryptedLength, const KeyPattern& pattern, uint64_t firstCandidate, uint64_t lastCandidate,
+            uint64_t& foundCandidate) = 0;
+        virtual bool searchKeys(const std::string& rawString, const std::string& encryptedString, const KeyPattern& pattern, uint64_t firstCandidate, uint64_t lastCandidate, uint64_t& foundCandidate) = 0;
+        
+        /**
+         * Returns the length of the ciphertext of a text of the given length
+         * (the text is padded to whole blocks).
+         */
+        static size_t encryptedLength(size_t length)
+        {
+            return (length + 7) & ~(size_t) 7;
+        }
+        
+        /**
+         * Finds the part of a decrypted buffer that is left after trimming
+         * the padding (and any other character up to the space) from both
+         * ends.
+         */
+        static void trimBounds(const unsigned char* data, size_t length, size_t& start, size_t& end)
+        {
+            start = 0;
+            end = length;
+            
+            while (start < end && 32 >= data[start]) {
+                start++;
+            }
+            while (end > start && 32 >= data[end - 1]) {
+                end--;
+            }
+        }
+        
+        /**
+         * Tells whether a decrypted buffer, once trimmed, equals the raw
+         * text.
+         */
+        static bool matchesRawString(const unsigned char* raw, size_t rawLength, const unsigned char* data, size_t length)
+        {
+            size_t start, end;
+            trimBounds(data, length, start, end);
+            
+            return rawLength == end - start && 0 == memcmp(raw, data + start, rawLength);
+        }
+        
+        /**
+         * Writes the NUL-terminated key string ('0'/'1' characters, most
+         * significant bit first) of a candidate into the given buffer, which
+         * must hold at least keyLength + 1 characters.
+         */
+        static void candidateToKey(uint64_t candidate, int keyLength, char* key)
+        {
+            for (int j = 0; j < keyLength; j++) {
+                key[keyLength - j - 1] = ((candidate >> j) & 1) ? '1' : '0';
+            }
+            key[keyLength] = '\0';
+        }
+        
+        /**
+         * Encodes binary data as lowercase hex, so that it can travel in an
+         * argv entry without being cut at a NUL byte.
+         */
+        static std::string encodeHex(const std::string& data)
+        {
+            static const char digits[] = "0123456789abcdef";
+            
+            std::string hex(data.size() * 2, '0');
+            for (size_t i = 0; i < data.size(); i++) {
+                hex[2 * i] = digits[(unsigned char) data[i] >> 4];
+                hex[2 * i + 1] = digits[(unsigned char) data[i] & 15];
+            }
+            return hex;
+        }
+        
+        /**
+         * Decodes the output of encodeHex.
+         * 
+         * @param data Receives the decoded bytes.
+         * @return Whether the input was well-formed hex.
+         */
+        static bool decodeHex(const char* hex, std::string& data)
+        {
+            return AlgorithmInterface::decodeHex(hex, strlen(hex), data);
+        }
+        
+        /**
+         * Decodes hex that isn't NUL-terminated, such as a line of a mapped
+         * file.
+         * 
+         * @param data Receives the decoded bytes.
+         * @return Whether the input was well-formed hex.
+         */
+        static bool decodeHex(const char* hex, size_t length, std::string& data)
+        {
+            if (0 != length % 2) {
+                return false;
+            }
+            
+            data.assign(length / 2, '\0');
+            for (size_t i = 0; i < length; i++) {
+                char c = hex[i];
+                int value;
+                if ('0' <= c && '9' >= c) {
+                    value = c - '0';
+                } else if ('a' <= c && 'f' >= c) {
+                    value = c - 'a' + 10;
+                } else if ('A' <= c && 'F' >= c) {
+                    value = c - 'A' + 10;
+                } else {
+                    return false;
+                }
+                data[i / 2] = (char) ((data[i / 2] << 4) | value);
+            }
+            return true;
+        }
+    
+    protected:
+        
+        /**
+         * The scratch buffers of the searches; a search takes them inside an
+         * ArenaScope.
+         */
+        Arena scratch;
 };
 
 #endif	/* ALGORITHMINTERFACE_H */
@@ -0,0 +1,196 @@
+/**
+ * File: AlgorithmRegistry.cpp
+ * 
+ * Source code file for the AlgorithmRegistry class.
+ * 
+ * @version 0.1
+ */
+
+// include the stream related libraries.
+#include <sstream>
+
+// include the strtoull function.
+#include <stdlib.h>
+
+// include the signature of the class.
+#include "AlgorithmRegistry.h"
+
+// include the engines.
+#include "AlgorithmDESBitslice.h"
+#include "AlgorithmDES.h"
+#include "AlgorithmDESLegacy.h"
+#include "AlgorithmTripleDES.h"
+
+// include the Config class signature.
+#include "Config.h"
+
+/**
+ * Creates an engine of the given class.
+ */
+template <typename Engine>
+static AlgorithmInterface* createEngine()
+{
+    return new Engine();
+}
+
+/**
+ * Creates a Triple-DES engine with the given number of keys.
+ */
+template <int NumberOfKeys>
+static AlgorithmInterface* createTripleDES()
+{
+    return new AlgorithmTripleDES(NumberOfKeys);
+}
+
+/**
+ * Gets an engine ready to search. An engine that tests one key at a time
+ * has no self-test and takes no cancel flag; its chunks are short.
+ */
+template <typename Engine>
+static bool prepareEngine(AlgorithmInterface* /* engine */, const std::atomic<bool>* /* cancelFlag */, std::string& description)
+{
+    description = "one key at a time";
+    return true;
+}
+
+/**
+ * Gets a bitsliced engine ready to search: its kernels must agree with the
+ * reference implementation before they are trusted, and it polls the cancel
+ * flag while it searches a chunk.
+ */
+template <>
+bool prepareEngine<AlgorithmDESBitslice>(AlgorithmInterface* engine, const std::atomic<bool>* cancelFlag, std::string& description)
+{
+    AlgorithmDESBitslice* bitslice = static_cast<AlgorithmDESBitslice*>(engine);
+    bitslice->setCancelFlag(cancelFlag);
+    
+    std::stringstream kernel;
+    kernel << "the " << bitslice->getKernelName() << " kernel, " << bitslice->getLanes() << " keys per pass";
+    description = kernel.str();
+    
+    return bitslice->selfTest();
+}
+
+/**
+ * Gets a Triple-DES engine ready to search: the keys it doesn't search for
+ * are the second key (secondKey, hex) and the third one (thirdKey) of the
+ * [keyspace] section of the configuration file.
+ */
+template <>
+bool prepareEngine<AlgorithmTripleDES>(AlgorithmInterface* engine, const std::atomic<bool>* /* cancelFlag */, std::string& description)
+{
+    AlgorithmTripleDES* tripleDES = static_cast<AlgorithmTripleDES*>(engine);
+    tripleDES->setOuterKeys(strtoull(Config::readString("secondKey", "keyspace").c_str(), NULL, 16), strtoull(Config::readString("thirdKey", "keyspace").c_str(), NULL, 16));
+    
+    std::stringstream keys;
+    keys << "EDE" << tripleDES->getNumberOfKeys() << ", one first key at a time";
+    description = keys.str();
+    return true;
+}
+
+/**
+ * Searches a chunk of the key pattern with an engine of the given class; the
+ * call is bound to the class, not dispatched through the interface.
+ */
+template <typename Engine>
+static bool searchEngineChunk(AlgorithmInterface* engine, const SearchJob& job, uint64_t firstCandidate, uint64_t lastCandidate, uint64_t& foundCandidate)
+{
+    return static_cast<Engine*>(engine)->Engine::searchKeys(*job.rawString, *job.encryptedString, *job.pattern, firstCandidate, lastCandidate, foundCandidate);
+}
+
+/**
+ * Searches a chunk of the key pattern, the key list or the word list with a
+ * bitsliced engine.
+ */
+template <>
+bool searchEngineChunk<AlgorithmDESBitslice>(AlgorithmInterface* engine, const SearchJob& job, uint64_t firstCandidate, uint64_t lastCandidate, uint64_t& foundCandidate)
+{
+    AlgorithmDESBitslice* bitslice = static_cast<AlgorithmDESBitslice*>(engine);
+    if (NULL != job.words) {
+        return bitslice->searchWordList(*job.rawString, *job.encryptedString, *job.words, firstCandidate, lastCandidate, foundCandidate);
+    }
+    if (NULL != job.keys) {
+        return bitslice->searchKeyList(*job.rawString, *job.encryptedString, *job.keys, firstCandidate, lastCandidate, foundCandidate);
+    }
+    return bitslice->AlgorithmDESBitslice::searchKeys(*job.rawString, *job.encryptedString, *job.pattern, firstCandidate, lastCandidate, foundCandidate);
+}
+
+/**
+ * The engines. The width of the bitsliced engine depends on the kernel the
+ * CPU supports, so the list is filled in the first time it is needed.
+ */
+struct EngineList
+{
+    AlgorithmEngine engines[5];
+    
+    EngineList()
+    {
+        AlgorithmDESBitslice bitslice;
+        AlgorithmEngine list[] = {
+            { 1, "des-bitslice", 8, bitslice.getLanes(), 64, true, true,
+                createEngine<AlgorithmDESBitslice>, prepareEngine<AlgorithmDESBitslice>, searchEngineChunk<AlgorithmDESBitslice> },
+            { 2, "des", 8, 1, 64, true, false,
+                createEngine<AlgorithmDES>, prepareEngine<AlgorithmDES>, searchEngineChunk<AlgorithmDES> },
+            { 3, "des-legacy", 8, 1, 64, false, false,
+                createEngine<AlgorithmDESLegacy>, prepareEngine<AlgorithmDESLegacy>, searchEngineChunk<AlgorithmDESLegacy> },
+            { 4, "3des-ede2", 8, 1, 128, true, false,
+                createTripleDES<2>, prepareEngine<AlgorithmTripleDES>, searchEngineChunk<AlgorithmTripleDES> },
+            { 5, "3des-ede3", 8, 1, 192, true, false,
+                createTripleDES<3>, prepareEngine<AlgorithmTripleDES>, searchEngineChunk<AlgorithmTripleDES> }
+        };
+        for (int i = 0; i < 5; i++) {
+            this->engines[i] = list[i];
+        }
+    }
+};
+
+/**
+ * Returns the engines.
+ */
+static const EngineList& getEngineList()
+{
+    static const EngineList list;
+    return list;
+}
+
+/**
+ * Returns the engine with the given id, or NULL if there is none.
+ */
+const AlgorithmEngine* AlgorithmRegistry::find(int algorithmId)
+{
+    for (int i = 0; i < AlgorithmRegistry::getNumberOfEngines(); i++) {
+        if (algorithmId == AlgorithmRegistry::getEngine(i).algorithmId) {
+            return &AlgorithmRegistry::getEngine(i);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Returns the engine with the given name, or NULL if there is none.
+ */
+const AlgorithmEngine* AlgorithmRegistry::find(const std::string& name)
+{
+    for (int i = 0; i < AlgorithmRegistry::getNumberOfEngines(); i++) {
+        if (name == AlgorithmRegistry::getEngine(i).name) {
+            return &AlgorithmRegistry::getEngine(i);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Returns the number of engines.
+ */
+int AlgorithmRegistry::getNumberOfEngines()
+{
+    return sizeof(getEngineList().engines) / sizeof(getEngineList().engines[0]);
+}
+
+/**
+ * Returns the engine at the given index, 0 to getNumberOfEngines() - 1.
+ */
+const AlgorithmEngine& AlgorithmRegistry::getEngine(int index)
+{
+    return getEngineList().engines[index];
+}
@@ -0,0 +1,149 @@
+/**
+ * File: AlgorithmRegistry.h
+ * 
+ * Header file for the AlgorithmRegistry class.
+ * 
+ * @version 0.1
+ */
+
+// make sure that the signature of the class is defined only once.
+#ifndef ALGORITHMREGISTRY_H
+#define	ALGORITHMREGISTRY_H
+
+// include the string library for the std::string class.
+#include <string>
+
+// include the atomic library for the cancel flag.
+#include <atomic>
+
+// include the AlgorithmInterface header file.
+#include "AlgorithmInterface.h"
+
+// include the KeyList and WordList class signatures.
+#include "KeyList.h"
+#include "WordList.h"
+
+/**
+ * What a key search tests its candidates against, and where the candidates
+ * come from: the key pattern, or a key list or word list if one is given.
+ */
+struct SearchJob
+{
+    const std::string* rawString;
+    const std::string* encryptedString;
+    const KeyPattern* pattern;
+    const KeyList* keys;
+    const WordList* words;
+};
+
+/**
+ * Searches [firstCandidate, lastCandidate) of a job with an engine; it
+ * receives the matching candidate, if any, and returns whether there was
+ * one.
+ */
+typedef bool (*AlgorithmChunkSearch)(AlgorithmInterface* engine, const SearchJob& job, uint64_t firstCandidate, uint64_t lastCandidate, uint64_t& foundCandidate);
+
+/**
+ * An engine of the registry: what it can do, and the functions that create
+ * it and run its search. The functions are instantiated for the engine's own
+ * class, so they call its methods directly rather than through the
+ * AlgorithmInterface; a worker binds them once when it starts.
+ */
+struct AlgorithmEngine
+{
+    /**
+     * The id the main process passes to its children, and the name the
+     * configuration file (algorithm in [main]) uses.
+     */
+    int algorithmId;
+    const char* name;
+    
+    /**
+     * Size of a cipher block in bytes, and the number of candidate keys the
+     * engine tests in one pass (chunks of the key space are multiples of
+     * it).
+     */
+    int blockSize;
+    int batchWidth;
+    
+    /**
+     * Length of the engine's key strings in bits; the key search looks for
+     * the first 64 of them, the rest are set when the engine is prepared.
+     */
+    int keyLength;
+    
+    /**
+     * Whether the engine rejects a key on the first block alone, without
+     * decrypting the whole text, and whether it can search key lists, word
+     * lists and batches of targets besides key patterns.
+     */
+    bool keyTestOnly;
+    bool candidateLists;
+    
+    /**
+     * Creates an engine; the caller deletes it.
+     */
+    AlgorithmInterface* (*create)();
+    
+    /**
+     * Gets an engine created by create ready to search: runs its self-test
+     * and gives it the cancel flag, if it takes one, and the known keys
+     * past the first one, if it has any.
+     * 
+     * @param description Receives what the engine runs, for the log.
+     * @return Whether the engine passed its self-test.
+     */
+    bool (*prepare)(AlgorithmInterface* engine, const std::atomic<bool>* cancelFlag, std::string& description);
+    
+    /**
+     * Searches a chunk of a job with an engine created by create.
+     */
+    AlgorithmChunkSearch searchChunk;
+};
+
+/**
+ * Signature of the AlgorithmRegistry class.
+ * 
+ * AlgorithmRegistry lists the engines a search can run with, by id and by
+ * name: the bitsliced DES engine (the default), the DES reference
+ * implementation, the original one and Triple-DES with two and three keys.
+ * 
+ * @since version 0.1
+ * @see AlgorithmEngine
+ * @see ChildProcess
+ */
+class AlgorithmRegistry
+{
+    // public attributes and methods of the class.
+    public:
+        
+        /**
+         * Id of the engine searches run with unless the configuration says
+         * otherwise.
+         */
+        static const int defaultAlgorithmId = 1;
+        
+        /**
+         * Returns the engine with the given id, or NULL if there is none.
+         */
+        static const AlgorithmEngine* find(int algorithmId);
+        
+        /**
+         * Returns the engine with the given name, or NULL if there is none.
+         */
+        static const AlgorithmEngine* find(const std::string& name);
+        
+        /**
+         * Returns the number of engines.
+         */
+        static int getNumberOfEngines();
+        
+        /**
+         * Returns the engine at the given index, 0 to getNumberOfEngines() -
+         * 1.
+         */
+        static const AlgorithmEngine& getEngine(int index);
+};
+
+// end of the class signature.
+#endif	/* ALGORITHMREGISTRY_H */
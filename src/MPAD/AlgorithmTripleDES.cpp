@@ -0,0 +1,218 @@
+/**
+ * File: AlgorithmTripleDES.cpp
+ * 
+ * Source code file for the AlgorithmTripleDES class.
+ * 
+ * @version 0.1
+ */
+
+// include the memory functions.
+#include <string.h>
+
+// include the signature of the class.
+#include "AlgorithmTripleDES.h"
+
+/**
+ * Constructor method of the class.
+ * 
+ * @param numberOfKeys 2 for EDE2 or 3 for EDE3; what the key search looks
+ * for.
+ */
+AlgorithmTripleDES::AlgorithmTripleDES(int numberOfKeys)
+{
+    this->numberOfKeys = (2 == numberOfKeys) ? 2 : 3;
+    this->secondKey = 0;
+    this->thirdKey = 0;
+}
+
+/**
+ * Returns the number of keys, 2 or 3.
+ */
+int AlgorithmTripleDES::getNumberOfKeys()
+{
+    return this->numberOfKeys;
+}
+
+/**
+ * Sets the known keys of the key search: the second one, and the third one
+ * for EDE3.
+ */
+void AlgorithmTripleDES::setOuterKeys(uint64_t secondKey, uint64_t thirdKey)
+{
+    this->secondKey = secondKey;
+    this->thirdKey = thirdKey;
+}
+
+/**
+ * Returns the key string of the known keys, which follows the key string of
+ * the first key in a key string of the engine.
+ */
+std::string AlgorithmTripleDES::getOuterKeyString()
+{
+    char key[64 + 1];
+    AlgorithmInterface::candidateToKey(this->secondKey, 64, key);
+    std::string keys(key);
+    if (3 == this->numberOfKeys) {
+        AlgorithmInterface::candidateToKey(this->thirdKey, 64, key);
+        keys += key;
+    }
+    return keys;
+}
+
+std::string AlgorithmTripleDES::encrpyt(const std::string& rawString, const char* key, int keyLength)
+{
+    std::string data(AlgorithmInterface::encryptedLength(rawString.size()), '\0');
+    this->encrypt((const unsigned char*) rawString.data(), rawString.size(), (unsigned char*) &data[0], key, keyLength);
+    
+    return data;
+}
+
+std::string AlgorithmTripleDES::decrypt(const std::string& encryptedString, const char* key, int keyLength)
+{
+    std::string data(encryptedString.size() - encryptedString.size() % 8, '\0');
+    this->decrypt((const unsigned char*) encryptedString.data(), encryptedString.size(), (unsigned char*) &data[0], key, keyLength);
+    
+    size_t start, end;
+    AlgorithmInterface::trimBounds((const unsigned char*) data.data(), data.size(), start, end);
+    
+    return data.substr(start, end - start);
+}
+
+size_t AlgorithmTripleDES::encrypt(const unsigned char* input, size_t length, unsigned char* output, const char* key, int keyLength)
+{
+    DESCore first, second, third;
+    AlgorithmTripleDES::setKeys(key, keyLength, first, second, third);
+    
+    // the whole blocks are encrypted in place; the last one is padded with
+    // spaces on the stack.
+    size_t whole = length - length % 8;
+    AlgorithmTripleDES::encryptBlocks(first, second, third, input, output, whole);
+    if (whole < length) {
+        unsigned char block[8];
+        memset(block, ' ', sizeof(block));
+        memcpy(block, input + whole, length - whole);
+        AlgorithmTripleDES::encryptBlocks(first, second, third, block, output + whole, 8);
+        whole += 8;
+    }
+    
+    return whole;
+}
+
+size_t AlgorithmTripleDES::decrypt(const unsigned char* input, size_t length, unsigned char* output, const char* key, int keyLength)
+{
+    DESCore first, second, third;
+    AlgorithmTripleDES::setKeys(key, keyLength, first, second, third);
+    
+    size_t whole = length - length % 8;
+    AlgorithmTripleDES::decryptBlocks(first, second, third, input, output, whole);
+    
+    return whole;
+}
+
+bool AlgorithmTripleDES::searchKeys(const std::string& rawString, const std::string& encryptedString, const KeyPattern& pattern, uint64_t firstCandidate, uint64_t lastCandidate, uint64_t& foundCandidate)
+{
+    return this->searchKeys((const unsigned char*) rawString.data(), rawString.size(), (const unsigned char*) encryptedString.data(), encryptedString.size(), pattern, firstCandidate, lastCandidate, foundCandidate);
+}
+
+bool AlgorithmTripleDES::searchKeys(const unsigned char* raw, size_t rawLength, const unsigned char* encrypted, size_t encryptedLength, const KeyPattern& pattern, uint64_t firstCandidate, uint64_t lastCandidate,
+    uint64_t& foundCandidate)
+{
+    // the first key is patched from one candidate to the next, as
+    // AlgorithmDES does; the outer keys don't change.
+    uint64_t key = pattern.getKey(firstCandidate);
+    DESCore first, second, third;
+    first.setKey(key);
+    second.setKey(this->secondKey);
+    third.setKey(this->thirdKey);
+    DESCore& last = (3 == this->numberOfKeys) ? third : first;
+    
+    // the last step of decrypting the first block, with the first key, is
+    // tested without FP against the start of the raw string, as AlgorithmDES
+    // does. with EDE3 the steps before it don't depend on the candidate and
+    // are done here, once.
+    unsigned char block[8];
+    uint64_t ipInner = 0, ipExpected = 0, ipMask = 0;
+    if (8 <= encryptedLength) {
+        uint64_t expected = 0, mask = 0, inner = 0;
+        for (size_t i = 0; i < 8; i++) {
+            bool known = i < rawLength && 32 < raw[0];
+            expected = (expected << 8) | (known ? raw[i] : 0);
+            mask = (mask << 8) | (known ? 0xFF : 0);
+        }
+        ipExpected = DESCore::initialPermutation(expected);
+        ipMask = DESCore::initialPermutation(mask);
+        
+        third.decryptBlock(encrypted, block);
+        second.encryptBlock(block, block);
+        for (size_t i = 0; i < 8; i++) {
+            inner = (inner << 8) | block[i];
+        }
+        ipInner = DESCore::initialPermutation(inner);
+    }
+    
+    // the rare survivors are decrypted in full into a scratch buffer.
+    ArenaScope scope(this->scratch);
+    size_t dataLength = encryptedLength - encryptedLength % 8;
+    unsigned char* data = this->scratch.allocateArray<unsigned char>(dataLength);
+    
+    for (uint64_t i = firstCandidate; i < lastCandidate; i++, key = pattern.getNextKey(key)) {
+        first.updateKey(key);
+        if (2 == this->numberOfKeys && 8 <= encryptedLength) {
+            uint64_t inner = 0;
+            first.decryptBlock(encrypted, block);
+            second.encryptBlock(block, block);
+            for (size_t j = 0; j < 8; j++) {
+                inner = (inner << 8) | block[j];
+            }
+            ipInner = DESCore::initialPermutation(inner);
+        }
+        if (! first.testBlock(ipInner, ipExpected, ipMask, true)) {
+            continue;
+        }
+        
+        AlgorithmTripleDES::decryptBlocks(first, second, last, encrypted, data, dataLength);
+        if (AlgorithmInterface::matchesRawString(raw, rawLength, data, dataLength)) {
+            foundCandidate = i;
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+/**
+ * Sets up the three cores with the keys of a key string: 64 bits per key,
+ * the first key doing for the missing ones (EDE2 and single DES).
+ */
+void AlgorithmTripleDES::setKeys(const char* key, int keyLength, DESCore& first, DESCore& second, DESCore& third)
+{
+    uint64_t firstKey = DESCore::keyFromString(key, (64 < keyLength) ? 64 : keyLength);
+    uint64_t secondKey = (128 <= keyLength) ? DESCore::keyFromString(key + 64, 64) : firstKey;
+    uint64_t thirdKey = (192 <= keyLength) ? DESCore::keyFromString(key + 128, 64) : firstKey;
+    
+    first.setKey(firstKey);
+    second.setKey(secondKey);
+    third.setKey(thirdKey);
+}
+
+/**
+ * Encrypts whole blocks: E(first), D(second), E(third). The input and output
+ * may be the same buffer.
+ */
+void AlgorithmTripleDES::encryptBlocks(DESCore& first, DESCore& second, DESCore& third, const unsigned char* input, unsigned char* output, size_t length)
+{
+    first.encrypt(input, output, length);
+    second.decrypt(output, output, length);
+    third.encrypt(output, output, length);
+}
+
+/**
+ * Decrypts whole blocks: D(third), E(second), D(first). The input and output
+ * may be the same buffer.
+ */
+void AlgorithmTripleDES::decryptBlocks(DESCore& first, DESCore& second, DESCore& third, const unsigned char* input, unsigned char* output, size_t length)
+{
+    third.decrypt(input, output, length);
+    second.encrypt(output, output, length);
+    first.decrypt(output, output, length);
+}
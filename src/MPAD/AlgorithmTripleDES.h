@@ -0,0 +1,142 @@
+/**
+ * File: AlgorithmTripleDES.h
+ * 
+ * Header file for the AlgorithmTripleDES class.
+ * 
+ * @version 0.1
+ */
+
+// make sure that the signature of the class is defined only once.
+#ifndef ALGORITHMTRIPLEDES_H
+#define	ALGORITHMTRIPLEDES_H
+
+// include the AlgorithmInterface header file.
+#include "AlgorithmInterface.h"
+
+// include the DESCore class signature.
+#include "DESCore.h"
+
+/**
+ * Signature of the AlgorithmTripleDES class.
+ * 
+ * AlgorithmTripleDES is Triple-DES in EDE form on the DESCore
+ * implementation: a block is encrypted with the first key, decrypted with
+ * the second one and encrypted with the third one. The key string holds the
+ * keys one after the other: 192 bits are three keys (EDE3), 128 bits are two
+ * keys, the first one being used again as the third (EDE2), and 64 bits are
+ * a single key, which makes it plain DES.
+ * 
+ * The key search looks for the first key. The others are known: the second
+ * and, for EDE3, the third key are set with setOuterKeys. With EDE3 the
+ * first block is decrypted with them once per search, so a candidate costs
+ * as much as a DES candidate; with EDE2 the first key is used twice, and a
+ * candidate costs two DES operations and a test.
+ * 
+ * @since version 0.1
+ * @see DESCore
+ * @see MeetInTheMiddle
+ */
+class AlgorithmTripleDES : public AlgorithmInterface
+{
+    // public attributes and methods of the class.
+    public:
+        
+        /**
+         * Constructor method of the class.
+         * 
+         * @param numberOfKeys 2 for EDE2 or 3 for EDE3; what the key search
+         * looks for.
+         */
+        AlgorithmTripleDES(int numberOfKeys);
+        
+        /**
+         * Returns the number of keys, 2 or 3.
+         */
+        int getNumberOfKeys();
+        
+        /**
+         * Sets the known keys of the key search: the second one, and the
+         * third one for EDE3.
+         */
+        void setOuterKeys(uint64_t secondKey, uint64_t thirdKey);
+        
+        /**
+         * Returns the key string of the known keys, which follows the key
+         * string of the first key in a key string of the engine.
+         */
+        std::string getOuterKeyString();
+        
+        /**
+         * Encrypts the raw string (padded with spaces to whole blocks) with
+         * the given key string.
+         */
+        std::string encrpyt(const std::string& rawString, const char* key, int keyLength);
+        
+        /**
+         * Decrypts the encrypted string with the given key string and trims
+         * the padding, exactly as AlgorithmDES does.
+         */
+        std::string decrypt(const std::string& encryptedString, const char* key, int keyLength);
+        
+        /**
+         * Encrypts a buffer, padded with spaces to whole blocks, into
+         * encryptedLength(length) bytes of the output buffer.
+         * 
+         * @return The number of bytes written.
+         */
+        size_t encrypt(const unsigned char* input, size_t length, unsigned char* output, const char* key, int keyLength);
+        
+        /**
+         * Decrypts the whole blocks of a buffer; the padding is left in
+         * place.
+         * 
+         * @return The number of bytes written.
+         */
+        size_t decrypt(const unsigned char* input, size_t length, unsigned char* output, const char* key, int keyLength);
+        
+        /**
+         * Tests the first keys in [firstCandidate, lastCandidate) with the
+         * known outer keys, on the first block of the known raw/encrypted
+         * pair and then on the whole text.
+         * 
+         * @param foundCandidate Receives the matching candidate, if any.
+         * @return Whether a matching candidate was found.
+         */
+        bool searchKeys(const unsigned char* raw, size_t rawLength, const unsigned char* encrypted, size_t encryptedLength, const KeyPattern& pattern, uint64_t firstCandidate, uint64_t lastCandidate,
+            uint64_t& foundCandidate);
+        bool searchKeys(const std::string& rawString, const std::string& encryptedString, const KeyPattern& pattern, uint64_t firstCandidate, uint64_t lastCandidate, uint64_t& foundCandidate);
+    
+    // private attributes and methods of the class.
+    private:
+        
+        /**
+         * 2 for EDE2, 3 for EDE3.
+         */
+        int numberOfKeys;
+        
+        /**
+         * The known keys of the key search.
+         */
+        uint64_t secondKey;
+        uint64_t thirdKey;
+        
+        /**
+         * Sets up the three cores with the keys of a key string.
+         */
+        static void setKeys(const char* key, int keyLength, DESCore& first, DESCore& second, DESCore& third);
+        
+        /**
+         * Encrypts whole blocks: E(first), D(second), E(third). The input and
+         * output may be the same buffer.
+         */
+        static void encryptBlocks(DESCore& first, DESCore& second, DESCore& third, const unsigned char* input, unsigned char* output, size_t length);
+        
+        /**
+         * Decrypts whole blocks: D(third), E(second), D(first). The input and
+         * output may be the same buffer.
+         */
+        static void decryptBlocks(DESCore& first, DESCore& second, DESCore& third, const unsigned char* input, unsigned char* output, size_t length);
+};
+
+// end of the class signature.
+#endif	/* ALGORITHMTRIPLEDES_H */
@@ -0,0 +1,112 @@
+/**
+ * File: AllocationCounter.cpp
+ * 
+ * Source code file for the AllocationCounter class, and the operator new and
+ * delete that count the allocations.
+ * 
+ * @version 0.1
+ */
+
+// include standard libraries.
+#include <stdlib.h>
+
+// include the operator new signatures and the bad_alloc exception.
+#include <new>
+
+// include the atomic library.
+#include <atomic>
+
+// include the signature of the class.
+#include "AllocationCounter.h"
+
+/**
+ * The allocations of every thread, and of this one.
+ */
+static std::atomic<uint64_t> allocations(0);
+static thread_local uint64_t threadAllocations = 0;
+
+/**
+ * Counts an allocation and makes it.
+ * 
+ * @return The memory, or NULL.
+ */
+static void* countedMalloc(size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    threadAllocations++;
+    return malloc((0 < size) ? size : 1);
+}
+
+/**
+ * Returns the number of allocations of every thread so far.
+ */
+uint64_t AllocationCounter::getAllocations()
+{
+    return allocations.load(std::memory_order_relaxed);
+}
+
+/**
+ * Returns the number of allocations of the calling thread so far.
+ */
+uint64_t AllocationCounter::getThreadAllocations()
+{
+    return threadAllocations;
+}
+
+void* operator new(size_t size)
+{
+    void* memory = countedMalloc(size);
+    if (NULL == memory) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new[](size_t size)
+{
+    void* memory = countedMalloc(size);
+    if (NULL == memory) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return countedMalloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return countedMalloc(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void* memory, size_t /* size */) noexcept
+{
+    free(memory);
+}
+
+void operator delete[](void* memory, size_t /* size */) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+    free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept
+{
+    free(memory);
+}
@@ -0,0 +1,49 @@
+/**
+ * File: AllocationCounter.h
+ * 
+ * Header file for the AllocationCounter class.
+ * 
+ * @version 0.1
+ */
+
+// make sure that the signature of the class is defined only once.
+#ifndef ALLOCATIONCOUNTER_H
+#define	ALLOCATIONCOUNTER_H
+
+// include the fixed-width integer types.
+#include <stdint.h>
+
+/**
+ * Signature of the AllocationCounter class.
+ * 
+ * AllocationCounter counts the heap allocations of the application: its
+ * source file replaces the global operator new (every form of it but the
+ * over-aligned ones), which counts each call, in all and per thread, before
+ * it goes to malloc. A search that counts the allocations of its thread
+ * before and after its chunks shows how many it made in between; once a
+ * worker has searched its first chunk, it should make none (see Arena).
+ * 
+ * The blocks of an Arena come from posix_memalign and aren't counted; an
+ * arena counts them itself.
+ * 
+ * @since version 0.1
+ * @see Arena
+ */
+class AllocationCounter
+{
+    // public attributes and methods of the class.
+    public:
+        
+        /**
+         * Returns the number of allocations of every thread so far.
+         */
+        static uint64_t getAllocations();
+        
+        /**
+         * Returns the number of allocations of the calling thread so far.
+         */
+        static uint64_t getThreadAllocations();
+};
+
+// end of the class signature.
+#endif	/* ALLOCATIONCOUNTER_H */
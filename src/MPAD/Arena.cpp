@@ -0,0 +1,148 @@
+/**
+ * File: Arena.cpp
+ * 
+ * Source code file for the Arena and ArenaScope classes.
+ * 
+ * @version 0.1
+ */
+
+// include standard libraries.
+#include <stdlib.h>
+
+// include the bad_alloc exception.
+#include <new>
+
+// include the signature of the class.
+#include "Arena.h"
+
+/**
+ * Constructor method of the class.
+ * 
+ * @param capacity Bytes of the first block, allocated right away; 0 leaves
+ * it to the first buffer.
+ */
+Arena::Arena(size_t capacity)
+{
+    this->current = 0;
+    this->offset = 0;
+    if (0 < capacity) {
+        this->addBlock(capacity);
+    }
+}
+
+/**
+ * Destructor method of the class; frees the blocks.
+ */
+Arena::~Arena()
+{
+    for (size_t i = 0; i < this->blocks.size(); i++) {
+        free(this->blocks[i].data);
+    }
+}
+
+/**
+ * Returns a buffer of the given number of bytes, aligned to a cache line. It
+ * is taken from the current block if it fits, or else from the first block
+ * after it that is large enough; only if there is none is a block added.
+ * Searching the same way chunk after chunk, a worker finds its buffers in
+ * the blocks of the first chunk.
+ * 
+ * @throws std::bad_alloc If a new block can't be allocated.
+ */
+void* Arena::allocate(size_t bytes)
+{
+    size_t size = (0 < bytes) ? (bytes + Arena::lineSize - 1) & ~(Arena::lineSize - 1) : Arena::lineSize;
+    
+    if (this->current < this->blocks.size() && size <= this->blocks[this->current].size - this->offset) {
+        void* buffer = this->blocks[this->current].data + this->offset;
+        this->offset += size;
+        return buffer;
+    }
+    
+    size_t next = this->current + 1;
+    if (this->blocks.empty()) {
+        next = 0;
+    }
+    while (next < this->blocks.size() && size > this->blocks[next].size) {
+        next++;
+    }
+    if (next == this->blocks.size()) {
+        size_t last = this->blocks.empty() ? 0 : this->blocks.back().size;
+        size_t blockSize = (2 * last > size) ? 2 * last : size;
+        this->addBlock((Arena::minimumBlockSize > blockSize) ? Arena::minimumBlockSize : blockSize);
+    }
+    
+    this->current = next;
+    this->offset = size;
+    return this->blocks[next].data;
+}
+
+/**
+ * Returns the current position, to rewind to later.
+ */
+Arena::Mark Arena::getMark() const
+{
+    Mark mark = { this->current, this->offset };
+    return mark;
+}
+
+/**
+ * Gives back every buffer allocated since the mark was taken.
+ */
+void Arena::rewind(const Mark& mark)
+{
+    this->current = mark.block;
+    this->offset = mark.offset;
+}
+
+/**
+ * Returns the number of blocks, which is the number of times the arena went
+ * to the heap.
+ */
+size_t Arena::getNumberOfBlocks() const
+{
+    return this->blocks.size();
+}
+
+/**
+ * Returns the bytes the blocks hold.
+ */
+size_t Arena::getCapacity() const
+{
+    size_t capacity = 0;
+    for (size_t i = 0; i < this->blocks.size(); i++) {
+        capacity += this->blocks[i].size;
+    }
+    return capacity;
+}
+
+/**
+ * Allocates a block, aligned to a cache line, and appends it.
+ */
+void Arena::addBlock(size_t size)
+{
+    size = (size + Arena::lineSize - 1) & ~(Arena::lineSize - 1);
+    void* data = NULL;
+    if (0 != posix_memalign(&data, Arena::lineSize, size)) {
+        throw std::bad_alloc();
+    }
+    
+    Block block = { (unsigned char*) data, size };
+    this->blocks.push_back(block);
+}
+
+/**
+ * Constructor method of the class; takes the mark.
+ */
+ArenaScope::ArenaScope(Arena& arena) : arena(arena)
+{
+    this->mark = arena.getMark();
+}
+
+/**
+ * Destructor method of the class; rewinds to the mark.
+ */
+ArenaScope::~ArenaScope()
+{
+    this->arena.rewind(this->mark);
+}
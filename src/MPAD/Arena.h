@@ -0,0 +1,188 @@
+/**
+ * File: Arena.h
+ * 
+ * Header file for the Arena and ArenaScope classes.
+ * 
+ * @version 0.1
+ */
+
+// make sure that the signature of the class is defined only once.
+#ifndef ARENA_H
+#define	ARENA_H
+
+// include the vector library.
+#include <vector>
+
+// include the size_t type.
+#include <stddef.h>
+
+// include the fixed-width integer types.
+#include <stdint.h>
+
+/**
+ * Signature of the Arena class.
+ * 
+ * Arena hands out the scratch buffers of a search (the buffer a candidate is
+ * decrypted into, the keys of a batch) from memory it keeps from one search
+ * to the next, so that a worker searching chunk after chunk doesn't go to
+ * the heap once it has searched its first one.
+ * 
+ * Buffers are taken from the current block, each at the start of a cache
+ * line, and are given back all at once by rewinding to a mark taken before
+ * them (see ArenaScope), so scratch is used the way a stack is. A buffer
+ * that doesn't fit in the blocks there are gets a new one, at least twice as
+ * large as the last; the blocks are only freed with the arena.
+ * 
+ * An arena belongs to one worker; it isn't thread safe.
+ * 
+ * @since version 0.1
+ * @see ArenaScope
+ * @see AllocationCounter
+ */
+class Arena
+{
+    // public attributes and methods of the class.
+    public:
+        
+        /**
+         * The alignment of every buffer: a cache line.
+         */
+        static const size_t lineSize = 64;
+        
+        /**
+         * A position in the arena to rewind to.
+         */
+        struct Mark
+        {
+            size_t block;
+            size_t offset;
+        };
+        
+        /**
+         * Constructor method of the class.
+         * 
+         * @param capacity Bytes of the first block, allocated right away; 0
+         * leaves it to the first buffer.
+         */
+        Arena(size_t capacity = 0);
+        
+        /**
+         * Destructor method of the class; frees the blocks.
+         */
+        ~Arena();
+        
+        /**
+         * Returns a buffer of the given number of bytes, aligned to a cache
+         * line. It stays valid until the arena is rewound to a mark taken
+         * before it.
+         * 
+         * @throws std::bad_alloc If a new block can't be allocated.
+         */
+        void* allocate(size_t bytes);
+        
+        /**
+         * Returns a buffer of the given number of elements.
+         */
+        template <typename T>
+        T* allocateArray(size_t count)
+        {
+            return static_cast<T*>(this->allocate(count * sizeof(T)));
+        }
+        
+        /**
+         * Returns the current position, to rewind to later.
+         */
+        Mark getMark() const;
+        
+        /**
+         * Gives back every buffer allocated since the mark was taken.
+         */
+        void rewind(const Mark& mark);
+        
+        /**
+         * Returns the number of blocks, which is the number of times the
+         * arena went to the heap, and the bytes they hold.
+         */
+        size_t getNumberOfBlocks() const;
+        size_t getCapacity() const;
+    
+    // private attributes and methods of the class.
+    private:
+        
+        /**
+         * A block of memory, aligned to a cache line.
+         */
+        struct Block
+        {
+            unsigned char* data;
+            size_t size;
+        };
+        
+        /**
+         * Smallest block.
+         */
+        static const size_t minimumBlockSize = 4096;
+        
+        /**
+         * The blocks, the one buffers are taken from, and the first free
+         * byte of it.
+         */
+        std::vector<Block> blocks;
+        size_t current;
+        size_t offset;
+        
+        /**
+         * Allocates a block and appends it.
+         */
+        void addBlock(size_t size);
+        
+        /**
+         * Copying would free the blocks twice.
+         */
+        Arena(const Arena&);
+        Arena& operator=(const Arena&);
+};
+
+/**
+ * Signature of the ArenaScope class.
+ * 
+ * ArenaScope takes a mark of an arena when it is created and rewinds the
+ * arena to it when it goes out of scope, so that the buffers a method takes
+ * are given back however it returns.
+ * 
+ * @since version 0.1
+ * @see Arena
+ */
+class ArenaScope
+{
+    // public attributes and methods of the class.
+    public:
+        
+        /**
+         * Constructor method of the class; takes the mark.
+         */
+        ArenaScope(Arena& arena);
+        
+        /**
+         * Destructor method of the class; rewinds to the mark.
+         */
+        ~ArenaScope();
+    
+    // private attributes and methods of the class.
+    private:
+        
+        /**
+         * The arena, and the mark it is rewound to.
+         */
+        Arena& arena;
+        Arena::Mark mark;
+        
+        /**
+         * A scope can't be copied.
+         */
+        ArenaScope(const ArenaScope&);
+        ArenaScope& operator=(const ArenaScope&);
+};
+
+// end of the class signature.
+#endif	/* ARENA_H */
@@ -0,0 +1,299 @@
+/**
+ * File: Benchmark.cpp
+ * 
+ * Source code file for the Benchmark class.
+ * 
+ * @version 0.1
+ */
+
+// include standard libraries.
+#include <cstdlib>
+#include <stdio.h>
+
+// include the clock_gettime function.
+#include <time.h>
+
+// include the stream related libraries.
+#include <iostream>
+
+// include the signature of the class.
+#include "Benchmark.h"
+
+// include the DES engines.
+#include "AlgorithmDES.h"
+#include "AlgorithmDESLegacy.h"
+#include "AlgorithmDESBitslice.h"
+
+// include the ThreadedSearch class signature.
+#include "ThreadedSearch.h"
+
+/**
+ * Main entry of the mpad-bench tool.
+ * 
+ * @return The exit status of the application.
+ */
+int main(int argc, char **argv)
+{
+    std::string format = (1 < argc) ? argv[1] : "csv";
+    int maximumWorkers = (2 < argc) ? atoi(argv[2]) : 0;
+    
+    if ("csv" != format && "json" != format) {
+        fprintf(stderr, "usage: %s [csv|json] [maximum number of workers]\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    
+    Benchmark benchmark(maximumWorkers);
+    benchmark.run();
+    
+    if ("csv" == format) {
+        benchmark.writeCsv(std::cout);
+    } else {
+        benchmark.writeJson(std::cout);
+    }
+    
+    // terminate the application.
+    exit(EXIT_SUCCESS);
+}
+
+/**
+ * Constructor method of the class.
+ * 
+ * @param maximumWorkers Largest number of workers the scaling is measured
+ * with; 0 means one per core.
+ */
+Benchmark::Benchmark(int maximumWorkers)
+{
+    this->maximumWorkers = (0 < maximumWorkers) ? maximumWorkers : ThreadedSearch::getNumberOfCores();
+    
+    // the ranges searched all start at 0; a key with the high bits set is
+    // never in them.
+    char key[56 + 1];
+    AlgorithmInterface::candidateToKey(0xA5A5A5A5A5A5A5ULL, 56, key);
+    AlgorithmDES reference;
+    this->rawString = "This is the raw string!";
+    this->encryptedString = reference.encrpyt(this->rawString, key, 56);
+}
+
+/**
+ * Runs every measurement. The ranges are fixed, a few hundred milliseconds
+ * of work for each engine, so that the results of two builds compare.
+ */
+void Benchmark::run()
+{
+    // every engine on one core.
+    AlgorithmDESLegacy legacy;
+    this->measureEngine(legacy, "legacy", (uint64_t) 1 << 14);
+    
+    AlgorithmDES reference;
+    this->measureEngine(reference, "reference", (uint64_t) 1 << 21);
+    
+    const char* kernels[] = { "scalar", "avx2", "avx512" };
+    for (int i = 0; i < 3; i++) {
+        // the wider the kernel, the more keys it gets.
+        AlgorithmDESBitslice bitslice;
+        if (bitslice.useKernel(kernels[i])) {
+            this->measureEngine(bitslice, std::string("bitslice-") + kernels[i], (uint64_t) bitslice.getLanes() << 17);
+        }
+    }
+    
+    // the streams, 8 MB each way.
+    for (int decrypt = 0; decrypt < 2; decrypt++) {
+        this->measureStream(CipherStream::ECB, decrypt, (uint64_t) 1 << 20);
+        this->measureStream(CipherStream::CBC, decrypt, (uint64_t) 1 << 20);
+    }
+    
+    // the threaded search, doubling the workers, each of them with the same
+    // share of the key space.
+    for (int workers = 1; ; workers *= 2) {
+        if (workers > this->maximumWorkers) {
+            workers = this->maximumWorkers;
+        }
+        this->measureSearch(workers, ((uint64_t) 1 << 26) * workers);
+        if (workers == this->maximumWorkers) {
+            break;
+        }
+    }
+}
+
+/**
+ * Measures the search of [0, keys) by one engine on one core.
+ */
+template <typename Engine>
+void Benchmark::measureEngine(Engine& engine, std::string name, uint64_t keys)
+{
+    double fastest = 0;
+    for (int i = 0; i < Benchmark::repetitions; i++) {
+        uint64_t foundCandidate;
+        double started = Benchmark::now();
+        engine.searchKeys(this->rawString, this->encryptedString, KeyPattern(56), 0, keys, foundCandidate);
+        double seconds = Benchmark::now() - started;
+        
+        if (0 == i || seconds < fastest) {
+            fastest = seconds;
+        }
+    }
+    
+    this->addResult("engine", name, 1, keys, fastest);
+}
+
+/**
+ * Measures the threaded search of [0, keys) with the given number of workers.
+ */
+void Benchmark::measureSearch(int workers, uint64_t keys)
+{
+    ThreadedSearch search(this->rawString, this->encryptedString, KeyPattern(56), workers);
+    
+    double fastest = 0;
+    for (int i = 0; i < Benchmark::repetitions; i++) {
+        uint64_t foundCandidate;
+        double started = Benchmark::now();
+        search.run(0, keys, foundCandidate);
+        double seconds = Benchmark::now() - started;
+        
+        if (0 == i || seconds < fastest) {
+            fastest = seconds;
+        }
+    }
+    
+    this->addResult("search", std::string("threads-") + search.getAlgorithm().getKernelName(), workers, keys, fastest);
+}
+
+/**
+ * Measures a stream over a text of the given number of blocks, padding
+ * included, and records the fastest run in bytes.
+ */
+void Benchmark::measureStream(CipherStream::Mode mode, bool decrypt, uint64_t blocks)
+{
+    std::vector<unsigned char> input(blocks * 8), output(blocks * 8 + 8);
+    for (size_t i = 0; i < input.size(); i++) {
+        input[i] = (unsigned char) i;
+    }
+    
+    // the text decrypted is an encrypted one, padding and all.
+    CipherStream encryption(mode, false, 0x0123456789ABCDEFULL, 0x1234567890ABCDEFULL);
+    size_t written, last;
+    if (decrypt) {
+        written = encryption.update(&input[0], input.size() - 8, &output[0]);
+        encryption.finish(&output[written], last);
+        input.swap(output);
+    }
+    
+    double fastest = 0;
+    for (int i = 0; i < Benchmark::repetitions; i++) {
+        CipherStream stream(mode, decrypt, 0x0123456789ABCDEFULL, 0x1234567890ABCDEFULL);
+        double started = Benchmark::now();
+        written = stream.update(&input[0], blocks * 8, &output[0]);
+        stream.finish(&output[written], last);
+        double seconds = Benchmark::now() - started;
+        
+        if (0 == i || seconds < fastest) {
+            fastest = seconds;
+        }
+    }
+    
+    StreamResult result;
+    result.stream = std::string((CipherStream::CBC == mode) ? "cbc" : "ecb") + (decrypt ? "-decrypt" : "-encrypt");
+    result.bytes = blocks * 8;
+    result.seconds = fastest;
+    this->streamResults.push_back(result);
+    
+    // show the progress; the results go to the standard output at the end.
+    fprintf(stderr, "stream %s: %.1f MB/second\n", result.stream.c_str(), result.bytes / fastest / 1e6);
+}
+
+/**
+ * Records the fastest of the runs of a measurement.
+ */
+void Benchmark::addResult(std::string benchmark, std::string engine, int workers, uint64_t keys, double seconds)
+{
+    Result result;
+    result.benchmark = benchmark;
+    result.engine = engine;
+    result.workers = workers;
+    result.keys = keys;
+    result.seconds = seconds;
+    this->results.push_back(result);
+    
+    // show the progress; the results go to the standard output at the end.
+    fprintf(stderr, "%s %s x%d: %.0f keys/second\n", benchmark.c_str(), engine.c_str(), workers, keys / seconds);
+}
+
+/**
+ * Returns the keys/second of the single-worker search, the base of the
+ * scaling efficiency.
+ */
+double Benchmark::getSingleWorkerRate()
+{
+    for (size_t i = 0; i < this->results.size(); i++) {
+        if ("search" == this->results[i].benchmark && 1 == this->results[i].workers) {
+            return this->results[i].keys / this->results[i].seconds;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Writes the results as CSV, one line per measurement; the streams follow,
+ * after an empty line, in a table of their own.
+ */
+void Benchmark::writeCsv(std::ostream& output)
+{
+    double singleWorkerRate = this->getSingleWorkerRate();
+    
+    output << "benchmark,engine,workers,keys,seconds,keys_per_second,keys_per_second_per_core,ns_per_key,efficiency\n";
+    for (size_t i = 0; i < this->results.size(); i++) {
+        const Result& result = this->results[i];
+        double rate = result.keys / result.seconds;
+        double efficiency = ("search" == result.benchmark && 0 < singleWorkerRate) ? rate / (singleWorkerRate * result.workers) : 1;
+        
+        output << result.benchmark << ',' << result.engine << ',' << result.workers << ',' << result.keys << ',' << result.seconds << ','
+            << (uint64_t) rate << ',' << (uint64_t) (rate / result.workers) << ',' << result.seconds * 1e9 * result.workers / result.keys << ','
+            << efficiency << '\n';
+    }
+    
+    output << "\nstream,bytes,seconds,megabytes_per_second,ns_per_byte\n";
+    for (size_t i = 0; i < this->streamResults.size(); i++) {
+        const StreamResult& result = this->streamResults[i];
+        output << result.stream << ',' << result.bytes << ',' << result.seconds << ',' << result.bytes / result.seconds / 1e6 << ','
+            << result.seconds * 1e9 / result.bytes << '\n';
+    }
+}
+
+/**
+ * Writes the results as a JSON object.
+ */
+void Benchmark::writeJson(std::ostream& output)
+{
+    double singleWorkerRate = this->getSingleWorkerRate();
+    
+    output << "{\n  \"cores\": " << ThreadedSearch::getNumberOfCores() << ",\n  \"results\": [\n";
+    for (size_t i = 0; i < this->results.size(); i++) {
+        const Result& result = this->results[i];
+        double rate = result.keys / result.seconds;
+        double efficiency = ("search" == result.benchmark && 0 < singleWorkerRate) ? rate / (singleWorkerRate * result.workers) : 1;
+        
+        output << "    {\"benchmark\": \"" << result.benchmark << "\", \"engine\": \"" << result.engine << "\", \"workers\": " << result.workers
+            << ", \"keys\": " << result.keys << ", \"seconds\": " << result.seconds << ", \"keys_per_second\": " << (uint64_t) rate
+            << ", \"keys_per_second_per_core\": " << (uint64_t) (rate / result.workers)
+            << ", \"ns_per_key\": " << result.seconds * 1e9 * result.workers / result.keys << ", \"efficiency\": " << efficiency << "}"
+            << ((i + 1 < this->results.size()) ? ",\n" : "\n");
+    }
+    output << "  ],\n  \"streams\": [\n";
+    for (size_t i = 0; i < this->streamResults.size(); i++) {
+        const StreamResult& result = this->streamResults[i];
+        output << "    {\"stream\": \"" << result.stream << "\", \"bytes\": " << result.bytes << ", \"seconds\": " << result.seconds
+            << ", \"megabytes_per_second\": " << result.bytes / result.seconds / 1e6 << ", \"ns_per_byte\": " << result.seconds * 1e9 / result.bytes << "}"
+            << ((i + 1 < this->streamResults.size()) ? ",\n" : "\n");
+    }
+    output << "  ]\n}\n";
+}
+
+/**
+ * Returns the time on the monotonic clock, in seconds.
+ */
+double Benchmark::now()
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec / 1e9;
+}
@@ -0,0 +1,164 @@
+/**
+ * File: Benchmark.h
+ * 
+ * Header file for the Benchmark class.
+ * 
+ * @version 0.1
+ */
+
+// make sure that the signature of the class is defined only once.
+#ifndef BENCHMARK_H
+#define	BENCHMARK_H
+
+// include the string library for the std::string class.
+#include <string>
+
+// include the vector library.
+#include <vector>
+
+// include the output stream library.
+#include <ostream>
+
+// include the fixed-width integer types.
+#include <stdint.h>
+
+// include the CipherStream class signature.
+#include "CipherStream.h"
+
+/**
+ * Signature of the Benchmark class.
+ * 
+ * Benchmark measures the DES engines on fixed key ranges: every engine on one
+ * core (keys/second and ns/key), then the threaded search from one worker up
+ * to one per core (keys/second, per worker and the scaling efficiency). It is
+ * the mpad-bench tool (make bench):
+ * 
+ *     mpad-bench [csv|json] [maximum number of workers]
+ * 
+ * The ECB and CBC streams are measured too, each way on one core, in a
+ * table of their own (bytes, MB/second and ns/byte).
+ * 
+ * The results are written in CSV or JSON, so that they can be compared from
+ * one release to the next.
+ * 
+ * @since version 0.1
+ * @see AlgorithmDES
+ * @see AlgorithmDESLegacy
+ * @see AlgorithmDESBitslice
+ * @see CipherStream
+ * @see ThreadedSearch
+ */
+class Benchmark
+{
+    // public attributes and methods of the class.
+    public:
+        
+        /**
+         * Constructor method of the class.
+         * 
+         * @param maximumWorkers Largest number of workers the scaling is
+         * measured with; 0 means one per core.
+         */
+        Benchmark(int maximumWorkers);
+        
+        /**
+         * Runs every measurement.
+         */
+        void run();
+        
+        /**
+         * Writes the results as CSV, one line per measurement; the streams
+         * follow in a table of their own.
+         */
+        void writeCsv(std::ostream& output);
+        
+        /**
+         * Writes the results as a JSON object.
+         */
+        void writeJson(std::ostream& output);
+    
+    // private attributes and methods of the class.
+    private:
+        
+        /**
+         * The result of a measurement.
+         */
+        struct Result
+        {
+            std::string benchmark;
+            std::string engine;
+            int workers;
+            uint64_t keys;
+            double seconds;
+        };
+        
+        /**
+         * The result of a stream measurement.
+         */
+        struct StreamResult
+        {
+            std::string stream;
+            uint64_t bytes;
+            double seconds;
+        };
+        
+        /**
+         * Number of times a measurement is repeated; the fastest run counts.
+         */
+        static const int repetitions = 3;
+        
+        /**
+         * Largest number of workers the scaling is measured with.
+         */
+        int maximumWorkers;
+        
+        /**
+         * The known raw/encrypted string pair. Its key is outside every range
+         * that is searched, so that every candidate is tested.
+         */
+        std::string rawString;
+        std::string encryptedString;
+        
+        /**
+         * The results, in the order they were measured.
+         */
+        std::vector<Result> results;
+        std::vector<StreamResult> streamResults;
+        
+        /**
+         * Measures the search of [0, keys) by one engine on one core.
+         */
+        template <typename Engine>
+        void measureEngine(Engine& engine, std::string name, uint64_t keys);
+        
+        /**
+         * Measures the threaded search of [0, keys) with the given number of
+         * workers.
+         */
+        void measureSearch(int workers, uint64_t keys);
+        
+        /**
+         * Measures a stream over a text of the given number of blocks, and
+         * records the fastest run in bytes.
+         */
+        void measureStream(CipherStream::Mode mode, bool decrypt, uint64_t blocks);
+        
+        /**
+         * Records the fastest of the runs of a measurement.
+         */
+        void addResult(std::string benchmark, std::string engine, int workers, uint64_t keys, double seconds);
+        
+        /**
+         * Returns the keys/second of the single-worker search, the base of
+         * the scaling efficiency.
+         */
+        double getSingleWorkerRate();
+        
+        /**
+         * Returns the time on the monotonic clock, in seconds.
+         */
+        static double now();
+};
+
+// end of the class signature.
+#endif	/* BENCHMARK_H */
@@ -0,0 +1,53 @@
+/**
+ * File: BitsliceAVX2.cpp
+ * 
+ * AVX2 instantiation of the bitsliced key-test kernel. This file is compiled
+ * with -mavx2 and must only be entered after the CPU has been checked.
+ * 
+ * @version 0.1
+ */
+
+// include the kernel declarations and the bitsliced kernel.
+#include "BitsliceKernels.h"
+#include "BitsliceDES.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+/**
+ * 256 lanes, i.e. one ymm register per slice.
+ */
+typedef uint64_t BitsliceVector256 __attribute__((vector_size(32)));
+
+/**
+ * AVX2 kernel, 256 lanes per pass in a ymm register.
+ */
+uint64_t bitsliceSearchAVX2(uint64_t ipPlain, uint64_t ipCipher, const KeyPattern& pattern, uint64_t base, uint64_t batches, uint64_t* match)
+{
+    return bitsliceSearchBatches<BitsliceVector256>(ipPlain, ipCipher, pattern, base, batches, match);
+}
+
+/**
+ * AVX2 kernel against a table of ciphertext blocks.
+ */
+uint64_t bitsliceSearchTableAVX2(uint64_t ipPlain, const BitsliceBlockTable& table, const KeyPattern& pattern, uint64_t base, uint64_t batches, uint64_t* match)
+{
+    return bitsliceSearchBatchesTable<BitsliceVector256>(ipPlain, table, pattern, base, batches, match);
+}
+
+/**
+ * AVX2 kernel over a list of keys.
+ */
+uint64_t bitsliceSearchListAVX2(uint64_t ipPlain, uint64_t ipCipher, const uint64_t* keys, uint64_t batches, uint64_t* match)
+{
+    return bitsliceSearchBatchesList<BitsliceVector256>(ipPlain, ipCipher, keys, batches, match);
+}
+
+/**
+ * AVX2 kernel that encrypts or decrypts 256 blocks per pass.
+ */
+void bitsliceCryptAVX2(const uint64_t* keySlices, const unsigned char* input, unsigned char* output, size_t blocks, bool decrypt)
+{
+    bitsliceCryptBlocks<BitsliceVector256>(keySlices, input, output, blocks, decrypt);
+}
+
+#endif
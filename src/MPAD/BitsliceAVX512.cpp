@@ -0,0 +1,54 @@
+/**
+ * File: BitsliceAVX512.cpp
+ * 
+ * AVX-512 instantiation of the bitsliced key-test kernel. This file is
+ * compiled with -mavx512f and must only be entered after the CPU has been
+ * checked.
+ * 
+ * @version 0.1
+ */
+
+// include the kernel declarations and the bitsliced kernel.
+#include "BitsliceKernels.h"
+#include "BitsliceDES.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+/**
+ * 512 lanes, i.e. one zmm register per slice.
+ */
+typedef uint64_t BitsliceVector512 __attribute__((vector_size(64)));
+
+/**
+ * AVX-512 kernel, 512 lanes per pass in a zmm register.
+ */
+uint64_t bitsliceSearchAVX512(uint64_t ipPlain, uint64_t ipCipher, const KeyPattern& pattern, uint64_t base, uint64_t batches, uint64_t* match)
+{
+    return bitsliceSearchBatches<BitsliceVector512>(ipPlain, ipCipher, pattern, base, batches, match);
+}
+
+/**
+ * AVX-512 kernel against a table of ciphertext blocks.
+ */
+uint64_t bitsliceSearchTableAVX512(uint64_t ipPlain, const BitsliceBlockTable& table, const KeyPattern& pattern, uint64_t base, uint64_t batches, uint64_t* match)
+{
+    return bitsliceSearchBatchesTable<BitsliceVector512>(ipPlain, table, pattern, base, batches, match);
+}
+
+/**
+ * AVX-512 kernel over a list of keys.
+ */
+uint64_t bitsliceSearchListAVX512(uint64_t ipPlain, uint64_t ipCipher, const uint64_t* keys, uint64_t batches, uint64_t* match)
+{
+    return bitsliceSearchBatchesList<BitsliceVector512>(ipPlain, ipCipher, keys, batches, match);
+}
+
+/**
+ * AVX-512 kernel that encrypts or decrypts 512 blocks per pass.
+ */
+void bitsliceCryptAVX512(const uint64_t* keySlices, const unsigned char* input, unsigned char* output, size_t blocks, bool decrypt)
+{
+    bitsliceCryptBlocks<BitsliceVector512>(keySlices, input, output, blocks, decrypt);
+}
+
+#endif
@@ -0,0 +1,680 @@
+/**
+ * File: BitsliceDES.h
+ * 
+ * Bitsliced DES kernel shared by the bitsliced engines.
+ * 
+ * In bitsliced form every DES state bit is stored in its own Slice and bit j
+ * of every Slice belongs to lane j. One pass through the kernel therefore runs
+ * DES for as many independent (key, block) pairs as the Slice type has bits.
+ * The kernel is written against a generic Slice type that only needs the
+ * bitwise operators, so the same code serves uint64_t and the wider vector
+ * types.
+ * 
+ * Everything in this header has internal linkage on purpose: translation units
+ * compiled for different instruction sets must each keep their own copy.
+ * 
+ * @version 0.1
+ */
+
+// make sure that the kernel is defined only once.
+#ifndef BITSLICEDES_H
+#define	BITSLICEDES_H
+
+// include the fixed-width integer types.
+#include <stdint.h>
+
+// include the memory related functions.
+#include <string.h>
+
+// include the gate-level S-boxes.
+#include "BitsliceSBoxes.h"
+
+// include the KeyPattern class signature.
+#include "KeyPattern.h"
+
+/**
+ * For every round and every bit of the 48-bit round key, the position (0 is
+ * the most significant bit) of the 64-bit DES key the bit is taken from. This
+ * is PC-1, the left shifts and PC-2 folded into a single lookup, so that the
+ * bitsliced engine never runs a key schedule of its own.
+ */
+static const unsigned char bitsliceKeySchedule[16][48] = {
+    {  9, 50, 33, 59, 48, 16, 32, 56,  1,  8, 18, 41,  2, 34, 25, 24, 43, 57, 58,  0, 35, 26, 17, 40,
+      21, 27, 38, 53, 36,  3, 46, 29,  4, 52, 22, 28, 60, 20, 37, 62, 14, 19, 44, 13, 12, 61, 54, 30 },
+    {  1, 42, 25, 51, 40,  8, 24, 48, 58,  0, 10, 33, 59, 26, 17, 16, 35, 49, 50, 57, 56, 18,  9, 32,
+      13, 19, 30, 45, 28, 62, 38, 21, 27, 44, 14, 20, 52, 12, 29, 54,  6, 11, 36,  5,  4, 53, 46, 22 },
+    { 50, 26,  9, 35, 24, 57,  8, 32, 42, 49, 59, 17, 43, 10,  1,  0, 48, 33, 34, 41, 40,  2, 58, 16,
+      60,  3, 14, 29, 12, 46, 22,  5, 11, 28, 61,  4, 36, 27, 13, 38, 53, 62, 20, 52, 19, 37, 30,  6 },
+    { 34, 10, 58, 48,  8, 41, 57, 16, 26, 33, 43,  1, 56, 59, 50, 49, 32, 17, 18, 25, 24, 51, 42,  0,
+      44, 54, 61, 13, 27, 30,  6, 52, 62, 12, 45, 19, 20, 11, 60, 22, 37, 46,  4, 36,  3, 21, 14, 53 },
+    { 18, 59, 42, 32, 57, 25, 41,  0, 10, 17, 56, 50, 40, 43, 34, 33, 16,  1,  2,  9,  8, 35, 26, 49,
+      28, 38, 45, 60, 11, 14, 53, 36, 46, 27, 29,  3,  4, 62, 44,  6, 21, 30, 19, 20, 54,  5, 61, 37 },
+    {  2, 43, 26, 16, 41,  9, 25, 49, 59,  1, 40, 34, 24, 56, 18, 17,  0, 50, 51, 58, 57, 48, 10, 33,
+      12, 22, 29, 44, 62, 61, 37, 20, 30, 11, 13, 54, 19, 46, 28, 53,  5, 14,  3,  4, 38, 52, 45, 21 },
+    { 51, 56, 10,  0, 25, 58,  9, 33, 43, 50, 24, 18,  8, 40,  2,  1, 49, 34, 35, 42, 41, 32, 59, 17,
+      27,  6, 13, 28, 46, 45, 21,  4, 14, 62, 60, 38,  3, 30, 12, 37, 52, 61, 54, 19, 22, 36, 29,  5 },
+    { 35, 40, 59, 49,  9, 42, 58, 17, 56, 34,  8,  2, 57, 24, 51, 50, 33, 18, 48, 26, 25, 16, 43,  1,
+      11, 53, 60, 12, 30, 29,  5, 19, 61, 46, 44, 22, 54, 14, 27, 21, 36, 45, 38,  3,  6, 20, 13, 52 },
+    { 56, 32, 51, 41,  1, 34, 50,  9, 48, 26,  0, 59, 49, 16, 43, 42, 25, 10, 40, 18, 17,  8, 35, 58,
+       3, 45, 52,  4, 22, 21, 60, 11, 53, 38, 36, 14, 46,  6, 19, 13, 28, 37, 30, 62, 61, 12,  5, 44 },
+    { 40, 16, 35, 25, 50, 18, 34, 58, 32, 10, 49, 43, 33,  0, 56, 26,  9, 59, 24,  2,  1, 57, 48, 42,
+      54, 29, 36, 19,  6,  5, 44, 62, 37, 22, 20, 61, 30, 53,  3, 60, 12, 21, 14, 46, 45, 27, 52, 28 },
+    { 24,  0, 48,  9, 34,  2, 18, 42, 16, 59, 33, 56, 17, 49, 40, 10, 58, 43,  8, 51, 50, 41, 32, 26,
+      38, 13, 20,  3, 53, 52, 28, 46, 21,  6,  4, 45, 14, 37, 54, 44, 27,  5, 61, 30, 29, 11, 36, 12 },
+    {  8, 49, 32, 58, 18, 51,  2, 26,  0, 43, 17, 40,  1, 33, 24, 59, 42, 56, 57, 35, 34, 25, 16, 10,
+      22, 60,  4, 54, 37, 36, 12, 30,  5, 53, 19, 29, 61, 21, 38, 28, 11, 52, 45, 14, 13, 62, 20, 27 },
+    { 57, 33, 16, 42,  2, 35, 51, 10, 49, 56,  1, 24, 50, 17,  8, 43, 26, 40, 41, 48, 18,  9,  0, 59,
+       6, 44, 19, 38, 21, 20, 27, 14, 52, 37,  3, 13, 45,  5, 22, 12, 62, 36, 29, 61, 60, 46,  4, 11 },
+    { 41, 17,  0, 26, 51, 48, 35, 59, 33, 40, 50,  8, 34,  1, 57, 56, 10, 24, 25, 32,  2, 58, 49, 43,
+      53, 28,  3, 22,  5,  4, 11, 61, 36, 21, 54, 60, 29, 52,  6, 27, 46, 20, 13, 45, 44, 30, 19, 62 },
+    { 25,  1, 49, 10, 35, 32, 48, 43, 17, 24, 34, 57, 18, 50, 41, 40, 59,  8,  9, 16, 51, 42, 33, 56,
+      37, 12, 54,  6, 52, 19, 62, 45, 20,  5, 38, 44, 13, 36, 53, 11, 30,  4, 60, 29, 28, 14,  3, 46 },
+    { 17, 58, 41,  2, 56, 24, 40, 35,  9, 16, 26, 49, 10, 42, 33, 32, 51,  0,  1,  8, 43, 34, 25, 48,
+      29,  4, 46, 61, 44, 11, 54, 37, 12, 60, 30, 36,  5, 28, 45,  3, 22, 27, 52, 21, 20,  6, 62, 38 }
+};
+
+/**
+ * Initial permutation (IP), 1-based positions as in FIPS 46.
+ */
+static const unsigned char bitsliceIP[64] = {
+    58, 50, 42, 34, 26, 18, 10, 2, 60, 52, 44, 36, 28, 20, 12, 4,
+    62, 54, 46, 38, 30, 22, 14, 6, 64, 56, 48, 40, 32, 24, 16, 8,
+    57, 49, 41, 33, 25, 17,  9, 1, 59, 51, 43, 35, 27, 19, 11, 3,
+    61, 53, 45, 37, 29, 21, 13, 5, 63, 55, 47, 39, 31, 23, 15, 7
+};
+
+/**
+ * Final permutation (IP^-1), 1-based positions as in FIPS 46.
+ */
+static const unsigned char bitsliceFP[64] = {
+    40, 8, 48, 16, 56, 24, 64, 32, 39, 7, 47, 15, 55, 23, 63, 31,
+    38, 6, 46, 14, 54, 22, 62, 30, 37, 5, 45, 13, 53, 21, 61, 29,
+    36, 4, 44, 12, 52, 20, 60, 28, 35, 3, 43, 11, 51, 19, 59, 27,
+    34, 2, 42, 10, 50, 18, 58, 26, 33, 1, 41,  9, 49, 17, 57, 25
+};
+
+/**
+ * Bit j of the lane index for the first six bits; used for the candidate key
+ * bits that vary inside a 64-lane word.
+ */
+static const uint64_t bitsliceLanePattern[6] = {
+    0xAAAAAAAAAAAAAAAAULL, 0xCCCCCCCCCCCCCCCCULL, 0xF0F0F0F0F0F0F0F0ULL,
+    0xFF00FF00FF00FF00ULL, 0xFFFF0000FFFF0000ULL, 0xFFFFFFFF00000000ULL
+};
+
+/**
+ * Applies a 1-based bit permutation table to a 64-bit block (bit 63 being
+ * position 1).
+ * 
+ * @param block The block to permute.
+ * @param table The permutation table.
+ * @return The permuted block.
+ */
+static inline uint64_t bitslicePermute(uint64_t block, const unsigned char* table)
+{
+    uint64_t result = 0;
+    for (int i = 0; i < 64; i++) {
+        result = (result << 1) | ((block >> (64 - table[i])) & 1);
+    }
+    return result;
+}
+
+/**
+ * Loads 8 bytes as a big-endian 64-bit block.
+ */
+static inline uint64_t bitsliceLoadBlock(const unsigned char* bytes)
+{
+    uint64_t block;
+    memcpy(&block, bytes, 8);
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    block = __builtin_bswap64(block);
+#endif
+    return block;
+}
+
+/**
+ * Stores a 64-bit block as 8 big-endian bytes.
+ */
+static inline void bitsliceStoreBlock(uint64_t block, unsigned char* bytes)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    block = __builtin_bswap64(block);
+#endif
+    memcpy(bytes, &block, 8);
+}
+
+/**
+ * Transposes a 64x64 bit matrix in place (word i, bit 63-j <-> word j, bit
+ * 63-i). Used to move between one-block-per-word and bitsliced layouts. With
+ * wider Slices, every 64-bit lane word holds a matrix of its own, and they
+ * are all transposed at once.
+ * 
+ * @param a The 64 words of the matrix.
+ */
+template <typename Slice>
+static inline void bitsliceTranspose64(Slice* a)
+{
+    uint64_t mask = 0x00000000FFFFFFFFULL;
+    for (int j = 32; j != 0; j >>= 1, mask ^= (mask << j)) {
+        for (int k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+            Slice t = (a[k] ^ (a[k | j] >> j)) & mask;
+            a[k] ^= t;
+            a[k | j] ^= (t << j);
+        }
+    }
+}
+
+/**
+ * Returns a Slice with every lane set to the given bit.
+ */
+template <typename Slice>
+static inline Slice bitsliceBroadcast(int bit)
+{
+    uint64_t words[sizeof(Slice) / sizeof(uint64_t)];
+    memset(words, bit ? 0xFF : 0x00, sizeof(words));
+    Slice slice;
+    memcpy(&slice, words, sizeof(Slice));
+    return slice;
+}
+
+/**
+ * Fills the 64 key slices with consecutive candidates base, base+1, ... (one
+ * per lane). Candidate i stands for the key the key pattern gives it: the
+ * known bits, with the binary form of i in the free bits.
+ * 
+ * @param key The 64 key slices to fill, one per DES key bit position.
+ * @param pattern The known and the free bits of the keys.
+ * @param base First candidate; must be a multiple of the lane count.
+ */
+template <typename Slice>
+static inline void bitsliceLoadCandidates(Slice* key, const KeyPattern& pattern, uint64_t base)
+{
+    const int words = sizeof(Slice) / sizeof(uint64_t);
+    const int laneBits = 6 + __builtin_ctz(words);
+    uint64_t slice[words];
+    
+    for (int position = 0; position < 64; position++) {
+        // the bit of the candidate index that lands on this key position,
+        // or -1 if the position is a known one.
+        uint64_t positionBit = (uint64_t) 1 << (63 - position);
+        int bit = (0 != (pattern.getUnknownMask() & positionBit)) ? __builtin_popcountll(pattern.getUnknownMask() & (positionBit - 1)) : -1;
+        for (int w = 0; w < words; w++) {
+            if (0 > bit) {
+                slice[w] = (0 != (pattern.getKnownKey() & positionBit)) ? ~0ULL : 0ULL;
+            } else if (6 > bit) {
+                slice[w] = bitsliceLanePattern[bit];
+            } else if (laneBits > bit) {
+                slice[w] = ((w >> (bit - 6)) & 1) ? ~0ULL : 0ULL;
+            } else {
+                slice[w] = ((base >> bit) & 1) ? ~0ULL : 0ULL;
+            }
+        }
+        memcpy(&key[position], slice, sizeof(Slice));
+    }
+}
+
+/**
+ * Moves the key slices from the batch at oldBase to the batch at newBase.
+ * Lane bits never change, and every other candidate bit is all ones or all
+ * zeros, so only the slices of the bits that differ get inverted. Stepping to
+ * the next batch usually touches one or two slices.
+ * 
+ * @param key The 64 key slices, loaded for oldBase.
+ * @param pattern The known and the free bits of the keys.
+ * @param oldBase First candidate of the current batch.
+ * @param newBase First candidate of the next batch.
+ */
+template <typename Slice>
+static inline void bitsliceStepCandidates(Slice* key, const KeyPattern& pattern, uint64_t oldBase, uint64_t newBase)
+{
+    for (uint64_t changed = oldBase ^ newBase; 0 != changed; changed &= changed - 1) {
+        int position = pattern.getPosition(__builtin_ctzll(changed));
+        if (0 <= position) {
+            key[position] = ~key[position];
+        }
+    }
+}
+
+/**
+ * One DES round: l ^= f(r, k), computed for all lanes.
+ * 
+ * @param key The 64 key slices.
+ * @param k The key schedule row of the round.
+ * @param r The right half (32 slices).
+ * @param l The left half (32 slices), updated in place.
+ */
+template <typename Slice>
+static inline void bitsliceRound(const Slice* key, const unsigned char* k, const Slice* r, Slice* l)
+{
+    sbox1(r[31] ^ key[k[0]], r[0] ^ key[k[1]], r[1] ^ key[k[2]], r[2] ^ key[k[3]], r[3] ^ key[k[4]], r[4] ^ key[k[5]],
+        l[8], l[16], l[22], l[30]);
+    sbox2(r[3] ^ key[k[6]], r[4] ^ key[k[7]], r[5] ^ key[k[8]], r[6] ^ key[k[9]], r[7] ^ key[k[10]], r[8] ^ key[k[11]],
+        l[12], l[27], l[1], l[17]);
+    sbox3(r[7] ^ key[k[12]], r[8] ^ key[k[13]], r[9] ^ key[k[14]], r[10] ^ key[k[15]], r[11] ^ key[k[16]], r[12] ^ key[k[17]],
+        l[23], l[15], l[29], l[5]);
+    sbox4(r[11] ^ key[k[18]], r[12] ^ key[k[19]], r[13] ^ key[k[20]], r[14] ^ key[k[21]], r[15] ^ key[k[22]], r[16] ^ key[k[23]],
+        l[25], l[19], l[9], l[0]);
+    sbox5(r[15] ^ key[k[24]], r[16] ^ key[k[25]], r[17] ^ key[k[26]], r[18] ^ key[k[27]], r[19] ^ key[k[28]], r[20] ^ key[k[29]],
+        l[7], l[13], l[24], l[2]);
+    sbox6(r[19] ^ key[k[30]], r[20] ^ key[k[31]], r[21] ^ key[k[32]], r[22] ^ key[k[33]], r[23] ^ key[k[34]], r[24] ^ key[k[35]],
+        l[3], l[28], l[10], l[18]);
+    sbox7(r[23] ^ key[k[36]], r[24] ^ key[k[37]], r[25] ^ key[k[38]], r[26] ^ key[k[39]], r[27] ^ key[k[40]], r[28] ^ key[k[41]],
+        l[31], l[11], l[21], l[6]);
+    sbox8(r[27] ^ key[k[42]], r[28] ^ key[k[43]], r[29] ^ key[k[44]], r[30] ^ key[k[45]], r[31] ^ key[k[46]], r[0] ^ key[k[47]],
+        l[4], l[26], l[14], l[20]);
+}
+
+/**
+ * Tells whether every lane of a Slice is set.
+ */
+template <typename Slice>
+static inline bool bitsliceAllSet(const Slice& slice)
+{
+    uint64_t words[sizeof(Slice) / 8];
+    memcpy(words, &slice, sizeof(Slice));
+    
+    uint64_t all = ~0ULL;
+    for (size_t i = 0; i < sizeof(Slice) / 8; i++) {
+        all &= words[i];
+    }
+    return ~0ULL == all;
+}
+
+/**
+ * Adds the lanes in which any of four output bits differs from the expected
+ * value to the mismatch mask.
+ * 
+ * @return Whether every lane has mismatched by now.
+ */
+template <typename Slice>
+static inline bool bitsliceReject(const Slice* l, const Slice* expected, int a, int b, int c, int d, Slice& mismatch)
+{
+    mismatch |= (l[a] ^ expected[a]) | (l[b] ^ expected[b]) | (l[c] ^ expected[c]) | (l[d] ^ expected[d]);
+    return bitsliceAllSet(mismatch);
+}
+
+/**
+ * One of the last two DES rounds of a key search: like bitsliceRound, but
+ * the half it updates is final, so every S-box output is compared against
+ * the expected value as soon as it is known and the round stops once every
+ * lane has mismatched.
+ * 
+ * @param key The 64 key slices.
+ * @param k The key schedule row of the round.
+ * @param r The right half (32 slices).
+ * @param l The left half (32 slices), updated in place.
+ * @param expected The expected final value of l.
+ * @param mismatch The lanes that have mismatched so far; updated in place.
+ * @return Whether every lane has mismatched.
+ */
+template <typename Slice>
+static inline bool bitsliceRoundFiltered(const Slice* key, const unsigned char* k, const Slice* r, Slice* l, const Slice* expected, Slice& mismatch)
+{
+    sbox1(r[31] ^ key[k[0]], r[0] ^ key[k[1]], r[1] ^ key[k[2]], r[2] ^ key[k[3]], r[3] ^ key[k[4]], r[4] ^ key[k[5]],
+        l[8], l[16], l[22], l[30]);
+    if (bitsliceReject(l, expected, 8, 16, 22, 30, mismatch)) {
+        return true;
+    }
+    sbox2(r[3] ^ key[k[6]], r[4] ^ key[k[7]], r[5] ^ key[k[8]], r[6] ^ key[k[9]], r[7] ^ key[k[10]], r[8] ^ key[k[11]],
+        l[12], l[27], l[1], l[17]);
+    if (bitsliceReject(l, expected, 12, 27, 1, 17, mismatch)) {
+        return true;
+    }
+    sbox3(r[7] ^ key[k[12]], r[8] ^ key[k[13]], r[9] ^ key[k[14]], r[10] ^ key[k[15]], r[11] ^ key[k[16]], r[12] ^ key[k[17]],
+        l[23], l[15], l[29], l[5]);
+    if (bitsliceReject(l, expected, 23, 15, 29, 5, mismatch)) {
+        return true;
+    }
+    sbox4(r[11] ^ key[k[18]], r[12] ^ key[k[19]], r[13] ^ key[k[20]], r[14] ^ key[k[21]], r[15] ^ key[k[22]], r[16] ^ key[k[23]],
+        l[25], l[19], l[9], l[0]);
+    if (bitsliceReject(l, expected, 25, 19, 9, 0, mismatch)) {
+        return true;
+    }
+    sbox5(r[15] ^ key[k[24]], r[16] ^ key[k[25]], r[17] ^ key[k[26]], r[18] ^ key[k[27]], r[19] ^ key[k[28]], r[20] ^ key[k[29]],
+        l[7], l[13], l[24], l[2]);
+    if (bitsliceReject(l, expected, 7, 13, 24, 2, mismatch)) {
+        return true;
+    }
+    sbox6(r[19] ^ key[k[30]], r[20] ^ key[k[31]], r[21] ^ key[k[32]], r[22] ^ key[k[33]], r[23] ^ key[k[34]], r[24] ^ key[k[35]],
+        l[3], l[28], l[10], l[18]);
+    if (bitsliceReject(l, expected, 3, 28, 10, 18, mismatch)) {
+        return true;
+    }
+    sbox7(r[23] ^ key[k[36]], r[24] ^ key[k[37]], r[25] ^ key[k[38]], r[26] ^ key[k[39]], r[27] ^ key[k[40]], r[28] ^ key[k[41]],
+        l[31], l[11], l[21], l[6]);
+    if (bitsliceReject(l, expected, 31, 11, 21, 6, mismatch)) {
+        return true;
+    }
+    sbox8(r[27] ^ key[k[42]], r[28] ^ key[k[43]], r[29] ^ key[k[44]], r[30] ^ key[k[45]], r[31] ^ key[k[46]], r[0] ^ key[k[47]],
+        l[4], l[26], l[14], l[20]);
+    return bitsliceReject(l, expected, 4, 26, 14, 20, mismatch);
+}
+
+/**
+ * Runs the 16 DES rounds on a pre-permuted state. On return l holds L16 and r
+ * holds R16, so that (r, l) is the block before the final permutation.
+ * 
+ * @param key The 64 key slices.
+ * @param l The left half after IP (32 slices).
+ * @param r The right half after IP (32 slices).
+ * @param decrypt Whether the round keys are applied in reverse order.
+ */
+template <typename Slice>
+static inline void bitsliceRounds(const Slice* key, Slice* l, Slice* r, bool decrypt)
+{
+    for (int round = 0; round < 16; round += 2) {
+        bitsliceRound(key, bitsliceKeySchedule[decrypt ? 15 - round : round], r, l);
+        bitsliceRound(key, bitsliceKeySchedule[decrypt ? 14 - round : round + 1], l, r);
+    }
+}
+
+/**
+ * Encrypts or decrypts one bitsliced block per lane in place (IP, 16 rounds,
+ * final permutation).
+ * 
+ * @param key The 64 key slices.
+ * @param block The 64 block slices; slice 0 is the most significant bit.
+ * @param decrypt Whether to decrypt instead of encrypt.
+ */
+template <typename Slice>
+static inline void bitsliceCrypt(const Slice* key, Slice* block, bool decrypt)
+{
+    Slice l[32], r[32];
+    for (int i = 0; i < 32; i++) {
+        l[i] = block[bitsliceIP[i] - 1];
+        r[i] = block[bitsliceIP[32 + i] - 1];
+    }
+    
+    bitsliceRounds(key, l, r, decrypt);
+    
+    // the pre-output block is R16 followed by L16.
+    for (int i = 0; i < 64; i++) {
+        int source = bitsliceFP[i] - 1;
+        block[i] = (32 > source) ? r[source] : l[source - 32];
+    }
+}
+
+/**
+ * Encrypts or decrypts blocks of a buffer with a single key, as many per
+ * pass as the Slice has lanes. Slice j of a pass is loaded straight from
+ * blocks j * words to j * words + words - 1, one per lane word, and the
+ * 64x64 bit matrices of all the lane words are transposed at once. A last
+ * pass that isn't full goes through a zeroed buffer.
+ * 
+ * Loaded as they are, the bytes of a block sit in the order of the machine;
+ * on a little-endian one, that only swaps the slices of byte i with those of
+ * byte 7 - i, which is undone by swapping them back.
+ * 
+ * @param keySlices The 64 key bits, each all ones or all zeros.
+ * @param input The blocks to encrypt or decrypt.
+ * @param output Receives the blocks; it may be the input.
+ * @param blocks Number of 8-byte blocks.
+ * @param decrypt Whether to decrypt instead of encrypt.
+ */
+template <typename Slice>
+static inline void bitsliceCryptBlocks(const uint64_t* keySlices, const unsigned char* input, unsigned char* output, size_t blocks, bool decrypt)
+{
+    const size_t passBytes = 64 * sizeof(Slice);
+    Slice key[64], slices[64];
+    for (int i = 0; i < 64; i++) {
+        key[i] = bitsliceBroadcast<Slice>(0 != keySlices[i]);
+    }
+    
+    for (size_t offset = 0; offset < blocks * 8; offset += passBytes) {
+        size_t bytes = (blocks * 8 - offset < passBytes) ? blocks * 8 - offset : passBytes;
+        if (bytes < passBytes) {
+            memset(slices, 0, sizeof(slices));
+        }
+        memcpy(slices, input + offset, bytes);
+        bitsliceTranspose64(slices);
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        for (int i = 0; i < 32; i++) {
+            Slice t = slices[i];
+            slices[i] = slices[i ^ 56];
+            slices[i ^ 56] = t;
+        }
+#endif
+        
+        bitsliceCrypt(key, slices, decrypt);
+        
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        for (int i = 0; i < 32; i++) {
+            Slice t = slices[i];
+            slices[i] = slices[i ^ 56];
+            slices[i ^ 56] = t;
+        }
+#endif
+        bitsliceTranspose64(slices);
+        memcpy(output + offset, slices, bytes);
+    }
+}
+
+/**
+ * Encrypts the broadcast plaintext under the key slices of one batch and
+ * compares the result with the broadcast ciphertext.
+ * 
+ * The result is compared against the permuted ciphertext instead of running
+ * the final permutation, and the last two rounds are checked S-box by S-box,
+ * so that a batch in which no lane can match any more is dropped early.
+ * 
+ * @param key The 64 key slices of the batch.
+ * @param plainLeft The broadcast left half of IP(plaintext).
+ * @param plainRight The broadcast right half of IP(plaintext).
+ * @param cipherLeft The broadcast left half of IP(ciphertext).
+ * @param cipherRight The broadcast right half of IP(ciphertext).
+ * @param match Receives one bit per lane, set where the lane's key matches.
+ * @return Whether any lane matches.
+ */
+template <typename Slice>
+static inline bool bitsliceMatchBatch(const Slice* key, const Slice* plainLeft, const Slice* plainRight, const Slice* cipherLeft, const Slice* cipherRight, uint64_t* match)
+{
+    const uint64_t lanes = sizeof(Slice) * 8;
+    
+    Slice l[32], r[32];
+    memcpy(l, plainLeft, sizeof(l));
+    memcpy(r, plainRight, sizeof(r));
+    for (int round = 0; round < 14; round += 2) {
+        bitsliceRound(key, bitsliceKeySchedule[round], r, l);
+        bitsliceRound(key, bitsliceKeySchedule[round + 1], l, r);
+    }
+    
+    // the expected pre-output block is IP(ciphertext) = R16 followed by L16.
+    // l is final after the 15th round and r after the 16th.
+    Slice mismatch = bitsliceBroadcast<Slice>(0);
+    if (bitsliceRoundFiltered(key, bitsliceKeySchedule[14], r, l, cipherRight, mismatch)
+        || bitsliceRoundFiltered(key, bitsliceKeySchedule[15], l, r, cipherLeft, mismatch)) {
+        memset(match, 0, sizeof(Slice));
+        return false;
+    }
+    const Slice matched = ~mismatch;
+    memcpy(match, &matched, sizeof(Slice));
+    
+    for (uint64_t word = 0; word < lanes / 64; word++) {
+        if (0 != match[word]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Broadcasts the halves of a permuted block, one slice per bit.
+ */
+template <typename Slice>
+static inline void bitsliceBroadcastBlock(uint64_t ipBlock, Slice* left, Slice* right)
+{
+    const Slice zero = bitsliceBroadcast<Slice>(0);
+    const Slice ones = bitsliceBroadcast<Slice>(1);
+    for (int i = 0; i < 32; i++) {
+        left[i] = ((ipBlock >> (63 - i)) & 1) ? ones : zero;
+        right[i] = ((ipBlock >> (31 - i)) & 1) ? ones : zero;
+    }
+}
+
+/**
+ * Tests consecutive batches of candidate keys against a known plaintext and
+ * ciphertext block, stopping at the first batch in which any lane matches.
+ * 
+ * The plaintext is the same for every lane, so the permuted plaintext is
+ * broadcast. The key slices are loaded once and then stepped from batch to
+ * batch.
+ * 
+ * @param ipPlain The known plaintext block after IP.
+ * @param ipCipher The known ciphertext block after IP.
+ * @param pattern The known and the free bits of the keys.
+ * @param base First candidate of the first batch.
+ * @param batches Number of batches to test.
+ * @param match Receives one bit per lane of the last batch tested, set where
+ * the lane's key matches.
+ * @return The index of the batch that matched, or batches if none did.
+ */
+template <typename Slice>
+static inline uint64_t bitsliceSearchBatches(uint64_t ipPlain, uint64_t ipCipher, const KeyPattern& pattern, uint64_t base, uint64_t batches, uint64_t* match)
+{
+    const uint64_t lanes = sizeof(Slice) * 8;
+    Slice key[64];
+    bitsliceLoadCandidates(key, pattern, base);
+    
+    Slice plainLeft[32], plainRight[32], cipherLeft[32], cipherRight[32];
+    bitsliceBroadcastBlock(ipPlain, plainLeft, plainRight);
+    bitsliceBroadcastBlock(ipCipher, cipherLeft, cipherRight);
+    
+    for (uint64_t batch = 0; batch < batches; batch++) {
+        if (0 < batch) {
+            bitsliceStepCandidates(key, pattern, base + (batch - 1) * lanes, base + batch * lanes);
+        }
+        if (bitsliceMatchBatch(key, plainLeft, plainRight, cipherLeft, cipherRight, match)) {
+            return batch;
+        }
+    }
+    
+    return batches;
+}
+
+/**
+ * Loads the key slices of a batch of arbitrary keys, such as the keys of a
+ * candidate list: each 64 keys are transposed into one word of every slice.
+ * 
+ * @param key Receives the 64 key slices.
+ * @param keys One key per lane.
+ */
+template <typename Slice>
+static inline void bitsliceLoadKeys(Slice* key, const uint64_t* keys)
+{
+    const int words = sizeof(Slice) / sizeof(uint64_t);
+    for (int w = 0; w < words; w++) {
+        // the block of lane j goes into word 63 - j, and comes out of the
+        // transposition as one slice per key bit.
+        uint64_t slices[64];
+        for (int lane = 0; lane < 64; lane++) {
+            slices[63 - lane] = keys[w * 64 + lane];
+        }
+        bitsliceTranspose64(slices);
+        for (int position = 0; position < 64; position++) {
+            ((uint64_t*) &key[position])[w] = slices[position];
+        }
+    }
+}
+
+/**
+ * Tests consecutive batches of listed keys against a known plaintext and
+ * ciphertext block, stopping at the first batch in which any lane matches.
+ * The key slices are loaded anew for every batch.
+ * 
+ * @param ipPlain The known plaintext block after IP.
+ * @param ipCipher The known ciphertext block after IP.
+ * @param keys The keys, as many per batch as there are lanes.
+ * @param batches Number of batches to test.
+ * @param match Receives one bit per lane of the last batch tested, set where
+ * the lane's key matches.
+ * @return The index of the batch that matched, or batches if none did.
+ */
+template <typename Slice>
+static inline uint64_t bitsliceSearchBatchesList(uint64_t ipPlain, uint64_t ipCipher, const uint64_t* keys, uint64_t batches, uint64_t* match)
+{
+    const uint64_t lanes = sizeof(Slice) * 8;
+    
+    Slice plainLeft[32], plainRight[32], cipherLeft[32], cipherRight[32];
+    bitsliceBroadcastBlock(ipPlain, plainLeft, plainRight);
+    bitsliceBroadcastBlock(ipCipher, cipherLeft, cipherRight);
+    
+    for (uint64_t batch = 0; batch < batches; batch++) {
+        Slice key[64];
+        bitsliceLoadKeys(key, keys + batch * lanes);
+        if (bitsliceMatchBatch(key, plainLeft, plainRight, cipherLeft, cipherRight, match)) {
+            return batch;
+        }
+    }
+    
+    return batches;
+}
+
+/**
+ * Tests consecutive batches of candidate keys against a known plaintext
+ * block and a table of ciphertext blocks (see BitsliceBlockTable), stopping
+ * at the first batch in which any lane hits one of them.
+ * 
+ * The rounds are the same as in bitsliceSearchBatches, but no round can
+ * reject a lane early: the result is turned back into one block per lane, 64
+ * lanes at a time, and each block is looked up in the table. The lookup
+ * costs the same whatever the number of targets, a small part of the
+ * rounds.
+ * 
+ * @param ipPlain The known plaintext block after IP.
+ * @param table The known ciphertext blocks after IP.
+ * @param pattern The known and the free bits of the keys.
+ * @param base First candidate of the first batch.
+ * @param batches Number of batches to test.
+ * @param match Receives one bit per lane of the last batch tested, set where
+ * the lane's result is in the table.
+ * @return The index of the batch that matched, or batches if none did.
+ */
+template <typename Slice>
+static inline uint64_t bitsliceSearchBatchesTable(uint64_t ipPlain, const BitsliceBlockTable& table, const KeyPattern& pattern, uint64_t base, uint64_t batches, uint64_t* match)
+{
+    const uint64_t lanes = sizeof(Slice) * 8;
+    Slice key[64];
+    bitsliceLoadCandidates(key, pattern, base);
+    
+    Slice plainLeft[32], plainRight[32];
+    bitsliceBroadcastBlock(ipPlain, plainLeft, plainRight);
+    
+    for (uint64_t batch = 0; batch < batches; batch++) {
+        if (0 < batch) {
+            bitsliceStepCandidates(key, pattern, base + (batch - 1) * lanes, base + batch * lanes);
+        }
+        
+        Slice l[32], r[32];
+        memcpy(l, plainLeft, sizeof(l));
+        memcpy(r, plainRight, sizeof(r));
+        bitsliceRounds(key, l, r, false);
+        
+        // the pre-output block is R16 followed by L16; slice i of it is bit
+        // 63 - i of the block, and after the transposition the block of lane
+        // j of a word is word 63 - j.
+        bool hit = false;
+        for (uint64_t word = 0; word < lanes / 64; word++) {
+            uint64_t blocks[64];
+            for (int i = 0; i < 32; i++) {
+                blocks[i] = ((const uint64_t*) &r[i])[word];
+                blocks[32 + i] = ((const uint64_t*) &l[i])[word];
+            }
+            bitsliceTranspose64(blocks);
+            
+            match[word] = 0;
+            for (int lane = 0; lane < 64; lane++) {
+                if (table.contains(blocks[63 - lane])) {
+                    match[word] |= 1ULL << lane;
+                    hit = true;
+                }
+            }
+        }
+        if (hit) {
+            return batch;
+        }
+    }
+    
+    return batches;
+}
+
+#endif	/* BITSLICEDES_H */
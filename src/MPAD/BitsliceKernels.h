@@ -0,0 +1,116 @@
+/**
+ * File: BitsliceKernels.h
+ * 
+ * Declarations of the instruction-set specific bitsliced key-test kernels.
+ * 
+ * Every kernel runs the same BitsliceDES.h code on a different Slice type and
+ * lives in its own translation unit, compiled with the matching instruction
+ * set flags. AlgorithmDESBitslice picks one of them at runtime.
+ * 
+ * @version 0.1
+ */
+
+// make sure that the declarations are made only once.
+#ifndef BITSLICEKERNELS_H
+#define	BITSLICEKERNELS_H
+
+// include the fixed-width integer types.
+#include <stdint.h>
+
+// include the size_t type.
+#include <stddef.h>
+
+// include the KeyPattern class signature.
+#include "KeyPattern.h"
+
+/**
+ * The first ciphertext blocks (after IP) of several targets that share their
+ * first plaintext block, in an open addressing hash table, so that a kernel
+ * can tell in constant time whether a lane hits any of them.
+ */
+struct BitsliceBlockTable
+{
+    /**
+     * The slots, a power of two of them; the empty ones hold the value
+     * empty, which no target has.
+     */
+    const uint64_t* slots;
+    uint64_t mask;
+    int shift;
+    uint64_t empty;
+    
+    /**
+     * Returns the first slot to look at for a block (Fibonacci hashing).
+     */
+    uint64_t slotOf(uint64_t block) const
+    {
+        return (block * 0x9E3779B97F4A7C15ULL) >> this->shift;
+    }
+    
+    /**
+     * Tells whether the block is one of the targets'.
+     */
+    bool contains(uint64_t block) const
+    {
+        for (uint64_t slot = this->slotOf(block); this->empty != this->slots[slot]; slot = (slot + 1) & this->mask) {
+            if (block == this->slots[slot]) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+/**
+ * Tests consecutive batches of candidates (as many per batch as the kernel
+ * has lanes) against the permuted known plaintext and ciphertext blocks. It
+ * stops at the first batch with a matching lane and writes that batch's match
+ * bits, 64 lanes per word. Returns the index of that batch, or batches if no
+ * lane matched.
+ */
+typedef uint64_t (*BitsliceSearchKernel)(uint64_t ipPlain, uint64_t ipCipher, const KeyPattern& pattern, uint64_t base, uint64_t batches, uint64_t* match);
+
+/**
+ * Like BitsliceSearchKernel, but a lane matches if its result is any of the
+ * blocks in the table.
+ */
+typedef uint64_t (*BitsliceTableKernel)(uint64_t ipPlain, const BitsliceBlockTable& table, const KeyPattern& pattern, uint64_t base, uint64_t batches, uint64_t* match);
+
+/**
+ * Like BitsliceSearchKernel, but the keys of the batches are listed instead
+ * of being enumerated from a key pattern (see KeyList).
+ */
+typedef uint64_t (*BitsliceListKernel)(uint64_t ipPlain, uint64_t ipCipher, const uint64_t* keys, uint64_t batches, uint64_t* match);
+
+/**
+ * Encrypts or decrypts whole blocks of a buffer with a single key, given as
+ * 64 key slices that are each all ones or all zeros (see
+ * bitsliceCryptBlocks). The output may be the input.
+ */
+typedef void (*BitsliceCryptKernel)(const uint64_t* keySlices, const unsigned char* input, unsigned char* output, size_t blocks, bool decrypt);
+
+/**
+ * Portable kernel, 64 lanes per pass in a uint64_t.
+ */
+uint64_t bitsliceSearchScalar(uint64_t ipPlain, uint64_t ipCipher, const KeyPattern& pattern, uint64_t base, uint64_t batches, uint64_t* match);
+uint64_t bitsliceSearchTableScalar(uint64_t ipPlain, const BitsliceBlockTable& table, const KeyPattern& pattern, uint64_t base, uint64_t batches, uint64_t* match);
+uint64_t bitsliceSearchListScalar(uint64_t ipPlain, uint64_t ipCipher, const uint64_t* keys, uint64_t batches, uint64_t* match);
+void bitsliceCryptScalar(const uint64_t* keySlices, const unsigned char* input, unsigned char* output, size_t blocks, bool decrypt);
+
+/**
+ * AVX2 kernel, 256 lanes per pass in a ymm register.
+ */
+uint64_t bitsliceSearchAVX2(uint64_t ipPlain, uint64_t ipCipher, const KeyPattern& pattern, uint64_t base, uint64_t batches, uint64_t* match);
+uint64_t bitsliceSearchTableAVX2(uint64_t ipPlain, const BitsliceBlockTable& table, const KeyPattern& pattern, uint64_t base, uint64_t batches, uint64_t* match);
+uint64_t bitsliceSearchListAVX2(uint64_t ipPlain, uint64_t ipCipher, const uint64_t* keys, uint64_t batches, uint64_t* match);
+void bitsliceCryptAVX2(const uint64_t* keySlices, const unsigned char* input, unsigned char* output, size_t blocks, bool decrypt);
+
+/**
+ * AVX-512 kernel, 512 lanes per pass in a zmm register.
+ */
+uint64_t bitsliceSearchAVX512(uint64_t ipPlain, uint64_t ipCipher, const KeyPattern& pattern, uint64_t base, uint64_t batches, uint64_t* match);
+uint64_t bitsliceSearchTableAVX512(uint64_t ipPlain, const BitsliceBlockTable& table, const KeyPattern& pattern, uint64_t base, uint64_t batches, uint64_t* match);
+uint64_t bitsliceSearchListAVX512(uint64_t ipPlain, uint64_t ipCipher, const uint64_t* keys, uint64_t batches, uint64_t* match);
+void bitsliceCryptAVX512(const uint64_t* keySlices, const unsigned char* input, unsigned char* output, size_t blocks, bool decrypt);
+
+#endif	/* BITSLICEKERNELS_H */
@@ -0,0 +1,821 @@
+/**
+ * File: BitsliceSBoxes.h
+ * 
+ * Boolean-circuit forms of the eight DES S-boxes for the bitsliced engine.
+ * 
+ * Each S-box is expressed with AND/OR/XOR/NOT gates only, so that a single
+ * evaluation computes the S-box for every bit lane of the Slice type at once
+ * (64 lanes for uint64_t, more for the wide vector types). The circuits were
+ * derived from the s1..s8 tables of the Des class by Shannon decomposition
+ * and verified exhaustively against those tables.
+ * 
+ * Input a1 is the most significant bit of the 6-bit S-box input (a1 and a6
+ * select the row, a2..a5 the column); out1 is the most significant bit of the
+ * 4-bit S-box output.
+ * 
+ * @version 0.1
+ */
+
+// make sure that the circuits are defined only once.
+#ifndef BITSLICESBOXES_H
+#define	BITSLICESBOXES_H
+
+/**
+ * Gate-level form of S-box 1 (95 gates). Every argument carries one input
+ * bit for all lanes; the four output bits are XORed into out1..out4.
+ */
+template <typename Slice>
+static inline void sbox1(const Slice a1, const Slice a2, const Slice a3, const Slice a4, const Slice a5, const Slice a6,
+    Slice& out1, Slice& out2, Slice& out3, Slice& out4)
+{
+    const Slice x1 = ~a6;
+    const Slice x2 = x1 ^ a2;
+    const Slice x3 = x2 ^ a5;
+    const Slice x4 = a6 & a5;
+    const Slice x5 = x4 & a4;
+    const Slice x6 = x3 ^ x5;
+    const Slice x7 = ~a2;
+    const Slice x8 = x3 & a4;
+    const Slice x9 = x7 ^ x8;
+    const Slice x10 = x9 & a3;
+    const Slice x11 = x6 ^ x10;
+    const Slice x12 = a6 & a2;
+    const Slice x13 = ~a5;
+    const Slice x14 = x12 | x13;
+    const Slice x15 = x1 & ~a2;
+    const Slice x16 = a2 & a5;
+    const Slice x17 = x15 ^ x16;
+    const Slice x18 = x17 & a4;
+    const Slice x19 = x14 ^ x18;
+    const Slice x20 = ~x12;
+    const Slice x21 = x20 & a5;
+    const Slice x22 = a2 ^ x21;
+    const Slice x23 = x15 ^ a5;
+    const Slice x24 = x23 & a4;
+    const Slice x25 = x22 ^ x24;
+    const Slice x26 = x25 & a3;
+    const Slice x27 = x19 ^ x26;
+    const Slice x28 = x27 & a1;
+    const Slice x29 = x11 ^ x28;
+    const Slice x30 = x15 ^ x4;
+    const Slice x31 = ~x15;
+    const Slice x32 = x7 & a5;
+    const Slice x33 = x31 ^ x32;
+    const Slice x34 = x33 & a4;
+    const Slice x35 = x30 ^ x34;
+    const Slice x36 = x1 & a5;
+    const Slice x37 = x20 ^ x36;
+    const Slice x38 = a6 & ~a5;
+    const Slice x39 = x38 & a4;
+    const Slice x40 = x37 ^ x39;
+    const Slice x41 = x40 & a3;
+    const Slice x42 = x35 ^ x41;
+    const Slice x43 = x21 & a4;
+    const Slice x44 = x33 ^ x43;
+    const Slice x45 = a6 | x7;
+    const Slice x46 = x31 & a5;
+    const Slice x47 = x45 ^ x46;
+    const Slice x48 = x45 ^ x4;
+    const Slice x49 = x48 & a4;
+    const Slice x50 = x47 ^ x49;
+    const Slice x51 = x50 & a3;
+    const Slice x52 = x44 ^ x51;
+    const Slice x53 = x52 & a1;
+    const Slice x54 = x42 ^ x53;
+    const Slice x55 = x1 | a2;
+    const Slice x56 = x55 ^ x32;
+    const Slice x57 = x55 & a5;
+    const Slice x58 = x45 ^ x57;
+    const Slice x59 = x58 & a4;
+    const Slice x60 = x56 ^ x59;
+    const Slice x61 = x15 & a4;
+    const Slice x62 = x33 ^ x61;
+    const Slice x63 = x62 & a3;
+    const Slice x64 = x60 ^ x63;
+    const Slice x65 = ~x45;
+    const Slice x66 = x65 & ~a5;
+    const Slice x67 = x66 & a4;
+    const Slice x68 = x58 ^ x67;
+    const Slice x69 = x66 ^ x49;
+    const Slice x70 = x69 & a3;
+    const Slice x71 = x68 ^ x70;
+    const Slice x72 = x71 & a1;
+    const Slice x73 = x64 ^ x72;
+    const Slice x74 = ~x2;
+    const Slice x75 = x74 & a5;
+    const Slice x76 = x65 ^ x75;
+    const Slice x77 = x20 ^ x16;
+    const Slice x78 = x77 & a4;
+    const Slice x79 = x76 ^ x78;
+    const Slice x80 = x12 | a5;
+    const Slice x81 = x80 & a3;
+    const Slice x82 = x79 ^ x81;
+    const Slice x83 = x15 & a5;
+    const Slice x84 = a6 ^ x83;
+    const Slice x85 = x1 ^ x32;
+    const Slice x86 = x85 & a4;
+    const Slice x87 = x84 ^ x86;
+    const Slice x88 = ~x22;
+    const Slice x89 = x15 ^ x36;
+    const Slice x90 = x89 & a4;
+    const Slice x91 = x88 ^ x90;
+    const Slice x92 = x91 & a3;
+    const Slice x93 = x87 ^ x92;
+    const Slice x94 = x93 & a1;
+    const Slice x95 = x82 ^ x94;
+    out1 ^= x29;
+    out2 ^= x54;
+    out3 ^= x73;
+    out4 ^= x95;
+}
+
+/**
+ * Gate-level form of S-box 2 (79 gates). Every argument carries one input
+ * bit for all lanes; the four output bits are XORed into out1..out4.
+ */
+template <typename Slice>
+static inline void sbox2(const Slice a1, const Slice a2, const Slice a3, const Slice a4, const Slice a5, const Slice a6,
+    Slice& out1, Slice& out2, Slice& out3, Slice& out4)
+{
+    const Slice x1 = ~a6;
+    const Slice x2 = x1 ^ a5;
+    const Slice x3 = ~a5;
+    const Slice x4 = x1 | x3;
+    const Slice x5 = x4 & a1;
+    const Slice x6 = x2 ^ x5;
+    const Slice x7 = ~a1;
+    const Slice x8 = x4 | x7;
+    const Slice x9 = x8 & a3;
+    const Slice x10 = x6 ^ x9;
+    const Slice x11 = a6 & ~a5;
+    const Slice x12 = x11 & a1;
+    const Slice x13 = a6 ^ x12;
+    const Slice x14 = x1 & ~a1;
+    const Slice x15 = x14 & a3;
+    const Slice x16 = x13 ^ x15;
+    const Slice x17 = x16 & a2;
+    const Slice x18 = x10 ^ x17;
+    const Slice x19 = x1 & a5;
+    const Slice x20 = x19 & a1;
+    const Slice x21 = a5 ^ x20;
+    const Slice x22 = x21 | a2;
+    const Slice x23 = x22 & a4;
+    const Slice x24 = x18 ^ x23;
+    const Slice x25 = x2 ^ a1;
+    const Slice x26 = a6 & a3;
+    const Slice x27 = x25 ^ x26;
+    const Slice x28 = ~a3;
+    const Slice x29 = x20 | x28;
+    const Slice x30 = x29 & a2;
+    const Slice x31 = x27 ^ x30;
+    const Slice x32 = x4 | a3;
+    const Slice x33 = x1 ^ x20;
+    const Slice x34 = x33 & a2;
+    const Slice x35 = x32 ^ x34;
+    const Slice x36 = x35 & a4;
+    const Slice x37 = x31 ^ x36;
+    const Slice x38 = x3 ^ x5;
+    const Slice x39 = a5 | a1;
+    const Slice x40 = x39 & a3;
+    const Slice x41 = x38 ^ x40;
+    const Slice x42 = x2 & a1;
+    const Slice x43 = x4 ^ x42;
+    const Slice x44 = ~x19;
+    const Slice x45 = x44 & a1;
+    const Slice x46 = a6 ^ x45;
+    const Slice x47 = x46 & a3;
+    const Slice x48 = x43 ^ x47;
+    const Slice x49 = x48 & a2;
+    const Slice x50 = x41 ^ x49;
+    const Slice x51 = x3 | x7;
+    const Slice x52 = x2 & ~a1;
+    const Slice x53 = x52 & a3;
+    const Slice x54 = x51 ^ x53;
+    const Slice x55 = x11 | a1;
+    const Slice x56 = a1 & a3;
+    const Slice x57 = x55 ^ x56;
+    const Slice x58 = x57 & a2;
+    const Slice x59 = x54 ^ x58;
+    const Slice x60 = x59 & a4;
+    const Slice x61 = x50 ^ x60;
+    const Slice x62 = x11 | x7;
+    const Slice x63 = x1 & ~a5;
+    const Slice x64 = x63 & a1;
+    const Slice x65 = x2 ^ x64;
+    const Slice x66 = x65 & a3;
+    const Slice x67 = x62 ^ x66;
+    const Slice x68 = x19 ^ x12;
+    const Slice x69 = x68 & a3;
+    const Slice x70 = x46 ^ x69;
+    const Slice x71 = x70 & a2;
+    const Slice x72 = x67 ^ x71;
+    const Slice x73 = x4 | a1;
+    const Slice x74 = a6 & a1;
+    const Slice x75 = x19 ^ x74;
+    const Slice x76 = x75 & a2;
+    const Slice x77 = x73 ^ x76;
+    const Slice x78 = x77 & a4;
+    const Slice x79 = x72 ^ x78;
+    out1 ^= x24;
+    out2 ^= x37;
+    out3 ^= x61;
+    out4 ^= x79;
+}
+
+/**
+ * Gate-level form of S-box 3 (85 gates). Every argument carries one input
+ * bit for all lanes; the four output bits are XORed into out1..out4.
+ */
+template <typename Slice>
+static inline void sbox3(const Slice a1, const Slice a2, const Slice a3, const Slice a4, const Slice a5, const Slice a6,
+    Slice& out1, Slice& out2, Slice& out3, Slice& out4)
+{
+    const Slice x1 = ~a3;
+    const Slice x2 = x1 | a1;
+    const Slice x3 = a1 & a6;
+    const Slice x4 = x2 ^ x3;
+    const Slice x5 = a3 & a1;
+    const Slice x6 = x5 & a6;
+    const Slice x7 = x1 ^ x6;
+    const Slice x8 = x7 & a5;
+    const Slice x9 = x4 ^ x8;
+    const Slice x10 = a3 | a1;
+    const Slice x11 = ~a1;
+    const Slice x12 = x11 & a6;
+    const Slice x13 = x10 ^ x12;
+    const Slice x14 = ~x10;
+    const Slice x15 = x14 & a6;
+    const Slice x16 = x11 ^ x15;
+    const Slice x17 = x16 & a5;
+    const Slice x18 = x13 ^ x17;
+    const Slice x19 = x18 & a4;
+    const Slice x20 = x9 ^ x19;
+    const Slice x21 = a3 | x11;
+    const Slice x22 = a3 & ~a6;
+    const Slice x23 = x22 & a5;
+    const Slice x24 = x21 ^ x23;
+    const Slice x25 = x11 & ~a6;
+    const Slice x26 = x25 & a5;
+    const Slice x27 = x14 ^ x26;
+    const Slice x28 = x27 & a4;
+    const Slice x29 = x24 ^ x28;
+    const Slice x30 = x29 & a2;
+    const Slice x31 = x20 ^ x30;
+    const Slice x32 = a3 ^ a1;
+    const Slice x33 = x32 ^ a6;
+    const Slice x34 = a3 & a5;
+    const Slice x35 = x33 ^ x34;
+    const Slice x36 = ~x21;
+    const Slice x37 = ~a6;
+    const Slice x38 = x36 | x37;
+    const Slice x39 = x38 & a5;
+    const Slice x40 = a6 ^ x39;
+    const Slice x41 = x40 & a4;
+    const Slice x42 = x35 ^ x41;
+    const Slice x43 = x10 | a6;
+    const Slice x44 = x43 | a5;
+    const Slice x45 = x14 ^ a6;
+    const Slice x46 = x45 & a4;
+    const Slice x47 = x44 ^ x46;
+    const Slice x48 = x47 & a2;
+    const Slice x49 = x42 ^ x48;
+    const Slice x50 = ~x32;
+    const Slice x51 = x50 & a6;
+    const Slice x52 = x11 ^ x51;
+    const Slice x53 = x2 | a6;
+    const Slice x54 = x53 & a5;
+    const Slice x55 = x52 ^ x54;
+    const Slice x56 = x50 ^ x15;
+    const Slice x57 = x56 | a5;
+    const Slice x58 = x57 & a4;
+    const Slice x59 = x55 ^ x58;
+    const Slice x60 = x32 & a6;
+    const Slice x61 = x1 ^ x60;
+    const Slice x62 = x61 ^ x26;
+    const Slice x63 = x14 | a6;
+    const Slice x64 = ~x3;
+    const Slice x65 = x64 & a5;
+    const Slice x66 = x63 ^ x65;
+    const Slice x67 = x66 & a4;
+    const Slice x68 = x62 ^ x67;
+    const Slice x69 = x68 & a2;
+    const Slice x70 = x59 ^ x69;
+    const Slice x71 = x36 ^ x12;
+    const Slice x72 = x10 & a5;
+    const Slice x73 = x71 ^ x72;
+    const Slice x74 = x11 & a5;
+    const Slice x75 = x64 ^ x74;
+    const Slice x76 = x75 & a4;
+    const Slice x77 = x73 ^ x76;
+    const Slice x78 = x21 | a6;
+    const Slice x79 = x36 ^ x3;
+    const Slice x80 = x79 & a5;
+    const Slice x81 = x78 ^ x80;
+    const Slice x82 = x6 & a4;
+    const Slice x83 = x81 ^ x82;
+    const Slice x84 = x83 & a2;
+    const Slice x85 = x77 ^ x84;
+    out1 ^= x31;
+    out2 ^= x49;
+    out3 ^= x70;
+    out4 ^= x85;
+}
+
+/**
+ * Gate-level form of S-box 4 (75 gates). Every argument carries one input
+ * bit for all lanes; the four output bits are XORed into out1..out4.
+ */
+template <typename Slice>
+static inline void sbox4(const Slice a1, const Slice a2, const Slice a3, const Slice a4, const Slice a5, const Slice a6,
+    Slice& out1, Slice& out2, Slice& out3, Slice& out4)
+{
+    const Slice x1 = a5 & ~a3;
+    const Slice x2 = x1 ^ a1;
+    const Slice x3 = ~a5;
+    const Slice x4 = x3 & a3;
+    const Slice x5 = ~a1;
+    const Slice x6 = x4 | x5;
+    const Slice x7 = x6 & a4;
+    const Slice x8 = x2 ^ x7;
+    const Slice x9 = a5 | a3;
+    const Slice x10 = x1 & a1;
+    const Slice x11 = x9 ^ x10;
+    const Slice x12 = x3 ^ a3;
+    const Slice x13 = x12 & a1;
+    const Slice x14 = a5 ^ x13;
+    const Slice x15 = x14 & a4;
+    const Slice x16 = x11 ^ x15;
+    const Slice x17 = x16 & a2;
+    const Slice x18 = x8 ^ x17;
+    const Slice x19 = x12 ^ x10;
+    const Slice x20 = ~x4;
+    const Slice x21 = x20 & a1;
+    const Slice x22 = x3 ^ x21;
+    const Slice x23 = x22 & a4;
+    const Slice x24 = x19 ^ x23;
+    const Slice x25 = ~x1;
+    const Slice x26 = x25 | a1;
+    const Slice x27 = ~x12;
+    const Slice x28 = x27 & a4;
+    const Slice x29 = x26 ^ x28;
+    const Slice x30 = x29 & a2;
+    const Slice x31 = x24 ^ x30;
+    const Slice x32 = x31 & a6;
+    const Slice x33 = x18 ^ x32;
+    const Slice x34 = x25 & a1;
+    const Slice x35 = x20 ^ x34;
+    const Slice x36 = a5 & a4;
+    const Slice x37 = x35 ^ x36;
+    const Slice x38 = ~a3;
+    const Slice x39 = a3 ^ x13;
+    const Slice x40 = x39 & a4;
+    const Slice x41 = x38 ^ x40;
+    const Slice x42 = x41 & a2;
+    const Slice x43 = x37 ^ x42;
+    const Slice x44 = ~x31;
+    const Slice x45 = x44 & a6;
+    const Slice x46 = x43 ^ x45;
+    const Slice x47 = x1 | a1;
+    const Slice x48 = x47 & a4;
+    const Slice x49 = x19 ^ x48;
+    const Slice x50 = ~x34;
+    const Slice x51 = x50 ^ x40;
+    const Slice x52 = x51 & a2;
+    const Slice x53 = x49 ^ x52;
+    const Slice x54 = ~x14;
+    const Slice x55 = x3 | x38;
+    const Slice x56 = x55 ^ x34;
+    const Slice x57 = x56 & a4;
+    const Slice x58 = x54 ^ x57;
+    const Slice x59 = x4 & a1;
+    const Slice x60 = x12 ^ x59;
+    const Slice x61 = x60 ^ x28;
+    const Slice x62 = x61 & a2;
+    const Slice x63 = x58 ^ x62;
+    const Slice x64 = x63 & a6;
+    const Slice x65 = x53 ^ x64;
+    const Slice x66 = x38 ^ x21;
+    const Slice x67 = x3 & a4;
+    const Slice x68 = x66 ^ x67;
+    const Slice x69 = x27 | a1;
+    const Slice x70 = x69 ^ x15;
+    const Slice x71 = x70 & a2;
+    const Slice x72 = x68 ^ x71;
+    const Slice x73 = ~x63;
+    const Slice x74 = x73 & a6;
+    const Slice x75 = x72 ^ x74;
+    out1 ^= x33;
+    out2 ^= x46;
+    out3 ^= x65;
+    out4 ^= x75;
+}
+
+/**
+ * Gate-level form of S-box 5 (95 gates). Every argument carries one input
+ * bit for all lanes; the four output bits are XORed into out1..out4.
+ */
+template <typename Slice>
+static inline void sbox5(const Slice a1, const Slice a2, const Slice a3, const Slice a4, const Slice a5, const Slice a6,
+    Slice& out1, Slice& out2, Slice& out3, Slice& out4)
+{
+    const Slice x1 = a6 & ~a4;
+    const Slice x2 = a6 | a4;
+    const Slice x3 = x2 & a3;
+    const Slice x4 = x1 ^ x3;
+    const Slice x5 = ~a4;
+    const Slice x6 = a6 | x5;
+    const Slice x7 = a6 & a3;
+    const Slice x8 = x6 ^ x7;
+    const Slice x9 = x8 & a2;
+    const Slice x10 = x4 ^ x9;
+    const Slice x11 = ~a6;
+    const Slice x12 = x11 ^ a4;
+    const Slice x13 = ~x6;
+    const Slice x14 = x13 & a3;
+    const Slice x15 = x12 ^ x14;
+    const Slice x16 = a4 ^ x7;
+    const Slice x17 = x16 & a2;
+    const Slice x18 = x15 ^ x17;
+    const Slice x19 = x18 & a5;
+    const Slice x20 = x10 ^ x19;
+    const Slice x21 = a6 & a4;
+    const Slice x22 = x11 & a3;
+    const Slice x23 = x21 ^ x22;
+    const Slice x24 = ~x12;
+    const Slice x25 = x24 & a3;
+    const Slice x26 = x13 ^ x25;
+    const Slice x27 = x26 & a2;
+    const Slice x28 = x23 ^ x27;
+    const Slice x29 = x11 ^ x25;
+    const Slice x30 = x2 & a2;
+    const Slice x31 = x29 ^ x30;
+    const Slice x32 = x31 & a5;
+    const Slice x33 = x28 ^ x32;
+    const Slice x34 = x33 & a1;
+    const Slice x35 = x20 ^ x34;
+    const Slice x36 = ~x1;
+    const Slice x37 = x36 & a3;
+    const Slice x38 = x24 ^ x37;
+    const Slice x39 = x1 & a3;
+    const Slice x40 = a4 ^ x39;
+    const Slice x41 = x40 & a2;
+    const Slice x42 = x38 ^ x41;
+    const Slice x43 = ~x39;
+    const Slice x44 = x43 & a5;
+    const Slice x45 = x42 ^ x44;
+    const Slice x46 = ~x2;
+    const Slice x47 = x46 & a3;
+    const Slice x48 = x36 ^ x47;
+    const Slice x49 = ~a2;
+    const Slice x50 = x48 | x49;
+    const Slice x51 = a4 & a3;
+    const Slice x52 = x2 ^ x51;
+    const Slice x53 = x52 & a5;
+    const Slice x54 = x50 ^ x53;
+    const Slice x55 = x54 & a1;
+    const Slice x56 = x45 ^ x55;
+    const Slice x57 = x6 ^ x3;
+    const Slice x58 = ~x21;
+    const Slice x59 = x58 ^ x14;
+    const Slice x60 = x59 & a2;
+    const Slice x61 = x57 ^ x60;
+    const Slice x62 = x6 & a3;
+    const Slice x63 = x12 ^ x62;
+    const Slice x64 = x12 ^ x22;
+    const Slice x65 = x64 & a2;
+    const Slice x66 = x63 ^ x65;
+    const Slice x67 = x66 & a5;
+    const Slice x68 = x61 ^ x67;
+    const Slice x69 = x12 ^ x47;
+    const Slice x70 = ~x63;
+    const Slice x71 = x70 & a2;
+    const Slice x72 = x69 ^ x71;
+    const Slice x73 = x58 ^ x7;
+    const Slice x74 = x73 & a2;
+    const Slice x75 = x70 ^ x74;
+    const Slice x76 = x75 & a5;
+    const Slice x77 = x72 ^ x76;
+    const Slice x78 = x77 & a1;
+    const Slice x79 = x68 ^ x78;
+    const Slice x80 = x37 ^ x30;
+    const Slice x81 = ~x69;
+    const Slice x82 = x36 ^ a3;
+    const Slice x83 = x82 & a2;
+    const Slice x84 = x81 ^ x83;
+    const Slice x85 = x84 & a5;
+    const Slice x86 = x80 ^ x85;
+    const Slice x87 = x12 & ~a3;
+    const Slice x88 = x87 & a2;
+    const Slice x89 = x38 ^ x88;
+    const Slice x90 = a4 ^ x14;
+    const Slice x91 = x90 ^ x65;
+    const Slice x92 = x91 & a5;
+    const Slice x93 = x89 ^ x92;
+    const Slice x94 = x93 & a1;
+    const Slice x95 = x86 ^ x94;
+    out1 ^= x35;
+    out2 ^= x56;
+    out3 ^= x79;
+    out4 ^= x95;
+}
+
+/**
+ * Gate-level form of S-box 6 (85 gates). Every argument carries one input
+ * bit for all lanes; the four output bits are XORed into out1..out4.
+ */
+template <typename Slice>
+static inline void sbox6(const Slice a1, const Slice a2, const Slice a3, const Slice a4, const Slice a5, const Slice a6,
+    Slice& out1, Slice& out2, Slice& out3, Slice& out4)
+{
+    const Slice x1 = ~a2;
+    const Slice x2 = a6 & a1;
+    const Slice x3 = x1 ^ x2;
+    const Slice x4 = ~a6;
+    const Slice x5 = x4 & ~a1;
+    const Slice x6 = x5 & a5;
+    const Slice x7 = x3 ^ x6;
+    const Slice x8 = a6 & ~a2;
+    const Slice x9 = x8 & a1;
+    const Slice x10 = a6 ^ x9;
+    const Slice x11 = x10 | a5;
+    const Slice x12 = x11 & a4;
+    const Slice x13 = x7 ^ x12;
+    const Slice x14 = a6 ^ a2;
+    const Slice x15 = ~x8;
+    const Slice x16 = x15 & a1;
+    const Slice x17 = x14 ^ x16;
+    const Slice x18 = a6 ^ x16;
+    const Slice x19 = x18 & a5;
+    const Slice x20 = x17 ^ x19;
+    const Slice x21 = a6 & a2;
+    const Slice x22 = x21 & a1;
+    const Slice x23 = x15 ^ x22;
+    const Slice x24 = x4 & a5;
+    const Slice x25 = x23 ^ x24;
+    const Slice x26 = x25 & a4;
+    const Slice x27 = x20 ^ x26;
+    const Slice x28 = x27 & a3;
+    const Slice x29 = x13 ^ x28;
+    const Slice x30 = ~x14;
+    const Slice x31 = x30 ^ a1;
+    const Slice x32 = x31 ^ a5;
+    const Slice x33 = x30 & a1;
+    const Slice x34 = x21 ^ x33;
+    const Slice x35 = x34 & a5;
+    const Slice x36 = x1 ^ x35;
+    const Slice x37 = x36 & a4;
+    const Slice x38 = x32 ^ x37;
+    const Slice x39 = a6 | a2;
+    const Slice x40 = ~a1;
+    const Slice x41 = x39 | x40;
+    const Slice x42 = ~x39;
+    const Slice x43 = x42 | x40;
+    const Slice x44 = x43 & a5;
+    const Slice x45 = x41 ^ x44;
+    const Slice x46 = x40 & a5;
+    const Slice x47 = x22 ^ x46;
+    const Slice x48 = x47 & a4;
+    const Slice x49 = x45 ^ x48;
+    const Slice x50 = x49 & a3;
+    const Slice x51 = x38 ^ x50;
+    const Slice x52 = x14 & a1;
+    const Slice x53 = a6 ^ x52;
+    const Slice x54 = x21 ^ a1;
+    const Slice x55 = x54 & a5;
+    const Slice x56 = x53 ^ x55;
+    const Slice x57 = x39 & a1;
+    const Slice x58 = x30 ^ x57;
+    const Slice x59 = ~a5;
+    const Slice x60 = x58 | x59;
+    const Slice x61 = x60 & a4;
+    const Slice x62 = x56 ^ x61;
+    const Slice x63 = a2 ^ x33;
+    const Slice x64 = x1 ^ x16;
+    const Slice x65 = x64 & a5;
+    const Slice x66 = x63 ^ x65;
+    const Slice x67 = x66 & a3;
+    const Slice x68 = x62 ^ x67;
+    const Slice x69 = x16 ^ a5;
+    const Slice x70 = a2 ^ x22;
+    const Slice x71 = x8 | a1;
+    const Slice x72 = x71 & a5;
+    const Slice x73 = x70 ^ x72;
+    const Slice x74 = x73 & a4;
+    const Slice x75 = x69 ^ x74;
+    const Slice x76 = ~x70;
+    const Slice x77 = a1 & a5;
+    const Slice x78 = x76 ^ x77;
+    const Slice x79 = x4 & a1;
+    const Slice x80 = x42 ^ x79;
+    const Slice x81 = x80 ^ x6;
+    const Slice x82 = x81 & a4;
+    const Slice x83 = x78 ^ x82;
+    const Slice x84 = x83 & a3;
+    const Slice x85 = x75 ^ x84;
+    out1 ^= x29;
+    out2 ^= x51;
+    out3 ^= x68;
+    out4 ^= x85;
+}
+
+/**
+ * Gate-level form of S-box 7 (85 gates). Every argument carries one input
+ * bit for all lanes; the four output bits are XORed into out1..out4.
+ */
+template <typename Slice>
+static inline void sbox7(const Slice a1, const Slice a2, const Slice a3, const Slice a4, const Slice a5, const Slice a6,
+    Slice& out1, Slice& out2, Slice& out3, Slice& out4)
+{
+    const Slice x1 = a6 & ~a1;
+    const Slice x2 = ~a6;
+    const Slice x3 = ~a1;
+    const Slice x4 = x2 | x3;
+    const Slice x5 = x4 & a3;
+    const Slice x6 = x1 ^ x5;
+    const Slice x7 = a6 | x3;
+    const Slice x8 = a1 & a3;
+    const Slice x9 = x7 ^ x8;
+    const Slice x10 = x9 & a5;
+    const Slice x11 = x6 ^ x10;
+    const Slice x12 = ~x4;
+    const Slice x13 = x2 & ~a1;
+    const Slice x14 = x13 & a3;
+    const Slice x15 = x12 ^ x14;
+    const Slice x16 = x15 & a5;
+    const Slice x17 = a1 ^ x16;
+    const Slice x18 = x17 & a4;
+    const Slice x19 = x11 ^ x18;
+    const Slice x20 = a1 ^ x14;
+    const Slice x21 = x8 & a5;
+    const Slice x22 = x20 ^ x21;
+    const Slice x23 = ~x20;
+    const Slice x24 = a1 & a5;
+    const Slice x25 = x23 ^ x24;
+    const Slice x26 = x25 & a4;
+    const Slice x27 = x22 ^ x26;
+    const Slice x28 = x27 & a2;
+    const Slice x29 = x19 ^ x28;
+    const Slice x30 = x9 ^ a5;
+    const Slice x31 = a6 ^ a1;
+    const Slice x32 = x31 & a3;
+    const Slice x33 = x32 & a5;
+    const Slice x34 = x3 ^ x33;
+    const Slice x35 = x34 & a4;
+    const Slice x36 = x30 ^ x35;
+    const Slice x37 = ~x31;
+    const Slice x38 = x37 ^ x5;
+    const Slice x39 = x4 ^ x8;
+    const Slice x40 = x1 & a5;
+    const Slice x41 = x39 ^ x40;
+    const Slice x42 = x41 & a4;
+    const Slice x43 = x38 ^ x42;
+    const Slice x44 = x43 & a2;
+    const Slice x45 = x36 ^ x44;
+    const Slice x46 = x37 & a3;
+    const Slice x47 = x12 ^ x46;
+    const Slice x48 = ~x7;
+    const Slice x49 = x48 & a3;
+    const Slice x50 = x13 ^ x49;
+    const Slice x51 = x50 & a5;
+    const Slice x52 = x47 ^ x51;
+    const Slice x53 = ~x1;
+    const Slice x54 = ~a3;
+    const Slice x55 = x53 | x54;
+    const Slice x56 = x1 & a3;
+    const Slice x57 = x2 ^ x56;
+    const Slice x58 = x57 & a5;
+    const Slice x59 = x55 ^ x58;
+    const Slice x60 = x59 & a4;
+    const Slice x61 = x52 ^ x60;
+    const Slice x62 = ~x49;
+    const Slice x63 = x62 | a5;
+    const Slice x64 = a1 ^ x56;
+    const Slice x65 = x37 & a5;
+    const Slice x66 = x64 ^ x65;
+    const Slice x67 = x66 & a4;
+    const Slice x68 = x63 ^ x67;
+    const Slice x69 = x68 & a2;
+    const Slice x70 = x61 ^ x69;
+    const Slice x71 = x31 ^ a3;
+    const Slice x72 = x71 ^ a5;
+    const Slice x73 = x12 | a3;
+    const Slice x74 = x73 | a5;
+    const Slice x75 = x74 & a4;
+    const Slice x76 = x72 ^ x75;
+    const Slice x77 = ~x5;
+    const Slice x78 = x12 & a5;
+    const Slice x79 = x77 ^ x78;
+    const Slice x80 = a6 & a5;
+    const Slice x81 = x1 ^ x80;
+    const Slice x82 = x81 & a4;
+    const Slice x83 = x79 ^ x82;
+    const Slice x84 = x83 & a2;
+    const Slice x85 = x76 ^ x84;
+    out1 ^= x29;
+    out2 ^= x45;
+    out3 ^= x70;
+    out4 ^= x85;
+}
+
+/**
+ * Gate-level form of S-box 8 (87 gates). Every argument carries one input
+ * bit for all lanes; the four output bits are XORed into out1..out4.
+ */
+template <typename Slice>
+static inline void sbox8(const Slice a1, const Slice a2, const Slice a3, const Slice a4, const Slice a5, const Slice a6,
+    Slice& out1, Slice& out2, Slice& out3, Slice& out4)
+{
+    const Slice x1 = ~a3;
+    const Slice x2 = a4 | x1;
+    const Slice x3 = x2 ^ a5;
+    const Slice x4 = ~a4;
+    const Slice x5 = x4 | a3;
+    const Slice x6 = a4 & a5;
+    const Slice x7 = x5 ^ x6;
+    const Slice x8 = x7 & a6;
+    const Slice x9 = x3 ^ x8;
+    const Slice x10 = ~x5;
+    const Slice x11 = x4 & a5;
+    const Slice x12 = x10 ^ x11;
+    const Slice x13 = x5 ^ a5;
+    const Slice x14 = x13 & a6;
+    const Slice x15 = x12 ^ x14;
+    const Slice x16 = x15 & a2;
+    const Slice x17 = x9 ^ x16;
+    const Slice x18 = x4 | x1;
+    const Slice x19 = a4 ^ a3;
+    const Slice x20 = x19 & a5;
+    const Slice x21 = x18 ^ x20;
+    const Slice x22 = x2 ^ x11;
+    const Slice x23 = x22 & a6;
+    const Slice x24 = x21 ^ x23;
+    const Slice x25 = ~x18;
+    const Slice x26 = a4 | a3;
+    const Slice x27 = x26 ^ x20;
+    const Slice x28 = x27 & a6;
+    const Slice x29 = x25 ^ x28;
+    const Slice x30 = x29 & a2;
+    const Slice x31 = x24 ^ x30;
+    const Slice x32 = x31 & a1;
+    const Slice x33 = x17 ^ x32;
+    const Slice x34 = x1 & a5;
+    const Slice x35 = x4 ^ x34;
+    const Slice x36 = x35 ^ a6;
+    const Slice x37 = ~x19;
+    const Slice x38 = x37 ^ x11;
+    const Slice x39 = x38 & a2;
+    const Slice x40 = x36 ^ x39;
+    const Slice x41 = a3 & a5;
+    const Slice x42 = x26 ^ x41;
+    const Slice x43 = x10 ^ x34;
+    const Slice x44 = x43 & a6;
+    const Slice x45 = x42 ^ x44;
+    const Slice x46 = x26 ^ x11;
+    const Slice x47 = x25 & a6;
+    const Slice x48 = x46 ^ x47;
+    const Slice x49 = x48 & a2;
+    const Slice x50 = x45 ^ x49;
+    const Slice x51 = x50 & a1;
+    const Slice x52 = x40 ^ x51;
+    const Slice x53 = x37 & a5;
+    const Slice x54 = a3 ^ x53;
+    const Slice x55 = ~a6;
+    const Slice x56 = x46 | x55;
+    const Slice x57 = x56 & a2;
+    const Slice x58 = x54 ^ x57;
+    const Slice x59 = x4 ^ x53;
+    const Slice x60 = a4 | a5;
+    const Slice x61 = x60 & a6;
+    const Slice x62 = x59 ^ x61;
+    const Slice x63 = x20 & a6;
+    const Slice x64 = x34 ^ x63;
+    const Slice x65 = x64 & a2;
+    const Slice x66 = x62 ^ x65;
+    const Slice x67 = x66 & a1;
+    const Slice x68 = x58 ^ x67;
+    const Slice x69 = x2 & a5;
+    const Slice x70 = x10 ^ x69;
+    const Slice x71 = x70 & a6;
+    const Slice x72 = x38 ^ x71;
+    const Slice x73 = ~x6;
+    const Slice x74 = a3 ^ a5;
+    const Slice x75 = x74 & a6;
+    const Slice x76 = x73 ^ x75;
+    const Slice x77 = x76 & a2;
+    const Slice x78 = x72 ^ x77;
+    const Slice x79 = a3 | a5;
+    const Slice x80 = x21 & a6;
+    const Slice x81 = x79 ^ x80;
+    const Slice x82 = x19 & ~a5;
+    const Slice x83 = x82 ^ x44;
+    const Slice x84 = x83 & a2;
+    const Slice x85 = x81 ^ x84;
+    const Slice x86 = x85 & a1;
+    const Slice x87 = x78 ^ x86;
+    out1 ^= x33;
+    out2 ^= x52;
+    out3 ^= x68;
+    out4 ^= x87;
+}
+
+#endif	/* BITSLICESBOXES_H */
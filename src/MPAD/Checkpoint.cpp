@@ -0,0 +1,313 @@
+/**
+ * File: Checkpoint.cpp
+ * 
+ * Source code file for the Checkpoint class.
+ * 
+ * @version 0.1
+ */
+
+// include standard libraries.
+#include <stdio.h>
+#include <stdlib.h>
+
+// include the string library for the strcmp function.
+#include <string.h>
+
+// include the time library for the clock_gettime function.
+#include <time.h>
+
+// include the errno library for the ETIMEDOUT constant.
+#include <errno.h>
+
+// include the fsync and unlink functions.
+#include <unistd.h>
+
+// include the stream related libraries.
+#include <sstream>
+
+// include the signature of the class.
+#include "Checkpoint.h"
+
+// include the Logger class signature.
+#include "Logger.h"
+
+// include the hex encoding of the string pair.
+#include "AlgorithmInterface.h"
+
+/**
+ * Path of the checkpoint file.
+ */
+const char* Checkpoint::checkpointFilePath = "mpad.checkpoint";
+
+/**
+ * Constructor method of the class.
+ * 
+ * @param pattern The known and the free bits of the keys searched.
+ * @param firstCandidate First candidate of the search.
+ * @param lastCandidate End of the search (the candidate after the last one).
+ */
+Checkpoint::Checkpoint(const KeyPattern& pattern, uint64_t firstCandidate, uint64_t lastCandidate)
+    : pattern(pattern)
+{
+    this->firstCandidate = firstCandidate;
+    this->lastCandidate = lastCandidate;
+    this->searchedUpTo = firstCandidate;
+    this->control = NULL;
+    this->intervalSeconds = 0;
+    this->writerRunning = false;
+    this->stopping = false;
+    pthread_mutex_init(&this->mutex, NULL);
+    pthread_cond_init(&this->condition, NULL);
+}
+
+/**
+ * Destructor method of the class; stops the writer thread.
+ */
+Checkpoint::~Checkpoint()
+{
+    if (this->writerRunning) {
+        this->stop();
+    }
+    pthread_cond_destroy(&this->condition);
+    pthread_mutex_destroy(&this->mutex);
+}
+
+/**
+ * Reads the checkpoint file, if there is one of the same key space. A file
+ * of another key space, or one that can't be read, is ignored (and replaced
+ * by the first checkpoint of this search).
+ * 
+ * @return Whether the search can resume from it.
+ */
+bool Checkpoint::load()
+{
+    FILE* file = fopen(Checkpoint::checkpointFilePath, "r");
+    if (NULL == file) {
+        return false;
+    }
+    
+    // one "name value" pair per line, after the format line.
+    char name[32], value[512];
+    std::string rawHex, encryptedHex;
+    unsigned long long knownKey = 0, unknownMask = 0, first = 0, last = 0, searched = 0;
+    int version = 0, fields = 0;
+    while (2 == fscanf(file, "%31s %511s", name, value)) {
+        if (0 == strcmp(name, "MPAD-CHECKPOINT")) {
+            version = atoi(value);
+        } else if (0 == strcmp(name, "raw")) {
+            rawHex = value;
+        } else if (0 == strcmp(name, "encrypted")) {
+            encryptedHex = value;
+        } else if (0 == strcmp(name, "knownKey")) {
+            knownKey = strtoull(value, NULL, 16);
+        } else if (0 == strcmp(name, "unknownMask")) {
+            unknownMask = strtoull(value, NULL, 16);
+        } else if (0 == strcmp(name, "first")) {
+            first = strtoull(value, NULL, 10);
+        } else if (0 == strcmp(name, "last")) {
+            last = strtoull(value, NULL, 10);
+        } else if (0 == strcmp(name, "searched")) {
+            searched = strtoull(value, NULL, 10);
+        } else {
+            continue;
+        }
+        fields++;
+    }
+    fclose(file);
+    
+    std::string rawString, encryptedString;
+    if (1 != version || 8 != fields
+        || ! AlgorithmInterface::decodeHex(rawHex.c_str(), rawString) || ! AlgorithmInterface::decodeHex(encryptedHex.c_str(), encryptedString)) {
+        Logger::writeToLogFile("ERROR: The checkpoint file can't be read; the search starts over!");
+        return false;
+    }
+    if (knownKey != this->pattern.getKnownKey() || unknownMask != this->pattern.getUnknownMask()
+        || first != this->firstCandidate || last != this->lastCandidate || searched < first || searched > last) {
+        Logger::writeToLogFile("The checkpoint file is of another key space; the search starts over!");
+        return false;
+    }
+    
+    this->rawString = rawString;
+    this->encryptedString = encryptedString;
+    this->searchedUpTo = searched;
+    return true;
+}
+
+/**
+ * Sets the raw/encrypted string pair of a new search.
+ */
+void Checkpoint::setTarget(std::string rawString, std::string encryptedString)
+{
+    this->rawString = rawString;
+    this->encryptedString = encryptedString;
+}
+
+/**
+ * Returns the raw string of the search.
+ */
+std::string Checkpoint::getRawString()
+{
+    return this->rawString;
+}
+
+/**
+ * Returns the encrypted string of the search.
+ */
+std::string Checkpoint::getEncryptedString()
+{
+    return this->encryptedString;
+}
+
+/**
+ * Returns the candidate below which the key space has been searched.
+ */
+uint64_t Checkpoint::getSearchedUpTo()
+{
+    return this->searchedUpTo;
+}
+
+/**
+ * Writes the checkpoint file atomically: into a temporary file next to it,
+ * which is synced to the disk and then renamed over it, so that a crash
+ * leaves either the old checkpoint or the new one.
+ * 
+ * @param searchedUpTo The candidate below which the key space has been
+ * searched.
+ * @return Whether the file was written.
+ */
+bool Checkpoint::write(uint64_t searchedUpTo)
+{
+    std::string temporaryPath = std::string(Checkpoint::checkpointFilePath) + ".tmp";
+    FILE* file = fopen(temporaryPath.c_str(), "w");
+    if (NULL == file) {
+        Logger::writeToLogFile("ERROR: Can't write the checkpoint file!");
+        return false;
+    }
+    
+    std::stringstream content;
+    content << "MPAD-CHECKPOINT 1\n"
+        << "raw " << AlgorithmInterface::encodeHex(this->rawString) << "\n"
+        << "encrypted " << AlgorithmInterface::encodeHex(this->encryptedString) << "\n"
+        << std::hex << "knownKey " << this->pattern.getKnownKey() << "\n"
+        << "unknownMask " << this->pattern.getUnknownMask() << "\n"
+        << std::dec << "first " << this->firstCandidate << "\n"
+        << "last " << this->lastCandidate << "\n"
+        << "searched " << searchedUpTo << "\n";
+    
+    bool written = (content.str().size() == fwrite(content.str().data(), 1, content.str().size(), file));
+    written = (0 == fflush(file)) && written;
+    written = (0 == fsync(fileno(file))) && written;
+    written = (0 == fclose(file)) && written;
+    if (! written || 0 != rename(temporaryPath.c_str(), Checkpoint::checkpointFilePath)) {
+        Logger::writeToLogFile("ERROR: Can't write the checkpoint file!");
+        unlink(temporaryPath.c_str());
+        return false;
+    }
+    
+    this->searchedUpTo = searchedUpTo;
+    return true;
+}
+
+/**
+ * Starts a thread that writes the progress in the control block to the
+ * checkpoint file every intervalSeconds seconds. The workers only publish
+ * their low-water marks; reading and writing them is left to this thread.
+ * 
+ * @param control The control block of the search.
+ * @param intervalSeconds Seconds between two writes; 0 turns checkpointing
+ * off.
+ */
+void Checkpoint::start(ControlBlock* control, int intervalSeconds)
+{
+    this->control = control;
+    this->intervalSeconds = intervalSeconds;
+    if (0 >= intervalSeconds) {
+        return;
+    }
+    
+    // the string pair of a new search is on the disk from the start.
+    this->write(this->searchedUpTo);
+    
+    this->stopping = false;
+    this->writerRunning = (0 == pthread_create(&this->writer, NULL, Checkpoint::writerMain, this));
+    if (! this->writerRunning) {
+        Logger::writeToLogFile("ERROR: Can't create the checkpoint thread!");
+    }
+}
+
+/**
+ * Stops the writer thread and leaves the checkpoint file the way the search
+ * ended: removed if the key was found or the key space is exhausted, up to
+ * date otherwise (a search that lost a child that couldn't be replaced is
+ * resumed from that child's chunk).
+ */
+void Checkpoint::stop()
+{
+    if (this->writerRunning) {
+        pthread_mutex_lock(&this->mutex);
+        this->stopping = true;
+        pthread_cond_signal(&this->condition);
+        pthread_mutex_unlock(&this->mutex);
+        
+        pthread_join(this->writer, NULL);
+        this->writerRunning = false;
+    }
+    if (NULL == this->control || 0 >= this->intervalSeconds) {
+        return;
+    }
+    
+    this->finish(this->control->isFound(), this->control->getSearchedUpTo());
+    this->control = NULL;
+}
+
+/**
+ * Leaves the checkpoint file the way a search ended: removed if the key was
+ * found or the key space is exhausted, up to date otherwise.
+ * 
+ * @param found Whether the key was found.
+ * @param searchedUpTo The candidate below which the key space has been
+ * searched.
+ */
+void Checkpoint::finish(bool found, uint64_t searchedUpTo)
+{
+    if (found || searchedUpTo >= this->lastCandidate) {
+        unlink(Checkpoint::checkpointFilePath);
+    } else {
+        this->write(searchedUpTo);
+    }
+}
+
+/**
+ * Entry point of the writer thread: writes the checkpoint whenever the
+ * search has moved on, until stop() is called.
+ * 
+ * @param checkpoint Pointer to the Checkpoint.
+ */
+void* Checkpoint::writerMain(void* checkpoint)
+{
+    Checkpoint* self = (Checkpoint*) checkpoint;
+    
+    pthread_mutex_lock(&self->mutex);
+    while (! self->stopping) {
+        struct timespec wakeUp;
+        clock_gettime(CLOCK_REALTIME, &wakeUp);
+        wakeUp.tv_sec += self->intervalSeconds;
+        while (! self->stopping && ETIMEDOUT != pthread_cond_timedwait(&self->condition, &self->mutex, &wakeUp)) {
+        }
+        if (self->stopping) {
+            break;
+        }
+        
+        // the file is written without the lock, so that stop() isn't kept
+        // waiting for the disk.
+        pthread_mutex_unlock(&self->mutex);
+        uint64_t searchedUpTo = self->control->getSearchedUpTo();
+        if (searchedUpTo != self->searchedUpTo) {
+            self->write(searchedUpTo);
+        }
+        pthread_mutex_lock(&self->mutex);
+    }
+    pthread_mutex_unlock(&self->mutex);
+    
+    return NULL;
+}
@@ -0,0 +1,179 @@
+/**
+ * File: Checkpoint.h
+ * 
+ * Header file for the Checkpoint class.
+ * 
+ * @version 0.1
+ */
+
+// make sure that the signature of the class is defined only once.
+#ifndef CHECKPOINT_H
+#define	CHECKPOINT_H
+
+// include the string library for the std::string class.
+#include <string>
+
+// include the fixed-width integer types.
+#include <stdint.h>
+
+// include the pthread library for the writer thread.
+#include <pthread.h>
+
+// include the KeyPattern class signature.
+#include "KeyPattern.h"
+
+// include the ControlBlock class signature.
+#include "ControlBlock.h"
+
+/**
+ * Signature of the Checkpoint class.
+ * 
+ * Checkpoint keeps the progress of a long search on disk, so that a search
+ * that is stopped (or crashes) goes on where it was when main_p is started
+ * again. Chunks are handed out in order and are short, so the searched part
+ * of [firstCandidate, lastCandidate) is one interval from firstCandidate on,
+ * give or take the chunks in flight; the checkpoint file records its end
+ * (see ControlBlock::getSearchedUpTo), together with the key space and the
+ * raw/encrypted string pair, which a restart must search for again.
+ * 
+ * The file is written by a thread of the main process every few seconds,
+ * never by the workers, and atomically: into a temporary file that is synced
+ * and then renamed over the checkpoint. Once the key is found or the key
+ * space is exhausted, the file is removed.
+ * 
+ * @since version 0.1
+ * @see MainProcess
+ * @see ControlBlock
+ */
+class Checkpoint
+{
+    // public attributes and methods of the class.
+    public:
+        
+        /**
+         * Path of the checkpoint file.
+         */
+        static const char* checkpointFilePath;
+        
+        /**
+         * Constructor method of the class.
+         * 
+         * @param pattern The known and the free bits of the keys searched.
+         * @param firstCandidate First candidate of the search.
+         * @param lastCandidate End of the search (the candidate after the
+         * last one).
+         */
+        Checkpoint(const KeyPattern& pattern, uint64_t firstCandidate, uint64_t lastCandidate);
+        
+        /**
+         * Destructor method of the class; stops the writer thread.
+         */
+        ~Checkpoint();
+        
+        /**
+         * Reads the checkpoint file, if there is one of the same key space.
+         * 
+         * @return Whether the search can resume from it.
+         */
+        bool load();
+        
+        /**
+         * Sets the raw/encrypted string pair of a new search.
+         */
+        void setTarget(std::string rawString, std::string encryptedString);
+        
+        /**
+         * Returns the raw string of the search.
+         */
+        std::string getRawString();
+        
+        /**
+         * Returns the encrypted string of the search.
+         */
+        std::string getEncryptedString();
+        
+        /**
+         * Returns the candidate below which the key space has been searched.
+         */
+        uint64_t getSearchedUpTo();
+        
+        /**
+         * Writes the checkpoint file atomically.
+         * 
+         * @param searchedUpTo The candidate below which the key space has
+         * been searched.
+         * @return Whether the file was written.
+         */
+        bool write(uint64_t searchedUpTo);
+        
+        /**
+         * Starts a thread that writes the progress in the control block to
+         * the checkpoint file every intervalSeconds seconds.
+         * 
+         * @param control The control block of the search.
+         * @param intervalSeconds Seconds between two writes; 0 turns
+         * checkpointing off.
+         */
+        void start(ControlBlock* control, int intervalSeconds);
+        
+        /**
+         * Stops the writer thread and leaves the checkpoint file the way the
+         * search ended: removed if the key was found or the key space is
+         * exhausted, up to date otherwise.
+         */
+        void stop();
+        
+        /**
+         * Leaves the checkpoint file the way a search ended, for a search
+         * that keeps track of its progress itself (see Coordinator).
+         * 
+         * @param found Whether the key was found.
+         * @param searchedUpTo The candidate below which the key space has
+         * been searched.
+         */
+        void finish(bool found, uint64_t searchedUpTo);
+    
+    // private attributes and methods of the class.
+    private:
+        
+        /**
+         * The key space and the string pair of the search.
+         */
+        KeyPattern pattern;
+        uint64_t firstCandidate;
+        uint64_t lastCandidate;
+        std::string rawString;
+        std::string encryptedString;
+        
+        /**
+         * The candidate below which the key space has been searched, as last
+         * read or written.
+         */
+        uint64_t searchedUpTo;
+        
+        /**
+         * The control block the writer thread reads, and the seconds between
+         * two writes.
+         */
+        ControlBlock* control;
+        int intervalSeconds;
+        
+        /**
+         * The writer thread, and what stop() wakes it up with.
+         */
+        pthread_t writer;
+        bool writerRunning;
+        bool stopping;
+        pthread_mutex_t mutex;
+        pthread_cond_t condition;
+        
+        /**
+         * Entry point of the writer thread.
+         * 
+         * @param checkpoint Pointer to the Checkpoint.
+         */
+        static void* writerMain(void* checkpoint);
+};
+
+// end of the class signature.
+#endif	/* CHECKPOINT_H */
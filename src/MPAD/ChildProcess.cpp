@@ -21,7 +21,14 @@
 
 // include the Logger class signature.
 #include "Logger.h"
-#include "AlgorithmDES.h"
+#include "AlgorithmRegistry.h"
+#include "KeyspaceScheduler.h"
+#include "ControlBlock.h"
+#include "Config.h"
+#include "TargetSet.h"
+#include "KeyList.h"
+#include "WordList.h"
+#include "AllocationCounter.h"
 #include <math.h>
 #include <vector>
 #include <sstream>
@@ -34,8 +41,45 @@
  */
 int main(int argc, char **argv)
 {
+    if (9 > argc) {
+        Logger::writeToLogFile("ERROR: Child process is started with missing arguments!");
+        exit(EXIT_FAILURE);
+    }
+    
+    // the raw and the encrypted strings are passed hex encoded, so that a NUL
+    // byte in them can't cut them short, or as "@<path>" of a target file.
+    std::string rawString, encryptedString;
+    if ('@' == argv[2][0]) {
+        if (! TargetSet::loadPair(argv[2] + 1, rawString, encryptedString)) {
+            Logger::writeToLogFile("ERROR: Child %s can't read the pair of its target file!", std::string(argv[1]));
+            exit(EXIT_FAILURE);
+        }
+    } else if (! AlgorithmInterface::decodeHex(argv[2], rawString) || ! AlgorithmInterface::decodeHex(argv[3], encryptedString)) {
+        Logger::writeToLogFile("ERROR: Child %s is given a malformed hex string!", std::string(argv[1]));
+        exit(EXIT_FAILURE);
+    }
+    
+    // the known key bits and the mask of the unknown ones come in hex.
+    KeyPattern pattern(strtoull(argv[5], NULL, 16), strtoull(argv[6], NULL, 16));
+    
+    // a ninth argument names a key file, whose lines are the candidates, and
+    // a tenth one a word file, whose passwords are; "-" is none.
+    bool useKeys = (9 < argc && 0 != strcmp(argv[9], "-"));
+    KeyList keys;
+    if (useKeys && ! keys.open(argv[9])) {
+        Logger::writeToLogFile("ERROR: Child %s can't map its key file!", std::string(argv[1]));
+        exit(EXIT_FAILURE);
+    }
+    bool useWords = (10 < argc && 0 != strcmp(argv[10], "-"));
+    WordList words;
+    if (useWords && ! words.open(argv[10])) {
+        Logger::writeToLogFile("ERROR: Child %s can't map its word file!", std::string(argv[1]));
+        exit(EXIT_FAILURE);
+    }
+    
     // instantiate the ChildProcess class.
-    new ChildProcess(std::string(argv[1]), std::string(argv[2]), std::string(argv[3]), atoi(argv[4]), atoi(argv[5]), atoi(argv[6]), atoi(argv[7]));
+    ChildProcess child(std::string(argv[1]), rawString, encryptedString, atoi(argv[4]), pattern, std::string(argv[7]), atoi(argv[8]), useKeys ? &keys : NULL,
+        useWords ? &words : NULL);
     //new ChildProcess(std::string("child process"), std::string("This is the raw string!"), std::string("T??*LY???pqXWSyJ??B^P???DE??????i?g?c!N2??ke??gkb???!??p?'P"), atoi("1"), atoi("56"), atoi("0"));
     
     // terminate the application.
@@ -51,40 +95,111 @@ int main(int argc, char **argv)
  * @param repeatCount The number of times the child process will repeat
  * the sleep/wake-up operations.
  */
-ChildProcess::ChildProcess(std::string name, std::string rawString, std::string encryptedString, int algorithmId, int keyLength, int partitionNumber, int partitionSize)
+ChildProcess::ChildProcess(std::string name, std::string rawString, std::string encryptedString, int algorithmId, const KeyPattern& pattern, std::string controlName, int childIndex,
+    const KeyList* keys, const WordList* words)
 {
     // mark the name of the process as an instance property.
     this->name = name;
+    if (1 == Config::readValue("trace", "main")) {
+        Logger::enableTrace();
+    }
     Logger::writeToLogFile("Child %s is created!", name);
     
-    uint64_t start = partitionNumber * ((uint64_t) pow(2, keyLength) / pow(2, partitionSize));
-    uint64_t end = start + ((uint64_t) pow(2, keyLength) / pow(2, partitionSize)) - 1;
-    std::string decryptedString;
+    // the key space, the progress and the found key are shared with the main
+    // process and the other children through the control block the main
+    // process has created.
+    ControlBlock* control = ControlBlock::open(controlName);
+    if (NULL == control) {
+        Logger::writeToLogFile("ERROR: Child %s can't open the shared control block!", name);
+        
+        exit(EXIT_FAILURE);
+    }
+    if (0 > childIndex || childIndex >= control->getNumberOfWorkers()) {
+        Logger::writeToLogFile("ERROR: Child %s is given an invalid index!", name);
+        
+        exit(EXIT_FAILURE);
+    }
+    WorkerStatus* status = control->getWorker(childIndex);
+    
+    // the engine is the one of the given id; its search is bound once, here.
+    // an engine that polls the cancel flag while it searches a chunk stops
+    // shortly after another child has found the key.
+    const AlgorithmEngine* engine = AlgorithmRegistry::find(algorithmId);
+    if (NULL == engine || (! engine->candidateLists && (NULL != keys || NULL != words))) {
+        Logger::writeToLogFile("ERROR: Child %s is given an engine that can't run this search!", name);
+        
+        exit(EXIT_FAILURE);
+    }
+    AlgorithmInterface* algorithm = engine->create();
+    std::string description;
+    if (! engine->prepare(algorithm, control->getCancelFlag(), description)) {
+        Logger::writeToLogFile("ERROR: The self-test of the engine of %s failed!", name);
+        
+        exit(EXIT_FAILURE);
+    }
+    AlgorithmChunkSearch searchChunk = engine->searchChunk;
+    SearchJob job = { &rawString, &encryptedString, &pattern, keys, words };
+    
+    // log which engine and kernel the child runs.
+    std::stringstream engineMessage;
+    engineMessage << "Child %s uses the " << engine->name << " engine (" << description << ")!";
+    Logger::writeToLogFile(engineMessage.str(), name);
     
-    for (uint64_t i = start; i < end; i++) {
-        // -------------------------------------------------------------------------
-        // @todo
-        AlgorithmDES algoDES;
-        // create the key.
-        std::vector<unsigned char> key(56, '0');
-        if (0 < partitionNumber) {
-                key.at(partitionSize - partitionNumber) = '1';
+    // if this child takes the place of one that died, search the chunk it
+    // left unfinished first; then take chunks of the key space until it is
+    // exhausted or the search is cancelled. The scheduler publishes each
+    // chunk before it claims it, so that none is lost if this child dies.
+    KeyspaceScheduler scheduler(control->getKeyspace(), engine->batchWidth);
+    scheduler.setLowWaterMark(&status->lowWaterMark);
+    scheduler.setChunkRecord(&status->chunkFirst, &status->chunkLast);
+    uint64_t first = status->chunkFirst.load(), last = status->chunkLast.load(), foundCandidate;
+    bool unfinished = (first < last);
+    if (unfinished) {
+        Logger::writeToLogFile("Child %s resumes an unfinished chunk!", name);
+    }
+    // count the heap allocations of the searches after the first chunk,
+    // which should be none: the engine keeps its scratch buffers.
+    uint64_t chunks = 0, allocations = 0;
+    while (! control->isCancelled() && (unfinished || scheduler.nextChunk(first, last))) {
+        unfinished = false;
+        
+        uint64_t started = TraceEvent::now();
+        uint64_t allocated = AllocationCounter::getThreadAllocations();
+        bool found = searchChunk(algorithm, job, first, last, foundCandidate);
+        if (0 < chunks++) {
+            allocations += AllocationCounter::getThreadAllocations() - allocated;
         }
-        for (int j = 0; j < keyLength; j++) {
-            int bitValue = ((i >> j) & 1);
-            if (0 == bitValue) {
-                key.at(keyLength - j - 1) = '0';
-            } else {
-                key.at(keyLength - j - 1) = '1';
-            }
+        
+        // a search that sees the cancel flag gives up somewhere in the
+        // chunk, and its progress is unknown.
+        if (! found && control->isCancelled()) {
+            break;
         }
         
-        decryptedString = algoDES.decrypt(encryptedString, (const char *)key.data(), keyLength);
+        // publish the progress (a search that finds the key stops there);
+        // the speed is the one measured over the chunk before.
+        uint64_t keys = found ? foundCandidate + 1 - first : last - first;
+        Logger::writeTraceEvent(TRACE_CHUNK_DONE, childIndex, first, last, keys, TraceEvent::now() - started);
+        status->keysSearched.fetch_add(keys, std::memory_order_relaxed);
+        status->keysPerSecond.store(scheduler.getKeysPerSecond(), std::memory_order_relaxed);
+        status->chunkLast.store(0);
         
-        if (partitionNumber == 0 && rawString == decryptedString) {
-            Logger::writeToLogFile("The key is found! Key is: %s", (const char*) key.data());
+        if (found) {
+            Logger::writeToLogFile("Child %s has found the key!", name);
+            Logger::writeTraceEvent(TRACE_KEY_FOUND, childIndex, foundCandidate, foundCandidate + 1, 0, 0);
+            
+            // the main process reads the key from the control block.
+            control->reportFound(foundCandidate);
+            ControlBlock::close(control);
             
             exit(2);
         }
     }
+    
+    std::stringstream allocationMessage;
+    allocationMessage << "Child %s has searched " << chunks << " chunks with " << allocations << " heap allocations after the first!";
+    Logger::writeToLogFile(allocationMessage.str(), name);
+    
+    delete algorithm;
+    ControlBlock::close(control);
 }
@@ -15,6 +15,15 @@
 // include the string library for the std::string class.
 #include <string>
 
+// include the KeyPattern class signature.
+#include "KeyPattern.h"
+
+// include the KeyList class signature.
+#include "KeyList.h"
+
+// include the WordList class signature.
+#include "WordList.h"
+
 /**
  * Signature of the ChildProcess class.
  * 
@@ -33,8 +42,16 @@ class ChildProcess
          * 
          * @param name The name of the child process that is given by the main
          * process.
+         * @param pattern The known and the free bits of the keys searched.
+         * @param controlName Name of the shared memory segment that holds the
+         * control block (see ControlBlock).
+         * @param childIndex Index of the child's entry in the control block.
+         * @param keys The key list searched, or NULL to search the key
+         * pattern.
+         * @param words The word list searched, or NULL.
          */
-        ChildProcess(std::string name, std::string rawString, std::string encryptedString, int algorithmId, int keyLength, int partitionNumber, int partitionSize);
+        ChildProcess(std::string name, std::string rawString, std::string encryptedString, int algorithmId, const KeyPattern& pattern, std::string controlName, int childIndex,
+            const KeyList* keys, const WordList* words);
     
     // private attributes and methods of the class.
     private:
@@ -0,0 +1,243 @@
+/**
+ * File: CipherStream.cpp
+ * 
+ * Source code file for the CipherStream class.
+ * 
+ * @version 0.1
+ */
+
+// include the memory functions.
+#include <string.h>
+
+// include the signature of the class.
+#include "CipherStream.h"
+
+/**
+ * XORs a block into another one.
+ */
+static inline void xorBlock(unsigned char* block, const unsigned char* with)
+{
+    uint64_t a, b;
+    memcpy(&a, block, 8);
+    memcpy(&b, with, 8);
+    a ^= b;
+    memcpy(block, &a, 8);
+}
+
+/**
+ * Constructor method of the class.
+ * 
+ * @param mode ECB or CBC.
+ * @param decrypt Whether the stream decrypts instead of encrypts.
+ * @param key The 64-bit DES key.
+ * @param iv The initialization vector of CBC, as a big-endian 64-bit word;
+ * ECB doesn't use it.
+ */
+CipherStream::CipherStream(Mode mode, bool decrypt, uint64_t key, uint64_t iv)
+{
+    this->mode = mode;
+    this->decrypting = decrypt;
+    this->padding = true;
+    this->key = key;
+    this->core.setKey(key);
+    
+    // a kernel pass costs the same however few of its lanes are used; a
+    // quarter of them is about where it gets ahead of DESCore.
+    this->bulkBlocks = this->bulk.getLanes() / 4;
+    
+    for (int i = 7; i >= 0; i--) {
+        this->iv[i] = (unsigned char) iv;
+        iv >>= 8;
+    }
+    memcpy(this->chain, this->iv, 8);
+    this->pendingLength = 0;
+}
+
+/**
+ * Turns the PKCS#5 padding on (the default) or off.
+ */
+void CipherStream::setPadding(bool padding)
+{
+    this->padding = padding;
+}
+
+/**
+ * Encrypts or decrypts the next piece of the text. The bytes of a block that
+ * isn't whole yet are kept for the next call; when decrypting with padding,
+ * so is the last whole block, which may be the padding.
+ * 
+ * @param output Receives the whole blocks, at most length + 8 bytes; it must
+ * not overlap the input.
+ * @return The number of bytes written.
+ */
+size_t CipherStream::update(const unsigned char* input, size_t length, unsigned char* output)
+{
+    const bool holdLast = this->decrypting && this->padding;
+    size_t written = 0;
+    
+    // the block kept from the last call is filled up first.
+    if (0 < this->pendingLength) {
+        size_t taken = (8 - this->pendingLength < length) ? 8 - this->pendingLength : length;
+        memcpy(this->pending + this->pendingLength, input, taken);
+        this->pendingLength += taken;
+        input += taken;
+        length -= taken;
+        if (8 > this->pendingLength || (holdLast && 0 == length)) {
+            return 0;
+        }
+        written = this->processBlocks(this->pending, 1, output);
+        this->pendingLength = 0;
+    }
+    
+    // the whole blocks go in one run; what is left is kept.
+    size_t blocks = length / 8;
+    size_t rest = length % 8;
+    if (holdLast && 0 < blocks && 0 == rest) {
+        blocks--;
+        rest = 8;
+    }
+    written += this->processBlocks(input, blocks, output + written);
+    memcpy(this->pending, input + blocks * 8, rest);
+    this->pendingLength = rest;
+    
+    return written;
+}
+
+/**
+ * Ends the text: writes the padded last block when encrypting, or checks and
+ * takes off the padding when decrypting. The stream then starts over with
+ * the initialization vector.
+ * 
+ * @param output Receives at most 8 bytes.
+ * @param written Receives the number of bytes written.
+ * @return Whether the text was whole blocks and, when decrypting, ended in
+ * valid padding.
+ */
+bool CipherStream::finish(unsigned char* output, size_t& written)
+{
+    bool valid = true;
+    written = 0;
+    
+    if (! this->padding) {
+        valid = (0 == this->pendingLength);
+    } else if (! this->decrypting) {
+        // 1 to 8 bytes of padding, each holding their number.
+        unsigned char count = (unsigned char) (8 - this->pendingLength);
+        memset(this->pending + this->pendingLength, count, count);
+        written = this->processBlocks(this->pending, 1, output);
+    } else if (8 != this->pendingLength) {
+        valid = false;
+    } else {
+        unsigned char block[8];
+        this->processBlocks(this->pending, 1, block);
+        unsigned char count = block[7];
+        valid = (1 <= count && 8 >= count);
+        for (int i = 8 - count; valid && i < 8; i++) {
+            valid = (count == block[i]);
+        }
+        if (valid) {
+            written = 8 - count;
+            memcpy(output, block, written);
+        }
+    }
+    
+    memcpy(this->chain, this->iv, 8);
+    this->pendingLength = 0;
+    return valid;
+}
+
+/**
+ * Encrypts or decrypts a whole text with a stream.
+ * 
+ * @return Whether the stream finished; see finish.
+ */
+bool CipherStream::process(Mode mode, bool decrypt, uint64_t key, uint64_t iv, const std::string& input, std::string& output)
+{
+    CipherStream stream(mode, decrypt, key, iv);
+    output.resize(input.size() + 16);
+    
+    size_t written, last;
+    written = stream.update((const unsigned char*) input.data(), input.size(), (unsigned char*) &output[0]);
+    bool finished = stream.finish((unsigned char*) &output[0] + written, last);
+    output.resize(written + last);
+    
+    return finished;
+}
+
+/**
+ * Reads a mode name, "ecb" or "cbc".
+ * 
+ * @return Whether the name is a mode.
+ */
+bool CipherStream::parseMode(const std::string& name, Mode& mode)
+{
+    if ("ecb" == name) {
+        mode = CipherStream::ECB;
+        return true;
+    }
+    if ("cbc" == name) {
+        mode = CipherStream::CBC;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Encrypts or decrypts whole blocks in the mode of the stream.
+ * 
+ * @return The number of bytes written.
+ */
+size_t CipherStream::processBlocks(const unsigned char* input, size_t blocks, unsigned char* output)
+{
+    if (0 == blocks) {
+        return 0;
+    }
+    
+    if (CipherStream::ECB == this->mode) {
+        this->cryptBlocks(input, blocks, output);
+    } else if (! this->decrypting) {
+        // every block is chained to the ciphertext of the one before.
+        const unsigned char* previous = this->chain;
+        for (size_t i = 0; i < blocks; i++) {
+            unsigned char block[8];
+            memcpy(block, input + i * 8, 8);
+            xorBlock(block, previous);
+            this->core.encryptBlock(block, output + i * 8);
+            previous = output + i * 8;
+        }
+        memcpy(this->chain, previous, 8);
+    } else {
+        // the blocks are decrypted side by side, and each is then chained
+        // to the ciphertext before it, which is still in the input.
+        this->cryptBlocks(input, blocks, output);
+        xorBlock(output, this->chain);
+        for (size_t i = 1; i < blocks; i++) {
+            xorBlock(output + i * 8, input + (i - 1) * 8);
+        }
+        memcpy(this->chain, input + (blocks - 1) * 8, 8);
+    }
+    
+    return blocks * 8;
+}
+
+/**
+ * Encrypts or decrypts whole blocks in ECB mode, on the kernel if there are
+ * enough of them: the full kernel passes always, and the blocks after them
+ * if they fill enough of another one.
+ */
+void CipherStream::cryptBlocks(const unsigned char* input, size_t blocks, unsigned char* output)
+{
+    size_t lanes = this->bulk.getLanes();
+    size_t bulkBlocks = (blocks % lanes < this->bulkBlocks) ? blocks - blocks % lanes : blocks;
+    if (0 < bulkBlocks) {
+        this->bulk.cryptBlocks(this->key, input, output, bulkBlocks, this->decrypting);
+    }
+    
+    for (size_t i = bulkBlocks; i < blocks; i++) {
+        if (this->decrypting) {
+            this->core.decryptBlock(input + i * 8, output + i * 8);
+        } else {
+            this->core.encryptBlock(input + i * 8, output + i * 8);
+        }
+    }
+}
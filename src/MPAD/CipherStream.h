@@ -0,0 +1,165 @@
+/**
+ * File: CipherStream.h
+ * 
+ * Header file for the CipherStream class.
+ * 
+ * @version 0.1
+ */
+
+// make sure that the signature of the class is defined only once.
+#ifndef CIPHERSTREAM_H
+#define	CIPHERSTREAM_H
+
+// include the string library for the std::string class.
+#include <string>
+
+// include the fixed-width integer types.
+#include <stdint.h>
+
+// include the DES implementations.
+#include "DESCore.h"
+#include "AlgorithmDESBitslice.h"
+
+/**
+ * Signature of the CipherStream class.
+ * 
+ * CipherStream encrypts or decrypts a text of any length with DES in ECB or
+ * CBC mode, a piece at a time: update takes the text as it comes and writes
+ * out the whole blocks it can, and finish writes out the last block. The
+ * text is padded the PKCS#5 way (1 to 8 bytes, each holding the number of
+ * padding bytes), unless padding is turned off, in which case the text has
+ * to be whole blocks.
+ * 
+ * ECB in both directions and CBC decryption, where the blocks don't depend
+ * on each other, run on the bitsliced kernel, as many blocks at a time as it
+ * has lanes; CBC encryption chains every block to the one before and runs
+ * on DESCore, a block at a time. So do runs of blocks too short to fill a
+ * good part of a kernel pass.
+ * 
+ * Unlike the encrpyt/decrypt methods of the engines, which pad with spaces
+ * and trim the text for the key search, a stream gives back exactly the
+ * text it was given.
+ * 
+ * @since version 0.1
+ * @see DESCore
+ * @see AlgorithmDESBitslice
+ */
+class CipherStream
+{
+    // public attributes and methods of the class.
+    public:
+        
+        /**
+         * The modes of operation.
+         */
+        enum Mode
+        {
+            ECB,
+            CBC
+        };
+        
+        /**
+         * Constructor method of the class.
+         * 
+         * @param mode ECB or CBC.
+         * @param decrypt Whether the stream decrypts instead of encrypts.
+         * @param key The 64-bit DES key.
+         * @param iv The initialization vector of CBC, as a big-endian 64-bit
+         * word; ECB doesn't use it.
+         */
+        CipherStream(Mode mode, bool decrypt, uint64_t key, uint64_t iv);
+        
+        /**
+         * Turns the PKCS#5 padding on (the default) or off.
+         */
+        void setPadding(bool padding);
+        
+        /**
+         * Encrypts or decrypts the next piece of the text. The bytes of a
+         * block that isn't whole yet are kept for the next call; when
+         * decrypting with padding, so is the last whole block, which may be
+         * the padding.
+         * 
+         * @param output Receives the whole blocks, at most length + 8 bytes;
+         * it must not overlap the input.
+         * @return The number of bytes written.
+         */
+        size_t update(const unsigned char* input, size_t length, unsigned char* output);
+        
+        /**
+         * Ends the text: writes the padded last block when encrypting, or
+         * checks and takes off the padding when decrypting. The stream then
+         * starts over with the initialization vector.
+         * 
+         * @param output Receives at most 8 bytes.
+         * @param written Receives the number of bytes written.
+         * @return Whether the text was whole blocks and, when decrypting,
+         * ended in valid padding.
+         */
+        bool finish(unsigned char* output, size_t& written);
+        
+        /**
+         * Encrypts or decrypts a whole text with a stream.
+         * 
+         * @return Whether the stream finished; see finish.
+         */
+        static bool process(Mode mode, bool decrypt, uint64_t key, uint64_t iv, const std::string& input, std::string& output);
+        
+        /**
+         * Reads a mode name, "ecb" or "cbc".
+         * 
+         * @return Whether the name is a mode.
+         */
+        static bool parseMode(const std::string& name, Mode& mode);
+    
+    // private attributes and methods of the class.
+    private:
+        
+        /**
+         * The mode, the direction and whether the text is padded.
+         */
+        Mode mode;
+        bool decrypting;
+        bool padding;
+        
+        /**
+         * The key, in the form of both implementations.
+         */
+        uint64_t key;
+        DESCore core;
+        AlgorithmDESBitslice bulk;
+        
+        /**
+         * Fewest blocks that go to the bitsliced kernel at once.
+         */
+        size_t bulkBlocks;
+        
+        /**
+         * The initialization vector, and the block the next one is chained
+         * to in CBC mode.
+         */
+        unsigned char iv[8];
+        unsigned char chain[8];
+        
+        /**
+         * Bytes given to update that aren't written out yet.
+         */
+        unsigned char pending[8];
+        size_t pendingLength;
+        
+        /**
+         * Encrypts or decrypts whole blocks in the mode of the stream.
+         * 
+         * @return The number of bytes written.
+         */
+        size_t processBlocks(const unsigned char* input, size_t blocks, unsigned char* output);
+        
+        /**
+         * Encrypts or decrypts whole blocks in ECB mode, on the kernel if
+         * there are enough of them.
+         */
+        void cryptBlocks(const unsigned char* input, size_t blocks, unsigned char* output);
+};
+
+// end of the class signature.
+#endif	/* CIPHERSTREAM_H */
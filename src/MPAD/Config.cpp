@@ -21,6 +21,9 @@
 // include the string library for the std::string class.
 #include <string>
 
+// include the C string functions.
+#include <string.h>
+
 // include the signature of the class.
 #include "Config.h"
 #include "Logger.h"
@@ -76,6 +79,19 @@ int Config::readValue(string key, string section) {
     return Config::getInstance()->configuration[section][key];
 }
 
+/**
+ * Returns the value of a setting as it is written in the configuration file,
+ * for the settings that aren't integers (hex masks, 64-bit numbers).
+ * 
+ * @param key The key of the configuration setting.
+ * @param section The section in which the corresponding setting resides.
+ * @return The configuration setting value, or an empty string if the setting
+ * doesn't exist.
+ */
+string Config::readString(string key, string section) {
+    return Config::getInstance()->strings[section][key];
+}
+
 /**
  * Parses the configuration file and stores the corresponding settings
  * in the configuration property.
@@ -144,7 +160,10 @@ void Config::parseFile() {
             // if the configuration setting was parsed correctly;
             if (key && value) {
                 // set the configuration setting in the instance variable.
-                this->configuration[(string) currentSection][(string) this->trim(key)] = atoi(this->trim(value));
+                key = this->trim(key);
+                value = this->trim(value);
+                this->configuration[(string) currentSection][(string) key] = atoi(value);
+                this->strings[(string) currentSection][(string) key] = value;
             }
         }
     }
@@ -181,6 +200,8 @@ char* Config::trim(char* rawString) {
     // mark the actual string's end index.
     end = i-j;
 
-    // trim the unnecessary characters.
-    return (char*) ((string) rawString).substr(start, end-start).c_str();
+    // trim the unnecessary characters. this is done in place, so that the
+    // returned pointer stays valid as long as the raw string does.
+    rawString[end] = '\0';
+    return rawString + start;
 }
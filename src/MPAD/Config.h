@@ -58,6 +58,19 @@ class Config
          */
         static int readValue(std::string key, std::string section);
         
+        /**
+         * Returns the value of a setting as it is written in the configuration
+         * file, for the settings that aren't integers (hex masks, 64-bit
+         * numbers).
+         * 
+         * @param key The key of the configuration setting.
+         * @param section The section in which the corresponding setting
+         * resides.
+         * @return The configuration setting value, or an empty string if the
+         * setting doesn't exist.
+         */
+        static std::string readString(std::string key, std::string section);
+        
         /**
          * If the Config class was instantiated before; returns a pointer to
          * that instance. If not; instantiates the class, stores a pointer to
@@ -68,8 +81,8 @@ class Config
         static Config* getInstance();
         
         /**
-         * Trims the unnecessary white-spaces from the string and returns the
-         * trimmed string.
+         * Trims the unnecessary white-spaces from the string (in place) and
+         * returns the trimmed string, which points into the raw string.
          * 
          * @param rawString Un-trimmed string.
          * @return  Trimmed string.
@@ -85,6 +98,11 @@ class Config
          */
         std::map<std::string, std::map<std::string, int> > configuration;
         
+        /**
+         * The same settings, as they are written in the configuration file.
+         */
+        std::map<std::string, std::map<std::string, std::string> > strings;
+        
         /**
          * Constructor of the Config class.
          */
@@ -0,0 +1,272 @@
+/**
+ * File: ControlBlock.cpp
+ * 
+ * Source code file for the ControlBlock class.
+ * 
+ * @version 0.1
+ */
+
+// include the shared memory related functions.
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+// include the placement new operator.
+#include <new>
+
+// include the signature of the class.
+#include "ControlBlock.h"
+
+/**
+ * Offset of the first WorkerStatus from the start of the block.
+ */
+static const size_t workersOffset = (sizeof(ControlBlock) + 63) & ~(size_t) 63;
+
+/**
+ * Only create/open make control blocks.
+ */
+ControlBlock::ControlBlock()
+{
+}
+
+/**
+ * Returns the size of the mapping of a block for the given number of workers.
+ */
+size_t ControlBlock::sizeFor(int workers)
+{
+    return workersOffset + workers * sizeof(WorkerStatus);
+}
+
+/**
+ * Creates a control block for the given number of workers and a key space of
+ * [firstCandidate, lastCandidate).
+ * 
+ * @param name Name of the shared memory segment, or an empty string for a
+ * block that is only shared by the threads of this process.
+ * @return The control block, or NULL if it couldn't be created.
+ */
+ControlBlock* ControlBlock::create(std::string name, int workers, uint64_t firstCandidate, uint64_t lastCandidate)
+{
+    if (1 > workers) {
+        workers = 1;
+    }
+    size_t size = ControlBlock::sizeFor(workers);
+    
+    void* memory;
+    if (name.empty()) {
+        memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANON, -1, 0);
+    } else {
+        int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (-1 == fd) {
+            return NULL;
+        }
+        if (-1 == ftruncate(fd, size)) {
+            ::close(fd);
+            shm_unlink(name.c_str());
+            return NULL;
+        }
+        memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (MAP_FAILED == memory) {
+            shm_unlink(name.c_str());
+        }
+    }
+    if (MAP_FAILED == memory) {
+        return NULL;
+    }
+    
+    // the mapping starts out zeroed; construct the block and the worker
+    // entries in it.
+    ControlBlock* block = new (memory) ControlBlock;
+    KeyspaceScheduler::initialize(&block->keyspace, firstCandidate, lastCandidate, workers);
+    block->found.store(false);
+    block->cancelled.store(false);
+    block->foundCandidate.store(0);
+    block->numberOfWorkers = workers;
+    block->size = size;
+    for (int i = 0; i < workers; i++) {
+        WorkerStatus* worker = new ((char*) memory + workersOffset + i * sizeof(WorkerStatus)) WorkerStatus;
+        worker->keysSearched.store(0);
+        worker->keysPerSecond.store(0);
+        worker->chunkFirst.store(0);
+        worker->chunkLast.store(0);
+        worker->lowWaterMark.store(firstCandidate);
+    }
+    
+    return block;
+}
+
+/**
+ * Maps the control block of an existing shared memory segment.
+ * 
+ * @return The control block, or NULL if it couldn't be opened.
+ */
+ControlBlock* ControlBlock::open(std::string name)
+{
+    int fd = shm_open(name.c_str(), O_RDWR, 0600);
+    if (-1 == fd) {
+        return NULL;
+    }
+    
+    // the size of the segment tells how many workers it was made for.
+    struct stat status;
+    if (-1 == fstat(fd, &status) || (size_t) status.st_size < ControlBlock::sizeFor(1)) {
+        ::close(fd);
+        return NULL;
+    }
+    
+    void* memory = mmap(NULL, status.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    
+    return (MAP_FAILED == memory) ? NULL : (ControlBlock*) memory;
+}
+
+/**
+ * Unmaps a control block.
+ */
+void ControlBlock::close(ControlBlock* block)
+{
+    munmap(block, block->size);
+}
+
+/**
+ * Removes the name of a shared memory segment; the block goes away once
+ * nobody has it mapped.
+ */
+void ControlBlock::remove(std::string name)
+{
+    shm_unlink(name.c_str());
+}
+
+/**
+ * Returns the shared key space cursor.
+ */
+KeyspaceCursor* ControlBlock::getKeyspace()
+{
+    return &this->keyspace;
+}
+
+/**
+ * Returns the number of workers.
+ */
+int ControlBlock::getNumberOfWorkers()
+{
+    return this->numberOfWorkers;
+}
+
+/**
+ * Returns the status of a worker.
+ */
+WorkerStatus* ControlBlock::getWorker(int index)
+{
+    return (WorkerStatus*) ((char*) this + workersOffset + index * sizeof(WorkerStatus));
+}
+
+/**
+ * Records the key a worker has found and cancels the others. Only the first
+ * key that is reported is kept.
+ * 
+ * @return Whether this was the first key to be reported.
+ */
+bool ControlBlock::reportFound(uint64_t candidate)
+{
+    bool expected = false;
+    if (! this->found.compare_exchange_strong(expected, true)) {
+        return false;
+    }
+    
+    this->foundCandidate.store(candidate);
+    this->cancel();
+    
+    return true;
+}
+
+/**
+ * Returns whether a key has been found.
+ */
+bool ControlBlock::isFound()
+{
+    return this->found.load();
+}
+
+/**
+ * Returns the key that has been found, if any.
+ */
+uint64_t ControlBlock::getFoundCandidate()
+{
+    return this->foundCandidate.load();
+}
+
+/**
+ * Tells every worker to stop.
+ */
+void ControlBlock::cancel()
+{
+    this->cancelled.store(true);
+}
+
+/**
+ * Returns whether the workers have been told to stop.
+ */
+bool ControlBlock::isCancelled()
+{
+    return this->cancelled.load(std::memory_order_relaxed);
+}
+
+/**
+ * Returns the cancel flag, for the engine to poll while it searches.
+ */
+const std::atomic<bool>* ControlBlock::getCancelFlag()
+{
+    return &this->cancelled;
+}
+
+/**
+ * Returns the number of candidates all workers have searched.
+ */
+uint64_t ControlBlock::getKeysSearched()
+{
+    uint64_t keys = 0;
+    for (uint32_t i = 0; i < this->numberOfWorkers; i++) {
+        keys += this->getWorker(i)->keysSearched.load(std::memory_order_relaxed);
+    }
+    return keys;
+}
+
+/**
+ * Returns the sum of the speeds of all workers.
+ */
+uint64_t ControlBlock::getKeysPerSecond()
+{
+    uint64_t keys = 0;
+    for (uint32_t i = 0; i < this->numberOfWorkers; i++) {
+        keys += this->getWorker(i)->keysPerSecond.load(std::memory_order_relaxed);
+    }
+    return keys;
+}
+
+/**
+ * Returns the candidate below which the whole key space has been searched:
+ * the lowest of the workers' low-water marks and the cursor. It is what a
+ * checkpoint records.
+ */
+uint64_t ControlBlock::getSearchedUpTo()
+{
+    // the marks are read before the cursor; a chunk claimed in between
+    // starts above the mark its worker had published (see
+    // KeyspaceScheduler::nextChunk).
+    uint64_t searched = ~(uint64_t) 0;
+    for (uint32_t i = 0; i < this->numberOfWorkers; i++) {
+        uint64_t mark = this->getWorker(i)->lowWaterMark.load();
+        if (mark < searched) {
+            searched = mark;
+        }
+    }
+    
+    uint64_t next = this->keyspace.next.load();
+    if (next < searched) {
+        searched = next;
+    }
+    return (this->keyspace.last < searched) ? this->keyspace.last : searched;
+}
@@ -0,0 +1,219 @@
+/**
+ * File: ControlBlock.h
+ * 
+ * Header file for the ControlBlock class.
+ * 
+ * @version 0.1
+ */
+
+// make sure that the signature of the class is defined only once.
+#ifndef CONTROLBLOCK_H
+#define	CONTROLBLOCK_H
+
+// include the string library for the std::string class.
+#include <string>
+
+// include the atomic library.
+#include <atomic>
+
+// include the fixed-width integer types.
+#include <stdint.h>
+
+// include the KeyspaceCursor structure.
+#include "KeyspaceScheduler.h"
+
+/**
+ * What a worker publishes about itself. Every worker has a cache line of its
+ * own, so that their updates don't slow each other down.
+ */
+struct alignas(64) WorkerStatus
+{
+    /**
+     * Number of candidates the worker has searched so far (bytes of the
+     * word file when the candidates are byte offsets into one).
+     */
+    std::atomic<uint64_t> keysSearched;
+    
+    /**
+     * The last speed the worker has measured.
+     */
+    std::atomic<uint64_t> keysPerSecond;
+    
+    /**
+     * The chunk [chunkFirst, chunkLast) the worker is searching; empty when
+     * it is between two chunks. It is published before the chunk is
+     * claimed (see KeyspaceScheduler::setChunkRecord); if the worker dies,
+     * whoever takes its place searches this chunk first.
+     */
+    std::atomic<uint64_t> chunkFirst;
+    std::atomic<uint64_t> chunkLast;
+    
+    /**
+     * No chunk the worker hasn't finished starts below this candidate. The
+     * worker moves it up to the cursor every time it claims a chunk (see
+     * KeyspaceScheduler::setLowWaterMark).
+     */
+    std::atomic<uint64_t> lowWaterMark;
+};
+
+/**
+ * Signature of the ControlBlock class.
+ * 
+ * The ControlBlock is the memory the main process and the workers (child
+ * processes or threads) share: the key space cursor, the found flag and the
+ * found key, a cancel flag, and the progress of every worker. Between
+ * processes it is a named POSIX shared memory segment, so that child_p can
+ * map it by name; between threads it is an anonymous mapping.
+ * 
+ * A ControlBlock is only ever created in such a mapping by create/open.
+ * 
+ * @since version 0.1
+ * @see MainProcess
+ * @see ChildProcess
+ * @see ThreadedSearch
+ */
+class ControlBlock
+{
+    // public attributes and methods of the class.
+    public:
+        
+        /**
+         * Creates a control block for the given number of workers and a key
+         * space of [firstCandidate, lastCandidate).
+         * 
+         * @param name Name of the shared memory segment, or an empty string
+         * for a block that is only shared by the threads of this process.
+         * @return The control block, or NULL if it couldn't be created.
+         */
+        static ControlBlock* create(std::string name, int workers, uint64_t firstCandidate, uint64_t lastCandidate);
+        
+        /**
+         * Maps the control block of an existing shared memory segment.
+         * 
+         * @return The control block, or NULL if it couldn't be opened.
+         */
+        static ControlBlock* open(std::string name);
+        
+        /**
+         * Unmaps a control block.
+         */
+        static void close(ControlBlock* block);
+        
+        /**
+         * Removes the name of a shared memory segment; the block goes away
+         * once nobody has it mapped.
+         */
+        static void remove(std::string name);
+        
+        /**
+         * Returns the shared key space cursor.
+         */
+        KeyspaceCursor* getKeyspace();
+        
+        /**
+         * Returns the number of workers.
+         */
+        int getNumberOfWorkers();
+        
+        /**
+         * Returns the status of a worker.
+         */
+        WorkerStatus* getWorker(int index);
+        
+        /**
+         * Records the key a worker has found and cancels the others. Only the
+         * first key that is reported is kept.
+         * 
+         * @return Whether this was the first key to be reported.
+         */
+        bool reportFound(uint64_t candidate);
+        
+        /**
+         * Returns whether a key has been found.
+         */
+        bool isFound();
+        
+        /**
+         * Returns the key that has been found, if any.
+         */
+        uint64_t getFoundCandidate();
+        
+        /**
+         * Tells every worker to stop.
+         */
+        void cancel();
+        
+        /**
+         * Returns whether the workers have been told to stop.
+         */
+        bool isCancelled();
+        
+        /**
+         * Returns the cancel flag, for the engine to poll while it searches.
+         */
+        const std::atomic<bool>* getCancelFlag();
+        
+        /**
+         * Returns the number of candidates all workers have searched.
+         */
+        uint64_t getKeysSearched();
+        
+        /**
+         * Returns the sum of the speeds of all workers.
+         */
+        uint64_t getKeysPerSecond();
+        
+        /**
+         * Returns the candidate below which the whole key space has been
+         * searched: the lowest of the workers' low-water marks and the
+         * cursor. It is what a checkpoint records.
+         */
+        uint64_t getSearchedUpTo();
+    
+    // private attributes and methods of the class.
+    private:
+        
+        /**
+         * The shared key space cursor.
+         */
+        KeyspaceCursor keyspace;
+        
+        /**
+         * Set by the first worker that finds the key.
+         */
+        std::atomic<bool> found;
+        
+        /**
+         * Set when the workers should stop.
+         */
+        std::atomic<bool> cancelled;
+        
+        /**
+         * The key that has been found; valid once found is set.
+         */
+        std::atomic<uint64_t> foundCandidate;
+        
+        /**
+         * Number of workers (and of WorkerStatus entries after the block).
+         */
+        uint32_t numberOfWorkers;
+        
+        /**
+         * Size of the mapping.
+         */
+        uint64_t size;
+        
+        /**
+         * Returns the size of the mapping of a block for the given number of
+         * workers.
+         */
+        static size_t sizeFor(int workers);
+        
+        /**
+         * Only create/open make control blocks.
+         */
+        ControlBlock();
+};
+
+// end of the class signature.
+#endif	/* CONTROLBLOCK_H */
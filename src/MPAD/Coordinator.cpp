@@ -0,0 +1,431 @@
+/**
+ * File: Coordinator.cpp
+ * 
+ * Source code file for the Coordinator class.
+ * 
+ * @version 0.1
+ */
+
+// include standard libraries.
+#include <stdio.h>
+
+// include the poll and socket functions.
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// include the clock_gettime function.
+#include <time.h>
+
+// include the errno library for the errno variable.
+#include <errno.h>
+
+// include the stream related libraries.
+#include <sstream>
+
+// include the signature of the class.
+#include "Coordinator.h"
+
+// include the Logger class signature.
+#include "Logger.h"
+
+// include the hex encoding of the string pair.
+#include "AlgorithmInterface.h"
+
+/**
+ * Constructor method of the class.
+ * 
+ * @param pattern The known and the free bits of the keys searched.
+ * @param firstCandidate First candidate of the search.
+ * @param lastCandidate End of the search (the candidate after the last one).
+ */
+Coordinator::Coordinator(std::string rawString, std::string encryptedString, const KeyPattern& pattern, uint64_t firstCandidate, uint64_t lastCandidate)
+    : pattern(pattern)
+{
+    this->rawString = rawString;
+    this->encryptedString = encryptedString;
+    this->lastCandidate = lastCandidate;
+    this->nextCandidate = firstCandidate;
+    this->nextLeaseId = 1;
+    this->leaseSeconds = 5;
+    this->leaseTimeout = 15;
+    this->keysSearched = 0;
+    this->found = false;
+    this->foundCandidate = 0;
+    this->checkpoint = NULL;
+    this->checkpointInterval = 0;
+}
+
+/**
+ * Destructor method of the class; closes the connections.
+ */
+Coordinator::~Coordinator()
+{
+    for (std::map<int, Agent>::iterator agent = this->agents.begin(); agent != this->agents.end(); agent++) {
+        delete agent->second.channel;
+    }
+}
+
+/**
+ * Makes run() write its progress to the given checkpoint.
+ * 
+ * @param checkpoint The checkpoint, or NULL for none.
+ * @param intervalSeconds Seconds between two writes.
+ */
+void Coordinator::setCheckpoint(Checkpoint* checkpoint, int intervalSeconds)
+{
+    this->checkpoint = checkpoint;
+    this->checkpointInterval = intervalSeconds;
+}
+
+/**
+ * Sets how long a lease should take and how long it lasts without being
+ * renewed; values that aren't positive leave the defaults.
+ */
+void Coordinator::setLeaseTimes(int leaseSeconds, int leaseTimeout)
+{
+    if (0 < leaseSeconds) {
+        this->leaseSeconds = leaseSeconds;
+    }
+    if (0 < leaseTimeout) {
+        this->leaseTimeout = leaseTimeout;
+    }
+}
+
+/**
+ * Hands the key space out to the agents that connect to the given address
+ * until the key is found or the key space is exhausted.
+ * 
+ * @param foundCandidate Receives the matching candidate, if any.
+ * @return Whether a matching candidate was found.
+ */
+bool Coordinator::run(const std::string& address, uint64_t& foundCandidate)
+{
+    int listener = SocketChannel::listenOn(address);
+    if (0 > listener) {
+        Logger::writeToLogFile("ERROR: The coordinator can't listen on %s!", address);
+        return false;
+    }
+    Logger::writeToLogFile("The coordinator listens on %s!", address);
+    
+    // the string pair of a new search is on the disk from the start.
+    bool checkpointing = (NULL != this->checkpoint && 0 < this->checkpointInterval);
+    double nextCheckpoint = Coordinator::now() + this->checkpointInterval;
+    uint64_t checkpointed = this->getSearchedUpTo();
+    if (checkpointing) {
+        this->checkpoint->write(checkpointed);
+    }
+    
+    int agentCount = 0;
+    while (! this->found && ! this->isExhausted()) {
+        std::vector<struct pollfd> sockets(1);
+        sockets[0].fd = listener;
+        sockets[0].events = POLLIN;
+        for (std::map<int, Agent>::iterator agent = this->agents.begin(); agent != this->agents.end(); agent++) {
+            struct pollfd entry;
+            entry.fd = agent->first;
+            entry.events = POLLIN;
+            sockets.push_back(entry);
+        }
+        
+        // wake up at least once a second, for the lease expiries and the
+        // checkpoints.
+        if (0 > poll(&sockets[0], sockets.size(), 1000) && EINTR != errno) {
+            Logger::writeToLogFile("ERROR: The coordinator can't poll its connections!");
+            break;
+        }
+        
+        if (sockets[0].revents & POLLIN) {
+            int socket = accept(listener, NULL, NULL);
+            if (0 <= socket) {
+                std::stringstream name;
+                name << "AGENT-" << ++agentCount;
+                Agent agent;
+                agent.channel = new SocketChannel(socket);
+                agent.name = name.str();
+                agent.threads = 0;
+                agent.keysPerSecond = 0;
+                this->agents[socket] = agent;
+                Logger::writeToLogFile("Agent %s is connected!", agent.name);
+            }
+        }
+        
+        for (size_t i = 1; i < sockets.size() && ! this->found; i++) {
+            if (0 == sockets[i].revents) {
+                continue;
+            }
+            std::map<int, Agent>::iterator agent = this->agents.find(sockets[i].fd);
+            if (agent == this->agents.end()) {
+                continue;
+            }
+            if (! agent->second.channel->receive()) {
+                this->dropAgent(sockets[i].fd, "is disconnected");
+                continue;
+            }
+            
+            // the agent may be dropped while its lines are handled.
+            std::string line;
+            while (this->agents.count(sockets[i].fd) && this->agents[sockets[i].fd].channel->nextLine(line) && ! this->found) {
+                this->handleLine(sockets[i].fd, line);
+            }
+        }
+        
+        // an agent that doesn't renew its lease is taken for dead; whatever
+        // it sends later is not trusted.
+        double time = Coordinator::now();
+        std::vector<int> expired;
+        for (std::map<uint64_t, Lease>::iterator lease = this->leases.begin(); lease != this->leases.end(); lease++) {
+            if (time > lease->second.expires) {
+                expired.push_back(lease->second.agent);
+            }
+        }
+        for (size_t i = 0; i < expired.size(); i++) {
+            if (this->agents.count(expired[i])) {
+                this->dropAgent(expired[i], "has let its lease expire");
+            }
+        }
+        
+        if (checkpointing && time >= nextCheckpoint) {
+            nextCheckpoint = time + this->checkpointInterval;
+            if (this->getSearchedUpTo() != checkpointed) {
+                checkpointed = this->getSearchedUpTo();
+                this->checkpoint->write(checkpointed);
+            }
+        }
+    }
+    
+    // whoever is still connected stops.
+    this->broadcast(this->found ? "CANCEL" : "FINISH");
+    close(listener);
+    if (0 == address.compare(0, 5, "unix:")) {
+        unlink(address.substr(5).c_str());
+    }
+    if (checkpointing) {
+        this->checkpoint->finish(this->found, this->getSearchedUpTo());
+    }
+    
+    foundCandidate = this->foundCandidate;
+    return this->found;
+}
+
+/**
+ * Returns the number of keys the agents have searched.
+ */
+uint64_t Coordinator::getKeysSearched()
+{
+    return this->keysSearched;
+}
+
+/**
+ * Returns the candidate below which the whole key space has been searched:
+ * the lowest of the first candidates of the leases, of the ranges to be
+ * leased again and of what hasn't been leased yet.
+ */
+uint64_t Coordinator::getSearchedUpTo()
+{
+    uint64_t searched = this->nextCandidate;
+    for (std::map<uint64_t, Lease>::iterator lease = this->leases.begin(); lease != this->leases.end(); lease++) {
+        if (lease->second.firstCandidate < searched) {
+            searched = lease->second.firstCandidate;
+        }
+    }
+    for (size_t i = 0; i < this->returned.size(); i++) {
+        if (this->returned[i].first < searched) {
+            searched = this->returned[i].first;
+        }
+    }
+    return (this->lastCandidate < searched) ? this->lastCandidate : searched;
+}
+
+/**
+ * Handles one line from an agent. An agent that breaks the protocol is
+ * dropped.
+ */
+void Coordinator::handleLine(int socket, const std::string& line)
+{
+    Agent& agent = this->agents[socket];
+    std::istringstream words(line);
+    std::string command;
+    words >> command;
+    
+    if ("HELLO" == command) {
+        words >> agent.threads;
+        if (words.fail() || 0 >= agent.threads) {
+            this->dropAgent(socket, "has sent a malformed greeting");
+            return;
+        }
+        
+        std::stringstream job;
+        job << "JOB " << AlgorithmInterface::encodeHex(this->rawString) << ' ' << AlgorithmInterface::encodeHex(this->encryptedString)
+            << std::hex << ' ' << this->pattern.getKnownKey() << ' ' << this->pattern.getUnknownMask();
+        agent.channel->sendLine(job.str());
+        
+        std::stringstream message;
+        message << "Agent %s searches with " << agent.threads << " threads!";
+        Logger::writeToLogFile(message.str(), agent.name);
+        return;
+    }
+    if (0 == agent.threads) {
+        this->dropAgent(socket, "hasn't greeted");
+        return;
+    }
+    if ("LEASE" == command) {
+        this->grantLease(socket);
+        return;
+    }
+    
+    // the rest of the messages are about a lease of the agent.
+    uint64_t leaseId, value = 0;
+    words >> leaseId;
+    if ("DONE" == command || "FOUND" == command) {
+        words >> value;
+    }
+    std::map<uint64_t, Lease>::iterator lease = this->leases.find(leaseId);
+    bool owned = (! words.fail() && lease != this->leases.end() && socket == lease->second.agent);
+    if ("RENEW" == command && ! words.fail() && ! owned) {
+        // a renewal may cross the report of the lease on the way.
+        return;
+    }
+    if (! owned) {
+        this->dropAgent(socket, "has sent an unknown lease");
+        return;
+    }
+    
+    if ("RENEW" == command) {
+        lease->second.expires = Coordinator::now() + this->leaseTimeout;
+    } else if ("DONE" == command) {
+        uint64_t keys = lease->second.lastCandidate - lease->second.firstCandidate;
+        this->keysSearched += keys;
+        agent.keysPerSecond = (0 < value) ? keys * 1000000.0 / value : 0;
+        this->leases.erase(lease);
+    } else if ("FOUND" == command) {
+        if (value < lease->second.firstCandidate || value >= lease->second.lastCandidate) {
+            this->dropAgent(socket, "has reported a key out of its lease");
+            return;
+        }
+        this->keysSearched += value + 1 - lease->second.firstCandidate;
+        this->found = true;
+        this->foundCandidate = value;
+        this->leases.erase(lease);
+        Logger::writeToLogFile("Agent %s has found the key!", agent.name);
+    } else {
+        this->dropAgent(socket, "has sent an unknown message");
+    }
+}
+
+/**
+ * Hands the agent the next range of the key space: a range of an expired
+ * lease first, else the one after the last leased. The range is sized by the
+ * speed of the agent, or by its number of threads before its first lease is
+ * done. If all of the key space is leased, the agent is told to wait; one of
+ * the leases may expire.
+ */
+void Coordinator::grantLease(int socket)
+{
+    Agent& agent = this->agents[socket];
+    uint64_t size = (0 < agent.keysPerSecond) ? agent.keysPerSecond * this->leaseSeconds : ((uint64_t) agent.threads << 24);
+    if (size < Coordinator::minimumLeaseSize) {
+        size = Coordinator::minimumLeaseSize;
+    }
+    
+    Lease lease;
+    if (! this->returned.empty()) {
+        std::pair<uint64_t, uint64_t>& range = this->returned.back();
+        lease.firstCandidate = range.first;
+        lease.lastCandidate = (range.second - range.first > size) ? range.first + size : range.second;
+        range.first = lease.lastCandidate;
+        if (range.first >= range.second) {
+            this->returned.pop_back();
+        }
+    } else if (this->nextCandidate < this->lastCandidate) {
+        lease.firstCandidate = this->nextCandidate;
+        lease.lastCandidate = (this->lastCandidate - this->nextCandidate > size) ? this->nextCandidate + size : this->lastCandidate;
+        this->nextCandidate = lease.lastCandidate;
+    } else {
+        agent.channel->sendLine("WAIT");
+        return;
+    }
+    
+    lease.agent = socket;
+    lease.started = Coordinator::now();
+    lease.expires = lease.started + this->leaseTimeout;
+    uint64_t leaseId = this->nextLeaseId++;
+    this->leases[leaseId] = lease;
+    
+    std::stringstream range;
+    range << "RANGE " << leaseId << ' ' << lease.firstCandidate << ' ' << lease.lastCandidate;
+    agent.channel->sendLine(range.str());
+}
+
+/**
+ * Puts the range of a lease back, to be leased again.
+ */
+void Coordinator::returnLease(uint64_t leaseId)
+{
+    std::map<uint64_t, Lease>::iterator lease = this->leases.find(leaseId);
+    if (lease == this->leases.end()) {
+        return;
+    }
+    this->returned.push_back(std::make_pair(lease->second.firstCandidate, lease->second.lastCandidate));
+    this->leases.erase(lease);
+}
+
+/**
+ * Closes the connection to an agent; its leases are returned.
+ */
+void Coordinator::dropAgent(int socket, const std::string& reason)
+{
+    std::map<int, Agent>::iterator agent = this->agents.find(socket);
+    if (agent == this->agents.end()) {
+        return;
+    }
+    
+    std::vector<uint64_t> owned;
+    for (std::map<uint64_t, Lease>::iterator lease = this->leases.begin(); lease != this->leases.end(); lease++) {
+        if (socket == lease->second.agent) {
+            owned.push_back(lease->first);
+        }
+    }
+    for (size_t i = 0; i < owned.size(); i++) {
+        this->returnLease(owned[i]);
+    }
+    
+    std::stringstream message;
+    message << "Agent %s " << reason << "!";
+    if (! owned.empty()) {
+        message << " Its lease will be searched by another agent.";
+    }
+    Logger::writeToLogFile(message.str(), agent->second.name);
+    
+    delete agent->second.channel;
+    this->agents.erase(agent);
+}
+
+/**
+ * Sends the same line to every agent.
+ */
+void Coordinator::broadcast(const std::string& line)
+{
+    for (std::map<int, Agent>::iterator agent = this->agents.begin(); agent != this->agents.end(); agent++) {
+        agent->second.channel->sendLine(line);
+    }
+}
+
+/**
+ * Returns whether every candidate has been searched: none is left to lease,
+ * to lease again or leased out.
+ */
+bool Coordinator::isExhausted()
+{
+    return this->nextCandidate >= this->lastCandidate && this->returned.empty() && this->leases.empty();
+}
+
+/**
+ * Returns the time on the monotonic clock, in seconds.
+ */
+double Coordinator::now()
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec / 1e9;
+}
@@ -0,0 +1,230 @@
+/**
+ * File: Coordinator.h
+ * 
+ * Header file for the Coordinator class.
+ * 
+ * @version 0.1
+ */
+
+// make sure that the signature of the class is defined only once.
+#ifndef COORDINATOR_H
+#define	COORDINATOR_H
+
+// include the string library for the std::string class.
+#include <string>
+
+// include the fixed-width integer types.
+#include <stdint.h>
+
+// include the container libraries.
+#include <map>
+#include <vector>
+
+// include the KeyPattern class signature.
+#include "KeyPattern.h"
+
+// include the Checkpoint class signature.
+#include "Checkpoint.h"
+
+// include the SocketChannel class signature.
+#include "SocketChannel.h"
+
+/**
+ * Signature of the Coordinator class.
+ * 
+ * Coordinator spreads a search over several machines: worker agents (see
+ * WorkerAgent) connect to it, get the raw/encrypted string pair and the key
+ * pattern, and then lease ranges of the key space one after the other. A
+ * lease is sized to take about leaseSeconds on the agent that asks for it,
+ * going by the speed of its last lease. An agent renews its lease while it
+ * searches; a lease that isn't renewed for leaseTimeout seconds, or whose
+ * agent disconnects, is handed out again. The first agent to find the key
+ * reports it, and every agent is told to stop.
+ * 
+ * The protocol is one line per message:
+ * 
+ *   agent                            coordinator
+ *   HELLO <threads>             ->
+ *                               <-   JOB <raw hex> <encrypted hex> <known key hex> <unknown mask hex>
+ *   LEASE                       ->
+ *                               <-   RANGE <lease> <first> <last>, or
+ *                                    WAIT (all of it is leased; ask again)
+ *   RENEW <lease>               ->
+ *   DONE <lease> <microseconds> ->
+ *   FOUND <lease> <candidate>   ->
+ *                               <-   CANCEL (the key is found) or
+ *                                    FINISH (the key space is exhausted)
+ * 
+ * Everything runs in one thread, around poll().
+ * 
+ * @since version 0.1
+ * @see MainProcess
+ * @see WorkerAgent
+ */
+class Coordinator
+{
+    // public attributes and methods of the class.
+    public:
+        
+        /**
+         * Constructor method of the class.
+         * 
+         * @param pattern The known and the free bits of the keys searched.
+         * @param firstCandidate First candidate of the search.
+         * @param lastCandidate End of the search (the candidate after the
+         * last one).
+         */
+        Coordinator(std::string rawString, std::string encryptedString, const KeyPattern& pattern, uint64_t firstCandidate, uint64_t lastCandidate);
+        
+        /**
+         * Destructor method of the class; closes the connections.
+         */
+        ~Coordinator();
+        
+        /**
+         * Makes run() write its progress to the given checkpoint.
+         * 
+         * @param checkpoint The checkpoint, or NULL for none.
+         * @param intervalSeconds Seconds between two writes.
+         */
+        void setCheckpoint(Checkpoint* checkpoint, int intervalSeconds);
+        
+        /**
+         * Sets how long a lease should take and how long it lasts without
+         * being renewed.
+         */
+        void setLeaseTimes(int leaseSeconds, int leaseTimeout);
+        
+        /**
+         * Hands the key space out to the agents that connect to the given
+         * address until the key is found or the key space is exhausted.
+         * 
+         * @param foundCandidate Receives the matching candidate, if any.
+         * @return Whether a matching candidate was found.
+         */
+        bool run(const std::string& address, uint64_t& foundCandidate);
+        
+        /**
+         * Returns the number of keys the agents have searched.
+         */
+        uint64_t getKeysSearched();
+        
+        /**
+         * Returns the candidate below which the whole key space has been
+         * searched.
+         */
+        uint64_t getSearchedUpTo();
+        
+        /**
+         * Fewest candidates a lease is given, so that a slow agent doesn't
+         * spend its time asking for leases.
+         */
+        static const uint64_t minimumLeaseSize = (uint64_t) 1 << 16;
+    
+    // private attributes and methods of the class.
+    private:
+        
+        /**
+         * A connected agent.
+         */
+        struct Agent
+        {
+            SocketChannel* channel;
+            std::string name;
+            int threads;
+            uint64_t keysPerSecond;
+        };
+        
+        /**
+         * A range leased to an agent.
+         */
+        struct Lease
+        {
+            int agent;
+            uint64_t firstCandidate;
+            uint64_t lastCandidate;
+            double started;
+            double expires;
+        };
+        
+        /**
+         * The string pair, the key pattern and the end of the search.
+         */
+        std::string rawString;
+        std::string encryptedString;
+        KeyPattern pattern;
+        uint64_t lastCandidate;
+        
+        /**
+         * The first candidate that hasn't been leased yet, and the ranges of
+         * expired leases that are to be leased again.
+         */
+        uint64_t nextCandidate;
+        std::vector<std::pair<uint64_t, uint64_t> > returned;
+        
+        /**
+         * The agents by socket, and the leases by id.
+         */
+        std::map<int, Agent> agents;
+        std::map<uint64_t, Lease> leases;
+        uint64_t nextLeaseId;
+        
+        /**
+         * Seconds a lease should take, and seconds it lasts without being
+         * renewed.
+         */
+        int leaseSeconds;
+        int leaseTimeout;
+        
+        /**
+         * Keys searched by the agents, and whether (and which) key is found.
+         */
+        uint64_t keysSearched;
+        bool found;
+        uint64_t foundCandidate;
+        
+        /**
+         * Where the progress is written to, if anywhere, and how often.
+         */
+        Checkpoint* checkpoint;
+        int checkpointInterval;
+        
+        /**
+         * Handles one line from an agent.
+         */
+        void handleLine(int socket, const std::string& line);
+        
+        /**
+         * Hands the agent the next range of the key space, or tells it to
+         * wait.
+         */
+        void grantLease(int socket);
+        
+        /**
+         * Puts the range of a lease back, to be leased again.
+         */
+        void returnLease(uint64_t leaseId);
+        
+        /**
+         * Closes the connection to an agent; its leases are returned.
+         */
+        void dropAgent(int socket, const std::string& reason);
+        
+        /**
+         * Sends the same line to every agent.
+         */
+        void broadcast(const std::string& line);
+        
+        /**
+         * Returns whether every candidate has been searched.
+         */
+        bool isExhausted();
+        
+        /**
+         * Returns the time on the monotonic clock, in seconds.
+         */
+        static double now();
+};
+
+// end of the class signature.
+#endif	/* COORDINATOR_H */
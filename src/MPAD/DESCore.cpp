@@ -0,0 +1,415 @@
+/**
+ * File: DESCore.cpp
+ * 
+ * Source code file for the DESCore class.
+ * 
+ * The round function works on the right half rotated so that every S-box
+ * input is a contiguous 6-bit field: rotating R left by 5 puts the inputs of
+ * S1, S7, S5 and S3 at bits 0, 8, 16 and 24, rotating it left by 9 does the
+ * same for S2, S8, S6 and S4. The round keys are stored in the same layout
+ * (two words per round), so a round is two rotations, two XORs and eight
+ * SP-box lookups.
+ * 
+ * @version 0.1
+ */
+
+// include the memory related functions.
+#include <string.h>
+
+// include the signature of the class.
+#include "DESCore.h"
+
+/**
+ * The S-boxes as defined in FIPS 46 (four rows of 16 entries each).
+ */
+static const unsigned char sBoxes[8][64] = {
+    { 14, 4, 13, 1, 2, 15, 11, 8, 3, 10, 6, 12, 5, 9, 0, 7,
+      0, 15, 7, 4, 14, 2, 13, 1, 10, 6, 12, 11, 9, 5, 3, 8,
+      4, 1, 14, 8, 13, 6, 2, 11, 15, 12, 9, 7, 3, 10, 5, 0,
+      15, 12, 8, 2, 4, 9, 1, 7, 5, 11, 3, 14, 10, 0, 6, 13 },
+    { 15, 1, 8, 14, 6, 11, 3, 4, 9, 7, 2, 13, 12, 0, 5, 10,
+      3, 13, 4, 7, 15, 2, 8, 14, 12, 0, 1, 10, 6, 9, 11, 5,
+      0, 14, 7, 11, 10, 4, 13, 1, 5, 8, 12, 6, 9, 3, 2, 15,
+      13, 8, 10, 1, 3, 15, 4, 2, 11, 6, 7, 12, 0, 5, 14, 9 },
+    { 10, 0, 9, 14, 6, 3, 15, 5, 1, 13, 12, 7, 11, 4, 2, 8,
+      13, 7, 0, 9, 3, 4, 6, 10, 2, 8, 5, 14, 12, 11, 15, 1,
+      13, 6, 4, 9, 8, 15, 3, 0, 11, 1, 2, 12, 5, 10, 14, 7,
+      1, 10, 13, 0, 6, 9, 8, 7, 4, 15, 14, 3, 11, 5, 2, 12 },
+    { 7, 13, 14, 3, 0, 6, 9, 10, 1, 2, 8, 5, 11, 12, 4, 15,
+      13, 8, 11, 5, 6, 15, 0, 3, 4, 7, 2, 12, 1, 10, 14, 9,
+      10, 6, 9, 0, 12, 11, 7, 13, 15, 1, 3, 14, 5, 2, 8, 4,
+      3, 15, 0, 6, 10, 1, 13, 8, 9, 4, 5, 11, 12, 7, 2, 14 },
+    { 2, 12, 4, 1, 7, 10, 11, 6, 8, 5, 3, 15, 13, 0, 14, 9,
+      14, 11, 2, 12, 4, 7, 13, 1, 5, 0, 15, 10, 3, 9, 8, 6,
+      4, 2, 1, 11, 10, 13, 7, 8, 15, 9, 12, 5, 6, 3, 0, 14,
+      11, 8, 12, 7, 1, 14, 2, 13, 6, 15, 0, 9, 10, 4, 5, 3 },
+    { 12, 1, 10, 15, 9, 2, 6, 8, 0, 13, 3, 4, 14, 7, 5, 11,
+      10, 15, 4, 2, 7, 12, 9, 5, 6, 1, 13, 14, 0, 11, 3, 8,
+      9, 14, 15, 5, 2, 8, 12, 3, 7, 0, 4, 10, 1, 13, 11, 6,
+      4, 3, 2, 12, 9, 5, 15, 10, 11, 14, 1, 7, 6, 0, 8, 13 },
+    { 4, 11, 2, 14, 15, 0, 8, 13, 3, 12, 9, 7, 5, 10, 6, 1,
+      13, 0, 11, 7, 4, 9, 1, 10, 14, 3, 5, 12, 2, 15, 8, 6,
+      1, 4, 11, 13, 12, 3, 7, 14, 10, 15, 6, 8, 0, 5, 9, 2,
+      6, 11, 13, 8, 1, 4, 10, 7, 9, 5, 0, 15, 14, 2, 3, 12 },
+    { 13, 2, 8, 4, 6, 15, 11, 1, 10, 9, 3, 14, 5, 0, 12, 7,
+      1, 15, 13, 8, 10, 3, 7, 4, 12, 5, 6, 11, 0, 14, 9, 2,
+      7, 11, 4, 1, 9, 12, 14, 2, 0, 6, 10, 13, 15, 3, 5, 8,
+      2, 1, 14, 7, 4, 10, 8, 13, 15, 12, 9, 0, 3, 5, 6, 11 }
+};
+
+/**
+ * The P permutation (1-based positions).
+ */
+static const unsigned char permutation[32] = {
+    16, 7, 20, 21, 29, 12, 28, 17, 1, 15, 23, 26, 5, 18, 31, 10,
+    2, 8, 24, 14, 32, 27, 3, 9, 19, 13, 30, 6, 22, 11, 4, 25
+};
+
+/**
+ * Permuted choice 1 (1-based positions of the 64-bit key).
+ */
+static const unsigned char permutedChoice1[56] = {
+    57, 49, 41, 33, 25, 17, 9, 1, 58, 50, 42, 34, 26, 18,
+    10, 2, 59, 51, 43, 35, 27, 19, 11, 3, 60, 52, 44, 36,
+    63, 55, 47, 39, 31, 23, 15, 7, 62, 54, 46, 38, 30, 22,
+    14, 6, 61, 53, 45, 37, 29, 21, 13, 5, 28, 20, 12, 4
+};
+
+/**
+ * Permuted choice 2 (1-based positions of the 56-bit C/D register).
+ */
+static const unsigned char permutedChoice2[48] = {
+    14, 17, 11, 24, 1, 5, 3, 28, 15, 6, 21, 10,
+    23, 19, 12, 4, 26, 8, 16, 7, 27, 20, 13, 2,
+    41, 52, 31, 37, 47, 55, 30, 40, 51, 45, 33, 48,
+    44, 49, 39, 56, 34, 53, 46, 42, 50, 36, 29, 32
+};
+
+/**
+ * Number of left rotations of C and D before each round.
+ */
+static const unsigned char keyShifts[16] = {
+    1, 1, 2, 2, 2, 2, 2, 2, 1, 2, 2, 2, 2, 2, 2, 1
+};
+
+/**
+ * Bit offset of the 6-bit field of each S-box inside its round key word
+ * (S1, S3, S5, S7 in the first word; S2, S4, S6, S8 in the second one).
+ */
+static const unsigned char fieldShifts[8] = {
+    0, 0, 24, 24, 16, 16, 8, 8
+};
+
+/**
+ * The SP-boxes: for every S-box and 6-bit input, the S-box output already
+ * moved through the P permutation.
+ */
+static uint32_t spBoxes[8][64];
+
+/**
+ * For every key position (0 being position 1), the round key bits it feeds.
+ * The key schedule only moves bits around, so the round keys of any key are
+ * the XOR of the rows of its set bits.
+ */
+static uint32_t keyBitRoundKeys[64][32];
+
+/**
+ * Runs the textbook key schedule (PC-1, rotations, PC-2) and stores the round
+ * keys in the layout used by the rounds. Only used to build keyBitRoundKeys.
+ * 
+ * @param key The 64-bit DES key.
+ * @param roundKeys Receives the 32 round key words.
+ */
+static void computeRoundKeys(uint64_t key, uint32_t* roundKeys)
+{
+    // split the key into C and D through PC-1.
+    uint32_t c = 0, d = 0;
+    for (int i = 0; i < 28; i++) {
+        c = (c << 1) | ((key >> (64 - permutedChoice1[i])) & 1);
+        d = (d << 1) | ((key >> (64 - permutedChoice1[28 + i])) & 1);
+    }
+    
+    for (int round = 0; round < 16; round++) {
+        // rotate both 28-bit halves.
+        for (int shift = 0; shift < keyShifts[round]; shift++) {
+            c = ((c << 1) | (c >> 27)) & 0x0FFFFFFF;
+            d = ((d << 1) | (d >> 27)) & 0x0FFFFFFF;
+        }
+        
+        // select the 48 round key bits through PC-2.
+        uint64_t cd = ((uint64_t) c << 28) | d;
+        uint64_t roundKey = 0;
+        for (int i = 0; i < 48; i++) {
+            roundKey = (roundKey << 1) | ((cd >> (56 - permutedChoice2[i])) & 1);
+        }
+        
+        // spread the 6-bit groups over the two words of the round.
+        roundKeys[2 * round] = 0;
+        roundKeys[2 * round + 1] = 0;
+        for (int box = 0; box < 8; box++) {
+            uint32_t field = (uint32_t) (roundKey >> (42 - 6 * box)) & 63;
+            roundKeys[2 * round + (box & 1)] |= field << fieldShifts[box];
+        }
+    }
+}
+
+/**
+ * Builds the SP-boxes and the key bit mapping once, when the program is
+ * loaded.
+ */
+static struct TableBuilder
+{
+    TableBuilder()
+    {
+        for (int box = 0; box < 8; box++) {
+            for (int input = 0; input < 64; input++) {
+                // the outer bits select the row, the inner ones the column.
+                int row = ((input >> 4) & 2) | (input & 1);
+                int column = (input >> 1) & 15;
+                uint32_t output = (uint32_t) sBoxes[box][row * 16 + column] << (28 - 4 * box);
+                
+                // apply P to the S-box output.
+                uint32_t permuted = 0;
+                for (int i = 0; i < 32; i++) {
+                    permuted |= ((output >> (32 - permutation[i])) & 1) << (31 - i);
+                }
+                spBoxes[box][input] = permuted;
+            }
+        }
+        
+        // the round keys of every single-bit key.
+        for (int position = 0; position < 64; position++) {
+            computeRoundKeys(1ULL << (63 - position), keyBitRoundKeys[position]);
+        }
+    }
+} tableBuilder;
+
+/**
+ * Rotates a 32-bit word to the left.
+ */
+static inline uint32_t rotateLeft(uint32_t word, int count)
+{
+    return (word << count) | (word >> (32 - count));
+}
+
+/**
+ * Swaps the bits of b selected by mask with the bits of a selected by
+ * mask << shift; IP and FP are sequences of such swaps.
+ */
+static inline void swapBits(uint32_t& a, uint32_t& b, int shift, uint32_t mask)
+{
+    uint32_t t = ((a >> shift) ^ b) & mask;
+    b ^= t;
+    a ^= t << shift;
+}
+
+/**
+ * The DES round function f(r, k): expansion, key mixing, S-boxes and P. The
+ * round key words are laid out so that every S-box input is a 6-bit field of
+ * a rotation of r.
+ * 
+ * @param key The two round key words of the round.
+ */
+static inline uint32_t feistel(uint32_t r, const uint32_t* key)
+{
+    uint32_t z = rotateLeft(r, 5) ^ key[0];
+    uint32_t w = rotateLeft(r, 9) ^ key[1];
+    return spBoxes[0][z & 63] ^ spBoxes[6][(z >> 8) & 63] ^ spBoxes[4][(z >> 16) & 63] ^ spBoxes[2][(z >> 24) & 63]
+        ^ spBoxes[1][w & 63] ^ spBoxes[7][(w >> 8) & 63] ^ spBoxes[5][(w >> 16) & 63] ^ spBoxes[3][(w >> 24) & 63];
+}
+
+/**
+ * Constructor method of the class. The key is all zeros until setKey is
+ * called.
+ */
+DESCore::DESCore()
+{
+    this->setKey(0);
+}
+
+/**
+ * Computes the 16 round keys of the given key from the precomputed key bit to
+ * round key bit mapping.
+ * 
+ * @param key The 64-bit DES key.
+ */
+void DESCore::setKey(uint64_t key)
+{
+    memset(this->roundKeys, 0, sizeof(this->roundKeys));
+    this->key = 0;
+    this->updateKey(key);
+}
+
+/**
+ * Switches to another key by toggling only the round key bits that are fed by
+ * the key bits that differ from the current key.
+ * 
+ * @param key The new 64-bit DES key.
+ */
+void DESCore::updateKey(uint64_t key)
+{
+    for (uint64_t changed = this->key ^ key; 0 != changed; changed &= changed - 1) {
+        const uint32_t* row = keyBitRoundKeys[63 - __builtin_ctzll(changed)];
+        for (int i = 0; i < 32; i++) {
+            this->roundKeys[i] ^= row[i];
+        }
+    }
+    this->key = key;
+}
+
+/**
+ * Returns the current key.
+ */
+uint64_t DESCore::getKey()
+{
+    return this->key;
+}
+
+/**
+ * Runs IP, the 16 rounds and FP on one block.
+ * 
+ * @param decrypt Whether the round keys are used in reverse order.
+ */
+void DESCore::cryptBlock(const unsigned char* input, unsigned char* output, bool decrypt)
+{
+    uint32_t l = ((uint32_t) input[0] << 24) | ((uint32_t) input[1] << 16) | ((uint32_t) input[2] << 8) | input[3];
+    uint32_t r = ((uint32_t) input[4] << 24) | ((uint32_t) input[5] << 16) | ((uint32_t) input[6] << 8) | input[7];
+    
+    // initial permutation.
+    swapBits(l, r, 4, 0x0F0F0F0F);
+    swapBits(l, r, 16, 0x0000FFFF);
+    swapBits(r, l, 2, 0x33333333);
+    swapBits(r, l, 8, 0x00FF00FF);
+    swapBits(l, r, 1, 0x55555555);
+    
+    const uint32_t* key = decrypt ? &this->roundKeys[30] : &this->roundKeys[0];
+    const int step = decrypt ? -2 : 2;
+    for (int round = 0; round < 16; round += 2) {
+        l ^= feistel(r, key);
+        key += step;
+        r ^= feistel(l, key);
+        key += step;
+    }
+    
+    // final permutation of R16 L16 (the inverse swap sequence).
+    swapBits(r, l, 1, 0x55555555);
+    swapBits(l, r, 8, 0x00FF00FF);
+    swapBits(l, r, 2, 0x33333333);
+    swapBits(r, l, 16, 0x0000FFFF);
+    swapBits(r, l, 4, 0x0F0F0F0F);
+    
+    output[0] = (unsigned char) (r >> 24);
+    output[1] = (unsigned char) (r >> 16);
+    output[2] = (unsigned char) (r >> 8);
+    output[3] = (unsigned char) r;
+    output[4] = (unsigned char) (l >> 24);
+    output[5] = (unsigned char) (l >> 16);
+    output[6] = (unsigned char) (l >> 8);
+    output[7] = (unsigned char) l;
+}
+
+/**
+ * Runs the 16 rounds on a block that is already through IP and tells whether
+ * the result before FP matches the expected block on the masked bits.
+ * 
+ * The left half of the result (L16) is final after the 15th round, so the
+ * last round is only run for the keys that pass that half.
+ * 
+ * @param ipInput The input block after IP.
+ * @param ipExpected The expected output block after IP (R16 followed by L16).
+ * @param ipMask The bits of ipExpected that have to match, after IP.
+ * @param decrypt Whether the round keys are used in reverse order.
+ * @return Whether the masked bits of the result match.
+ */
+bool DESCore::testBlock(uint64_t ipInput, uint64_t ipExpected, uint64_t ipMask, bool decrypt)
+{
+    uint32_t l = (uint32_t) (ipInput >> 32);
+    uint32_t r = (uint32_t) ipInput;
+    
+    const uint32_t* key = decrypt ? &this->roundKeys[30] : &this->roundKeys[0];
+    const int step = decrypt ? -2 : 2;
+    for (int round = 0; round < 14; round += 2) {
+        l ^= feistel(r, key);
+        key += step;
+        r ^= feistel(l, key);
+        key += step;
+    }
+    
+    l ^= feistel(r, key);
+    if (0 != ((l ^ (uint32_t) ipExpected) & (uint32_t) ipMask)) {
+        return false;
+    }
+    r ^= feistel(l, key + step);
+    
+    return 0 == ((r ^ (uint32_t) (ipExpected >> 32)) & (uint32_t) (ipMask >> 32));
+}
+
+/**
+ * Applies IP to a block given as a big-endian 64-bit word.
+ */
+uint64_t DESCore::initialPermutation(uint64_t block)
+{
+    uint32_t l = (uint32_t) (block >> 32);
+    uint32_t r = (uint32_t) block;
+    
+    swapBits(l, r, 4, 0x0F0F0F0F);
+    swapBits(l, r, 16, 0x0000FFFF);
+    swapBits(r, l, 2, 0x33333333);
+    swapBits(r, l, 8, 0x00FF00FF);
+    swapBits(l, r, 1, 0x55555555);
+    
+    return ((uint64_t) l << 32) | r;
+}
+
+/**
+ * Encrypts a single 8-byte block. The input and output may overlap.
+ */
+void DESCore::encryptBlock(const unsigned char* input, unsigned char* output)
+{
+    this->cryptBlock(input, output, false);
+}
+
+/**
+ * Decrypts a single 8-byte block. The input and output may overlap.
+ */
+void DESCore::decryptBlock(const unsigned char* input, unsigned char* output)
+{
+    this->cryptBlock(input, output, true);
+}
+
+/**
+ * Encrypts a buffer block by block (ECB).
+ * 
+ * @param length Length of the buffer; whole blocks only.
+ */
+void DESCore::encrypt(const unsigned char* input, unsigned char* output, size_t length)
+{
+    for (size_t offset = 0; offset + 8 <= length; offset += 8) {
+        this->cryptBlock(input + offset, output + offset, false);
+    }
+}
+
+/**
+ * Decrypts a buffer block by block (ECB).
+ * 
+ * @param length Length of the buffer; whole blocks only.
+ */
+void DESCore::decrypt(const unsigned char* input, unsigned char* output, size_t length)
+{
+    for (size_t offset = 0; offset + 8 <= length; offset += 8) {
+        this->cryptBlock(input + offset, output + offset, true);
+    }
+}
+
+/**
+ * Converts a key string ('0'/'1' characters, the first one being key position
+ * 1) to a 64-bit DES key. Positions beyond keyLength are 0.
+ */
+uint64_t DESCore::keyFromString(const char* key, int keyLength)
+{
+    uint64_t result = 0;
+    for (int i = 0; i < 64; i++) {
+        result = (result << 1) | ((i < keyLength && '1' == key[i]) ? 1 : 0);
+    }
+    return result;
+}
@@ -0,0 +1,141 @@
+/**
+ * File: DESCore.h
+ * 
+ * Header file for the DESCore class.
+ * 
+ * @version 0.1
+ */
+
+// make sure that the signature of the class is defined only once.
+#ifndef DESCORE_H
+#define	DESCORE_H
+
+// include the fixed-width integer types.
+#include <stdint.h>
+
+// include the size_t type.
+#include <stddef.h>
+
+/**
+ * Signature of the DESCore class.
+ * 
+ * DESCore is a conventional word-oriented DES implementation: the block is
+ * kept in two 32-bit halves, IP and FP are done with a handful of bit-swap
+ * steps and each round is eight lookups into combined S-box/P-permutation
+ * tables (SP-boxes). It works on byte buffers directly and is the reference
+ * the faster engines are checked against.
+ * 
+ * Keys are 64-bit DES keys with position 1 in the most significant bit; the
+ * parity bits (positions 8, 16, ..., 64) are ignored.
+ * 
+ * @since version 0.1
+ * @see AlgorithmDES
+ */
+class DESCore
+{
+    // public attributes and methods of the class.
+    public:
+        
+        /**
+         * Constructor method of the class. The key is all zeros until setKey
+         * is called.
+         */
+        DESCore();
+        
+        /**
+         * Computes the 16 round keys of the given key from the precomputed
+         * key bit to round key bit mapping.
+         * 
+         * @param key The 64-bit DES key.
+         */
+        void setKey(uint64_t key);
+        
+        /**
+         * Switches to another key by toggling only the round key bits that
+         * are fed by the key bits that differ from the current key. Stepping
+         * through consecutive candidates changes two key bits on average, so
+         * this is much cheaper than setKey.
+         * 
+         * @param key The new 64-bit DES key.
+         */
+        void updateKey(uint64_t key);
+        
+        /**
+         * Returns the current key.
+         */
+        uint64_t getKey();
+        
+        /**
+         * Encrypts a single 8-byte block. The input and output may overlap.
+         */
+        void encryptBlock(const unsigned char* input, unsigned char* output);
+        
+        /**
+         * Decrypts a single 8-byte block. The input and output may overlap.
+         */
+        void decryptBlock(const unsigned char* input, unsigned char* output);
+        
+        /**
+         * Runs the 16 rounds on a block that is already through IP and tells
+         * whether the result before FP matches the expected block on the
+         * masked bits. Candidate keys are rejected without FP, and almost
+         * always without the last round.
+         * 
+         * @param ipInput The input block after IP.
+         * @param ipExpected The expected output block after IP.
+         * @param ipMask The bits of ipExpected that have to match, after IP.
+         * @param decrypt Whether the round keys are used in reverse order.
+         * @return Whether the masked bits of the result match.
+         */
+        bool testBlock(uint64_t ipInput, uint64_t ipExpected, uint64_t ipMask, bool decrypt);
+        
+        /**
+         * Encrypts a buffer block by block (ECB).
+         * 
+         * @param length Length of the buffer; whole blocks only.
+         */
+        void encrypt(const unsigned char* input, unsigned char* output, size_t length);
+        
+        /**
+         * Decrypts a buffer block by block (ECB).
+         * 
+         * @param length Length of the buffer; whole blocks only.
+         */
+        void decrypt(const unsigned char* input, unsigned char* output, size_t length);
+        
+        /**
+         * Applies IP to a block given as a big-endian 64-bit word. IP is a
+         * bit permutation, so it also maps byte masks to the permuted domain.
+         */
+        static uint64_t initialPermutation(uint64_t block);
+        
+        /**
+         * Converts a key string ('0'/'1' characters, the first one being key
+         * position 1) to a 64-bit DES key. Positions beyond keyLength are 0.
+         */
+        static uint64_t keyFromString(const char* key, int keyLength);
+        
+    // private attributes and methods of the class.
+    private:
+        
+        /**
+         * The current key.
+         */
+        uint64_t key;
+        
+        /**
+         * The round keys, two words per round laid out for the SP-box
+         * lookups (see DESCore.cpp).
+         */
+        uint32_t roundKeys[32];
+        
+        /**
+         * Runs IP, the 16 rounds and FP on one block.
+         * 
+         * @param decrypt Whether the round keys are used in reverse order.
+         */
+        void cryptBlock(const unsigned char* input, unsigned char* output, bool decrypt);
+};
+
+// end of the class signature.
+#endif	/* DESCORE_H */
@@ -0,0 +1,414 @@
+/**
+ * File: FileCipher.cpp
+ * 
+ * Source code file for the FileCipher class.
+ * 
+ * @version 0.1
+ */
+
+// include standard libraries.
+#include <stdlib.h>
+
+// include the string library.
+#include <string.h>
+
+// include the file libraries.
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// include the signature of the class.
+#include "FileCipher.h"
+
+// include the ThreadedSearch class signature for the number of cores.
+#include "ThreadedSearch.h"
+
+// include the Logger class signature.
+#include "Logger.h"
+
+/**
+ * Reads a block from 8 bytes, most significant byte first.
+ */
+static uint64_t loadBlock(const unsigned char* bytes)
+{
+    uint64_t block = 0;
+    for (int i = 0; i < 8; i++) {
+        block = (block << 8) | bytes[i];
+    }
+    return block;
+}
+
+/**
+ * Constructor method of the class.
+ * 
+ * @param mode ECB or CBC.
+ * @param decrypt Whether to decrypt instead of encrypt.
+ * @param key The 64-bit DES key.
+ * @param iv The initialization vector of CBC.
+ * @param numberOfWorkers Number of workers; 0 means one per core.
+ * @param chunkSize Bytes in a chunk, rounded down to whole blocks.
+ */
+FileCipher::FileCipher(CipherStream::Mode mode, bool decrypt, uint64_t key, uint64_t iv, int numberOfWorkers, size_t chunkSize)
+{
+    this->mode = mode;
+    this->decrypting = decrypt;
+    this->key = key;
+    this->iv = iv;
+    this->numberOfWorkers = (0 < numberOfWorkers) ? numberOfWorkers : ThreadedSearch::getNumberOfCores();
+    if (CipherStream::CBC == mode && ! decrypt) {
+        this->numberOfWorkers = 1;
+    }
+    this->chunkSize = (8 < chunkSize) ? chunkSize - chunkSize % 8 : 8;
+    this->input = NULL;
+    this->numberOfChunks = 0;
+    this->readerDone = false;
+    this->chain = iv;
+    this->failed = false;
+    this->bytesRead = 0;
+    this->bytesWritten = 0;
+    pthread_mutex_init(&this->mutex, NULL);
+    pthread_cond_init(&this->condition, NULL);
+    
+    // the buffers take the padding block a last chunk may add; they are
+    // page aligned, as the kernel copies from them fastest.
+    size_t pageSize = (size_t) sysconf(_SC_PAGESIZE);
+    this->chunks.resize(2 * this->numberOfWorkers + 2);
+    for (size_t i = 0; i < this->chunks.size(); i++) {
+        void* buffer = NULL;
+        if (0 != posix_memalign(&buffer, pageSize, this->chunkSize + 8)) {
+            buffer = NULL;
+        }
+        this->chunks[i].buffer = (unsigned char*) buffer;
+    }
+}
+
+/**
+ * Destructor method of the class; frees the buffers.
+ */
+FileCipher::~FileCipher()
+{
+    for (size_t i = 0; i < this->chunks.size(); i++) {
+        free(this->chunks[i].buffer);
+    }
+    pthread_cond_destroy(&this->condition);
+    pthread_mutex_destroy(&this->mutex);
+}
+
+/**
+ * Encrypts or decrypts the input file into the output file, which is created
+ * or truncated; if it is a regular file, it is removed again if anything
+ * fails. The reader and the workers run in threads of their own, and the
+ * writer in this one.
+ * 
+ * @return Whether the whole file was written; false on an error, which is
+ * logged, or on invalid padding.
+ */
+bool FileCipher::run(const std::string& inputPath, const std::string& outputPath)
+{
+    for (size_t i = 0; i < this->chunks.size(); i++) {
+        if (NULL == this->chunks[i].buffer) {
+            Logger::writeToLogFile("ERROR: Can't allocate the buffers of the file cipher!");
+            return false;
+        }
+    }
+    MappedFile input;
+    if (! input.open(inputPath)) {
+        Logger::writeToLogFile("ERROR: Can't map the input file %s!", inputPath);
+        return false;
+    }
+    input.adviseSequential();
+    this->input = &input;
+    
+    int output = open(outputPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (0 > output) {
+        Logger::writeToLogFile("ERROR: Can't create the output file %s!", outputPath);
+        return false;
+    }
+    
+    // only a regular file is removed on a failure; the output may as well
+    // be a device or a pipe.
+    struct stat status;
+    bool regular = (0 == fstat(output, &status) && S_ISREG(status.st_mode));
+    
+    // an empty file is a chunk too: it still gets (or lacks) the padding.
+    size_t size = input.getSize();
+    this->numberOfChunks = (0 < size) ? (size + this->chunkSize - 1) / this->chunkSize : 1;
+    this->freeChunks.clear();
+    for (size_t i = 0; i < this->chunks.size(); i++) {
+        this->chunks[i].done = false;
+        this->freeChunks.push_back(&this->chunks[i]);
+    }
+    this->readyChunks.clear();
+    this->readerDone = false;
+    this->chain = this->iv;
+    this->failed = false;
+    this->bytesRead = 0;
+    this->bytesWritten = 0;
+    
+    std::vector<Stage> stages(1 + this->numberOfWorkers);
+    std::vector<bool> started(stages.size(), false);
+    for (size_t i = 0; i < stages.size(); i++) {
+        stages[i].cipher = this;
+        started[i] = (0 == pthread_create(&stages[i].thread, NULL, (0 == i) ? FileCipher::readerMain : FileCipher::workerMain, &stages[i]));
+        if (! started[i]) {
+            Logger::writeToLogFile("ERROR: Can't create a thread of the file cipher!");
+            this->fail();
+            break;
+        }
+    }
+    
+    bool written = ! this->failed && this->write(output);
+    
+    for (size_t i = 0; i < stages.size(); i++) {
+        if (started[i]) {
+            pthread_join(stages[i].thread, NULL);
+        }
+    }
+    
+    this->input = NULL;
+    if (0 != close(output)) {
+        written = false;
+    }
+    if (! written || this->failed) {
+        if (regular) {
+            unlink(outputPath.c_str());
+        }
+        return false;
+    }
+    
+    return true;
+}
+
+/**
+ * Returns the number of bytes the last run read.
+ */
+uint64_t FileCipher::getBytesRead()
+{
+    return this->bytesRead;
+}
+
+/**
+ * Returns the number of bytes the last run wrote.
+ */
+uint64_t FileCipher::getBytesWritten()
+{
+    return this->bytesWritten;
+}
+
+/**
+ * Returns the number of workers.
+ */
+int FileCipher::getNumberOfWorkers()
+{
+    return this->numberOfWorkers;
+}
+
+/**
+ * Reads a block of 16 hex digits, a key or an initialization vector.
+ * 
+ * @return Whether the text was 16 hex digits.
+ */
+bool FileCipher::parseBlock(const char* text, uint64_t& block)
+{
+    if (16 != strlen(text) || 16 != strspn(text, "0123456789abcdefABCDEF")) {
+        return false;
+    }
+    block = strtoull(text, NULL, 16);
+    return true;
+}
+
+/**
+ * Hands the chunks out, in order, as buffers are free. Before a chunk is
+ * handed out, the kernel is asked to read the next one in, so that the
+ * workers rarely wait for the disk.
+ */
+void FileCipher::read()
+{
+    for (uint64_t sequence = 0; sequence < this->numberOfChunks; sequence++) {
+        size_t offset = sequence * this->chunkSize;
+        this->input->prefetch(offset + this->chunkSize, this->chunkSize);
+        
+        pthread_mutex_lock(&this->mutex);
+        while (! this->failed && this->freeChunks.empty()) {
+            pthread_cond_wait(&this->condition, &this->mutex);
+        }
+        if (this->failed) {
+            pthread_mutex_unlock(&this->mutex);
+            return;
+        }
+        Chunk* chunk = this->freeChunks.back();
+        this->freeChunks.pop_back();
+        
+        chunk->sequence = sequence;
+        chunk->offset = offset;
+        chunk->length = (this->input->getSize() - offset < this->chunkSize) ? this->input->getSize() - offset : this->chunkSize;
+        chunk->written = 0;
+        chunk->last = (sequence + 1 == this->numberOfChunks);
+        chunk->done = false;
+        this->readyChunks.push_back(chunk);
+        pthread_cond_broadcast(&this->condition);
+        pthread_mutex_unlock(&this->mutex);
+    }
+    
+    pthread_mutex_lock(&this->mutex);
+    this->readerDone = true;
+    pthread_cond_broadcast(&this->condition);
+    pthread_mutex_unlock(&this->mutex);
+}
+
+/**
+ * Encrypts or decrypts the chunks handed out until there are none left. A
+ * CBC chunk is chained to the last block before it: in the input when
+ * decrypting, in the output of the chunk before when encrypting, which the
+ * single worker did just before.
+ */
+void FileCipher::work()
+{
+    const unsigned char* data = (const unsigned char*) this->input->getData();
+    const bool chained = (CipherStream::CBC == this->mode);
+    
+    for (;;) {
+        pthread_mutex_lock(&this->mutex);
+        while (! this->failed && ! this->readerDone && this->readyChunks.empty()) {
+            pthread_cond_wait(&this->condition, &this->mutex);
+        }
+        if (this->failed || this->readyChunks.empty()) {
+            pthread_mutex_unlock(&this->mutex);
+            return;
+        }
+        Chunk* chunk = this->readyChunks.front();
+        this->readyChunks.pop_front();
+        pthread_mutex_unlock(&this->mutex);
+        
+        uint64_t chainBlock = this->iv;
+        if (chained && 0 < chunk->offset) {
+            chainBlock = this->decrypting ? loadBlock(data + chunk->offset - 8) : this->chain;
+        }
+        bool valid = this->crypt(*chunk, chainBlock);
+        if (chained && ! this->decrypting && 8 <= chunk->written) {
+            this->chain = loadBlock(chunk->buffer + chunk->written - 8);
+        }
+        
+        if (! valid) {
+            Logger::writeToLogFile(this->decrypting ? "ERROR: The input file isn't whole blocks or its padding is invalid!" : "ERROR: A chunk isn't whole blocks!");
+            this->fail();
+            return;
+        }
+        
+        pthread_mutex_lock(&this->mutex);
+        chunk->done = true;
+        pthread_cond_broadcast(&this->condition);
+        pthread_mutex_unlock(&this->mutex);
+    }
+}
+
+/**
+ * Encrypts or decrypts a chunk into its buffer. Only the last chunk is
+ * padded; the others are whole blocks.
+ * 
+ * @return Whether the chunk was whole blocks and, if it is the last one,
+ * ended in valid padding.
+ */
+bool FileCipher::crypt(Chunk& chunk, uint64_t chainBlock)
+{
+    CipherStream stream(this->mode, this->decrypting, this->key, chainBlock);
+    stream.setPadding(chunk.last);
+    
+    const unsigned char* data = (const unsigned char*) this->input->getData() + chunk.offset;
+    size_t last;
+    chunk.written = stream.update(data, chunk.length, chunk.buffer);
+    bool valid = stream.finish(chunk.buffer + chunk.written, last);
+    chunk.written += last;
+    
+    return valid;
+}
+
+/**
+ * Writes the chunks out in order as they are done, and hands their buffers
+ * back to the reader.
+ * 
+ * @param output The descriptor of the output file.
+ * @return Whether every chunk was written.
+ */
+bool FileCipher::write(int output)
+{
+    for (uint64_t sequence = 0; sequence < this->numberOfChunks; sequence++) {
+        // the chunk is in one of the buffers once the reader handed it out.
+        Chunk* chunk = NULL;
+        pthread_mutex_lock(&this->mutex);
+        while (! this->failed) {
+            for (size_t i = 0; NULL == chunk && i < this->chunks.size(); i++) {
+                Chunk& candidate = this->chunks[i];
+                if (candidate.done && sequence == candidate.sequence) {
+                    chunk = &candidate;
+                }
+            }
+            if (NULL != chunk) {
+                break;
+            }
+            pthread_cond_wait(&this->condition, &this->mutex);
+        }
+        pthread_mutex_unlock(&this->mutex);
+        if (NULL == chunk) {
+            return false;
+        }
+        
+        size_t done = 0;
+        while (done < chunk->written) {
+            ssize_t count = ::write(output, chunk->buffer + done, chunk->written - done);
+            if (0 > count && EINTR == errno) {
+                continue;
+            }
+            if (0 >= count) {
+                Logger::writeToLogFile("ERROR: Can't write the output file: %s!", std::string(strerror(errno)));
+                this->fail();
+                return false;
+            }
+            done += count;
+        }
+        this->bytesRead += chunk->length;
+        this->bytesWritten += chunk->written;
+        
+        pthread_mutex_lock(&this->mutex);
+        chunk->done = false;
+        this->freeChunks.push_back(chunk);
+        pthread_cond_broadcast(&this->condition);
+        pthread_mutex_unlock(&this->mutex);
+    }
+    
+    return true;
+}
+
+/**
+ * Marks the run as failed and wakes every stage up.
+ */
+void FileCipher::fail()
+{
+    pthread_mutex_lock(&this->mutex);
+    this->failed = true;
+    pthread_cond_broadcast(&this->condition);
+    pthread_mutex_unlock(&this->mutex);
+}
+
+/**
+ * Entry point of the thread of the reader.
+ * 
+ * @param stage Pointer to the Stage.
+ */
+void* FileCipher::readerMain(void* stage)
+{
+    ((Stage*) stage)->cipher->read();
+    return NULL;
+}
+
+/**
+ * Entry point of the thread of a worker.
+ * 
+ * @param stage Pointer to the Stage.
+ */
+void* FileCipher::workerMain(void* stage)
+{
+    ((Stage*) stage)->cipher->work();
+    return NULL;
+}
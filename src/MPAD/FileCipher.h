@@ -0,0 +1,241 @@
+/**
+ * File: FileCipher.h
+ * 
+ * Header file for the FileCipher class.
+ * 
+ * @version 0.1
+ */
+
+// make sure that the signature of the class is defined only once.
+#ifndef FILECIPHER_H
+#define	FILECIPHER_H
+
+// include the string library for the std::string class.
+#include <string>
+
+// include the vector and deque libraries.
+#include <vector>
+#include <deque>
+
+// include the POSIX threads library.
+#include <pthread.h>
+
+// include the fixed-width integer types.
+#include <stdint.h>
+
+// include the CipherStream class signature.
+#include "CipherStream.h"
+
+// include the MappedFile class signature.
+#include "MappedFile.h"
+
+/**
+ * Signature of the FileCipher class.
+ * 
+ * FileCipher encrypts or decrypts a file of any size with DES in ECB or CBC
+ * mode (PKCS#5 padded, as CipherStream does it) in three stages that run at
+ * the same time:
+ * 
+ *   - the reader walks the mapped input file a chunk at a time, asks the
+ *     kernel to read each chunk in, and hands it out with a free buffer,
+ *   - the workers encrypt or decrypt the chunks, straight from the mapping
+ *     into their buffers, each with a CipherStream of its own,
+ *   - the writer (the thread that calls run) writes the buffers out in the
+ *     order of the chunks and hands them back to the reader.
+ * 
+ * The buffers are page aligned and allocated once; there are two per worker
+ * and two more, so a slow stage holds the others up instead of piling up
+ * memory. It is started with
+ * 
+ *     main_p encrypt|decrypt ecb|cbc <key> <iv> <input> <output> [workers]
+ * 
+ * where the key and the initialization vector are 16 hex digits each.
+ * 
+ * In ECB mode and when decrypting CBC, the chunks don't depend on each other
+ * (a CBC chunk is chained to the last block of the one before, which is in
+ * the input), so they run on all the workers. Encrypting CBC chains every
+ * chunk to the output of the one before, and runs on a single worker.
+ * 
+ * @since version 0.1
+ * @see CipherStream
+ * @see MappedFile
+ */
+class FileCipher
+{
+    // public attributes and methods of the class.
+    public:
+        
+        /**
+         * Bytes in a chunk, unless told otherwise.
+         */
+        static const size_t defaultChunkSize = 1 << 20;
+        
+        /**
+         * Constructor method of the class.
+         * 
+         * @param mode ECB or CBC.
+         * @param decrypt Whether to decrypt instead of encrypt.
+         * @param key The 64-bit DES key.
+         * @param iv The initialization vector of CBC.
+         * @param numberOfWorkers Number of workers; 0 means one per core.
+         * @param chunkSize Bytes in a chunk, rounded down to whole blocks.
+         */
+        FileCipher(CipherStream::Mode mode, bool decrypt, uint64_t key, uint64_t iv, int numberOfWorkers, size_t chunkSize = FileCipher::defaultChunkSize);
+        
+        /**
+         * Destructor method of the class; frees the buffers.
+         */
+        ~FileCipher();
+        
+        /**
+         * Encrypts or decrypts the input file into the output file, which is
+         * created or truncated; if it is a regular file, it is removed again
+         * if anything fails.
+         * 
+         * @return Whether the whole file was written; false on an error,
+         * which is logged, or on invalid padding.
+         */
+        bool run(const std::string& inputPath, const std::string& outputPath);
+        
+        /**
+         * Returns the number of bytes the last run read and wrote.
+         */
+        uint64_t getBytesRead();
+        uint64_t getBytesWritten();
+        
+        /**
+         * Returns the number of workers.
+         */
+        int getNumberOfWorkers();
+        
+        /**
+         * Reads a block of 16 hex digits, a key or an initialization vector.
+         * 
+         * @return Whether the text was 16 hex digits.
+         */
+        static bool parseBlock(const char* text, uint64_t& block);
+    
+    // private attributes and methods of the class.
+    private:
+        
+        /**
+         * A chunk of the input and the buffer its output goes to.
+         */
+        struct Chunk
+        {
+            unsigned char* buffer;
+            uint64_t sequence;
+            size_t offset;
+            size_t length;
+            size_t written;
+            bool last;
+            bool done;
+        };
+        
+        /**
+         * What a stage thread is given.
+         */
+        struct Stage
+        {
+            FileCipher* cipher;
+            pthread_t thread;
+        };
+        
+        /**
+         * The mode, the direction and the key.
+         */
+        CipherStream::Mode mode;
+        bool decrypting;
+        uint64_t key;
+        uint64_t iv;
+        
+        /**
+         * The number of workers, and the bytes in a chunk.
+         */
+        int numberOfWorkers;
+        size_t chunkSize;
+        
+        /**
+         * The chunks, one per buffer; the ones the reader may fill, and the
+         * ones waiting for a worker, in order.
+         */
+        std::vector<Chunk> chunks;
+        std::vector<Chunk*> freeChunks;
+        std::deque<Chunk*> readyChunks;
+        
+        /**
+         * The input file of the run, the number of chunks it is split into,
+         * and whether the reader is done with it.
+         */
+        MappedFile* input;
+        uint64_t numberOfChunks;
+        bool readerDone;
+        
+        /**
+         * The last block of the output so far, which the next chunk is
+         * chained to when encrypting CBC.
+         */
+        uint64_t chain;
+        
+        /**
+         * Whether a stage failed, and the counts of the last run.
+         */
+        bool failed;
+        uint64_t bytesRead;
+        uint64_t bytesWritten;
+        
+        /**
+         * What every stage waits on.
+         */
+        pthread_mutex_t mutex;
+        pthread_cond_t condition;
+        
+        /**
+         * Hands the chunks out, in order, as buffers are free.
+         */
+        void read();
+        
+        /**
+         * Encrypts or decrypts the chunks handed out until there are none
+         * left.
+         */
+        void work();
+        
+        /**
+         * Encrypts or decrypts a chunk into its buffer.
+         * 
+         * @return Whether the chunk was whole blocks and, if it is the last
+         * one, ended in valid padding.
+         */
+        bool crypt(Chunk& chunk, uint64_t chainBlock);
+        
+        /**
+         * Writes the chunks out in order as they are done.
+         * 
+         * @param output The descriptor of the output file.
+         * @return Whether every chunk was written.
+         */
+        bool write(int output);
+        
+        /**
+         * Marks the run as failed and wakes every stage up.
+         */
+        void fail();
+        
+        /**
+         * Entry points of the threads of the reader and the workers.
+         * 
+         * @param stage Pointer to the Stage.
+         */
+        static void* readerMain(void* stage);
+        static void* workerMain(void* stage);
+        
+        /**
+         * Copying would free the buffers twice.
+         */
+        FileCipher(const FileCipher&);
+        FileCipher& operator=(const FileCipher&);
+};
+
+// end of the class signature.
+#endif	/* FILECIPHER_H */
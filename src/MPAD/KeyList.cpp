@@ -0,0 +1,110 @@
+/**
+ * File: KeyList.cpp
+ * 
+ * Source code file for the KeyList class.
+ * 
+ * @version 0.1
+ */
+
+// include the string library.
+#include <string.h>
+
+// include the signature of the class.
+#include "KeyList.h"
+
+/**
+ * The value of every hex digit, and 16 for every other character.
+ */
+struct HexDigits
+{
+    unsigned char values[256];
+    
+    HexDigits()
+    {
+        memset(this->values, 16, sizeof(this->values));
+        for (int i = 0; i < 10; i++) {
+            this->values['0' + i] = i;
+        }
+        for (int i = 0; i < 6; i++) {
+            this->values['a' + i] = 10 + i;
+            this->values['A' + i] = 10 + i;
+        }
+    }
+};
+static const HexDigits hexDigits;
+
+/**
+ * Decodes a line of 16 hex digits and a newline. The digits are looked up in
+ * a table rather than told apart by comparisons, which the branch predictor
+ * can't guess for random keys; this is what lets the keys stream in at disk
+ * speed.
+ * 
+ * @return Whether the line is a valid key.
+ */
+static inline bool decodeKeyLine(const char* line, uint64_t& key)
+{
+    uint64_t value = 0;
+    unsigned int invalid = 0;
+    for (int i = 0; i < 16; i++) {
+        unsigned int digit = hexDigits.values[(unsigned char) line[i]];
+        invalid |= digit;
+        value = (value << 4) | (digit & 15);
+    }
+    key = value;
+    return 0 == (invalid & 16) && '\n' == line[16];
+}
+
+/**
+ * Maps the key file at the given path.
+ * 
+ * @return Whether the file could be mapped and is a whole number of lines.
+ */
+bool KeyList::open(const std::string& path)
+{
+    if (! this->file.open(path) || 0 != this->file.getSize() % KeyList::lineLength) {
+        return false;
+    }
+    this->file.adviseSequential();
+    
+    uint64_t key;
+    return 0 == this->file.getSize() || decodeKeyLine(this->file.getData(), key);
+}
+
+/**
+ * Returns the number of keys in the file.
+ */
+uint64_t KeyList::getNumberOfKeys() const
+{
+    return this->file.getSize() / KeyList::lineLength;
+}
+
+/**
+ * Decodes the key on the given line.
+ * 
+ * @param key Receives the key.
+ * @return Whether the line is a valid key.
+ */
+bool KeyList::getKey(uint64_t index, uint64_t& key) const
+{
+    return index < this->getNumberOfKeys() && decodeKeyLine(this->file.getData() + index * KeyList::lineLength, key);
+}
+
+/**
+ * Decodes the keys on consecutive lines; a line that isn't a valid key gives
+ * a key of zero, which getKey rules out when a match is confirmed. Lines past
+ * the end of the file give zeros, too.
+ * 
+ * @param first The first line.
+ * @param count Number of keys.
+ * @param keys Receives the keys.
+ */
+void KeyList::getKeys(uint64_t first, uint64_t count, uint64_t* keys) const
+{
+    const uint64_t numberOfKeys = this->getNumberOfKeys();
+    const char* line = this->file.getData() + first * KeyList::lineLength;
+    for (uint64_t i = 0; i < count; i++, line += KeyList::lineLength) {
+        if (first + i >= numberOfKeys || ! decodeKeyLine(line, keys[i])) {
+            keys[i] = 0;
+        }
+    }
+}
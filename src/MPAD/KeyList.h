@@ -0,0 +1,91 @@
+/**
+ * File: KeyList.h
+ * 
+ * Header file for the KeyList class.
+ * 
+ * @version 0.1
+ */
+
+// make sure that the signature of the class is defined only once.
+#ifndef KEYLIST_H
+#define	KEYLIST_H
+
+// include the string library for the std::string class.
+#include <string>
+
+// include the fixed-width integer types.
+#include <stdint.h>
+
+// include the MappedFile class signature.
+#include "MappedFile.h"
+
+/**
+ * Signature of the KeyList class.
+ * 
+ * KeyList is a file of candidate keys, searched instead of the keys of a key
+ * pattern: candidate i of the search is the key on line i of the file. Each
+ * line is a key of 16 hex digits followed by a newline, so a key is found
+ * by its index without reading the lines before it, and the file can be
+ * split into chunks of the key space like any other.
+ * 
+ * The file is mapped (see MappedFile), so the children of the main process
+ * share one copy of it, and it is read sequentially, so the kernel reads
+ * ahead and the keys stream in at disk speed.
+ * 
+ * @since version 0.1
+ * @see MappedFile
+ * @see AlgorithmDESBitslice
+ */
+class KeyList
+{
+    // public attributes and methods of the class.
+    public:
+        
+        /**
+         * Length of a line: 16 hex digits and a newline.
+         */
+        static const size_t lineLength = 17;
+        
+        /**
+         * Maps the key file at the given path.
+         * 
+         * @return Whether the file could be mapped and is a whole number of
+         * lines.
+         */
+        bool open(const std::string& path);
+        
+        /**
+         * Returns the number of keys in the file.
+         */
+        uint64_t getNumberOfKeys() const;
+        
+        /**
+         * Decodes the key on the given line.
+         * 
+         * @param key Receives the key.
+         * @return Whether the line is a valid key.
+         */
+        bool getKey(uint64_t index, uint64_t& key) const;
+        
+        /**
+         * Decodes the keys on consecutive lines; a line that isn't a valid
+         * key gives a key of zero, which getKey rules out when a match is
+         * confirmed.
+         * 
+         * @param first The first line.
+         * @param count Number of keys.
+         * @param keys Receives the keys.
+         */
+        void getKeys(uint64_t first, uint64_t count, uint64_t* keys) const;
+    
+    // private attributes and methods of the class.
+    private:
+        
+        /**
+         * The mapped file.
+         */
+        MappedFile file;
+};
+
+// end of the class signature.
+#endif	/* KEYLIST_H */
@@ -0,0 +1,88 @@
+/**
+ * File: KeyPattern.cpp
+ * 
+ * Source code file for the KeyPattern class.
+ * 
+ * @version 0.1
+ */
+
+// include the signature of the class.
+#include "KeyPattern.h"
+
+// include the BMI2 intrinsics if the compiler targets them.
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * Constructor method of the class, for the first keyLength bits of the key
+ * string unknown and the rest of them zero.
+ */
+KeyPattern::KeyPattern(int keyLength)
+{
+    this->initialize(0, (64 <= keyLength) ? ~0ULL : ~(~0ULL >> keyLength));
+}
+
+/**
+ * Constructor method of the class.
+ * 
+ * @param knownKey The key the known bits are taken from; its bits in the
+ * unknown mask are ignored.
+ * @param unknownMask The free bits; at most 63 of them.
+ */
+KeyPattern::KeyPattern(uint64_t knownKey, uint64_t unknownMask)
+{
+    this->initialize(knownKey, unknownMask);
+}
+
+/**
+ * Sets up the free bits and the positions.
+ */
+void KeyPattern::initialize(uint64_t knownKey, uint64_t unknownMask)
+{
+    this->knownKey = knownKey & ~unknownMask;
+    this->unknownMask = unknownMask;
+    this->freeBits = __builtin_popcountll(unknownMask);
+    
+    // candidate bit j goes to the j-th lowest free bit, which is key string
+    // position 63 - (its bit number).
+    int bit = 0;
+    for (uint64_t mask = unknownMask; 0 != mask; mask &= mask - 1) {
+        this->positions[bit++] = (signed char) (63 - __builtin_ctzll(mask));
+    }
+    while (64 > bit) {
+        this->positions[bit++] = -1;
+    }
+}
+
+/**
+ * Returns the key of a candidate: the bits of the candidate are deposited
+ * into the free bits, with pdep where the CPU has it.
+ */
+uint64_t KeyPattern::getKey(uint64_t candidate) const
+{
+#if defined(__BMI2__)
+    return this->knownKey | _pdep_u64(candidate, this->unknownMask);
+#else
+    uint64_t key = this->knownKey;
+    for (uint64_t mask = this->unknownMask; 0 != mask && 0 != candidate; mask &= mask - 1, candidate >>= 1) {
+        if (candidate & 1) {
+            key |= mask & -mask;
+        }
+    }
+    return key;
+#endif
+}
+
+/**
+ * Writes the NUL-terminated key string ('0'/'1' characters) of a candidate
+ * into the given buffer, which must hold 65 characters.
+ */
+void KeyPattern::getKeyString(uint64_t candidate, char* key) const
+{
+    uint64_t value = this->getKey(candidate);
+    for (int position = 0; position < 64; position++) {
+        key[position] = ((value >> (63 - position)) & 1) ? '1' : '0';
+    }
+    key[64] = '\0';
+}
@@ -0,0 +1,144 @@
+/**
+ * File: KeyPattern.h
+ * 
+ * Header file for the KeyPattern class.
+ * 
+ * @version 0.1
+ */
+
+// make sure that the signature of the class is defined only once.
+#ifndef KEYPATTERN_H
+#define	KEYPATTERN_H
+
+// include the fixed-width integer types.
+#include <stdint.h>
+
+/**
+ * Signature of the KeyPattern class.
+ * 
+ * KeyPattern describes the keys a search goes through: a 64-bit DES key
+ * (key string position p is bit 63 - p) of which the bits in the unknown
+ * mask are free and every other bit is known. Candidate i stands for the key
+ * that holds the known bits and has the binary form of i deposited into the
+ * free bits, lowest free bit first, so the candidates 0 to 2^n - 1 cover the
+ * n free bits whichever they are.
+ * 
+ * The key of any candidate can be computed directly (getKey), and the key of
+ * the next candidate from the key of the current one in constant time
+ * (getNextKey), which is how the engines walk their ranges.
+ * 
+ * The default, keyLength unknown bits at the start of the key string and
+ * zeros after them, is candidate i standing for i << (64 - keyLength).
+ * 
+ * @since version 0.1
+ * @see AlgorithmInterface
+ */
+class KeyPattern
+{
+    // public attributes and methods of the class.
+    public:
+        
+        /**
+         * Constructor method of the class, for the first keyLength bits of
+         * the key string unknown and the rest of them zero.
+         */
+        KeyPattern(int keyLength);
+        
+        /**
+         * Constructor method of the class.
+         * 
+         * @param knownKey The key the known bits are taken from; its bits in
+         * the unknown mask are ignored.
+         * @param unknownMask The free bits; at most 63 of them.
+         */
+        KeyPattern(uint64_t knownKey, uint64_t unknownMask);
+        
+        /**
+         * Returns the known bits (the free bits are zero).
+         */
+        uint64_t getKnownKey() const
+        {
+            return this->knownKey;
+        }
+        
+        /**
+         * Returns the mask of the free bits.
+         */
+        uint64_t getUnknownMask() const
+        {
+            return this->unknownMask;
+        }
+        
+        /**
+         * Returns the number of free bits.
+         */
+        int getFreeBits() const
+        {
+            return this->freeBits;
+        }
+        
+        /**
+         * Returns the number of candidates, 2 to the number of free bits.
+         */
+        uint64_t getNumberOfCandidates() const
+        {
+            return (uint64_t) 1 << this->freeBits;
+        }
+        
+        /**
+         * Returns the key string position that bit j of a candidate lands
+         * on, or -1 if the candidates don't have that bit.
+         */
+        int getPosition(int bit) const
+        {
+            return this->positions[bit];
+        }
+        
+        /**
+         * Returns the key of a candidate.
+         */
+        uint64_t getKey(uint64_t candidate) const;
+        
+        /**
+         * Returns the key of the candidate after the one the given key is
+         * of: the free bits are counted up by one as if they were next to
+         * each other, the known bits carrying the carry through.
+         */
+        uint64_t getNextKey(uint64_t key) const
+        {
+            return this->knownKey | (((key | ~this->unknownMask) + 1) & this->unknownMask);
+        }
+        
+        /**
+         * Writes the NUL-terminated key string ('0'/'1' characters) of a
+         * candidate into the given buffer, which must hold 65 characters.
+         */
+        void getKeyString(uint64_t candidate, char* key) const;
+    
+    // private attributes and methods of the class.
+    private:
+        
+        /**
+         * The known bits and the mask of the free bits.
+         */
+        uint64_t knownKey;
+        uint64_t unknownMask;
+        
+        /**
+         * Number of free bits.
+         */
+        int freeBits;
+        
+        /**
+         * Key string position of every candidate bit; -1 past the free bits.
+         */
+        signed char positions[64];
+        
+        /**
+         * Sets up the free bits and the positions.
+         */
+        void initialize(uint64_t knownKey, uint64_t unknownMask);
+};
+
+// end of the class signature.
+#endif	/* KEYPATTERN_H */
@@ -0,0 +1,190 @@
+/**
+ * File: KeyspaceScheduler.cpp
+ * 
+ * Source code file for the KeyspaceScheduler class.
+ * 
+ * @version 0.1
+ */
+
+// include the clock_gettime function.
+#include <time.h>
+
+// include the signature of the class.
+#include "KeyspaceScheduler.h"
+
+/**
+ * Time a chunk should take, in seconds.
+ */
+const double KeyspaceScheduler::targetSeconds = 0.01;
+
+/**
+ * Number of engine passes in the first chunk, before there is a measurement.
+ */
+static const uint64_t initialPasses = 1024;
+
+/**
+ * Returns the time on the monotonic clock, in seconds.
+ */
+static double monotonicSeconds()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/**
+ * Constructor method of the class.
+ * 
+ * @param cursor The shared cursor.
+ * @param alignment Chunks start and end on multiples of this.
+ */
+KeyspaceScheduler::KeyspaceScheduler(KeyspaceCursor* cursor, uint64_t alignment)
+{
+    this->cursor = cursor;
+    this->alignment = alignment;
+    this->lowWaterMark = NULL;
+    this->chunkFirst = NULL;
+    this->chunkLast = NULL;
+    this->chunkSize = initialPasses * alignment;
+    this->lastSize = 0;
+    this->lastClaim = 0;
+    this->keysPerSecond = 0;
+}
+
+/**
+ * Claims the next chunk of the key space. The time since the last call is
+ * taken as the time the last chunk took, and the chunk size is adapted to it.
+ * 
+ * @param firstCandidate Receives the first candidate of the chunk.
+ * @param lastCandidate Receives the end (exclusive) of the chunk.
+ * @return Whether a chunk was claimed; false once the key space is exhausted.
+ */
+bool KeyspaceScheduler::nextChunk(uint64_t& firstCandidate, uint64_t& lastCandidate)
+{
+    const uint64_t last = this->cursor->last;
+    
+    double now = monotonicSeconds();
+    if (0 < this->lastSize) {
+        this->adapt(this->lastSize, now - this->lastClaim);
+    }
+    this->lastSize = 0;
+    
+    // guided scheduling: never claim more than a share of what is left, so
+    // that the last chunks are small and the workers finish together.
+    uint64_t next = this->cursor->next.load(std::memory_order_relaxed);
+    while (true) {
+        // the cursor only moves forward, so the chunk claimed below can't
+        // start before next. whoever reads the mark and then the cursor
+        // knows that no unfinished chunk of this worker starts below the
+        // smaller of the two.
+        if (NULL != this->lowWaterMark) {
+            this->lowWaterMark->store(next);
+        }
+        if (next >= last) {
+            if (NULL != this->chunkFirst) {
+                this->chunkLast->store(0);
+            }
+            return false;
+        }
+        uint64_t share = (last - next) / (4 * (uint64_t) this->cursor->workers);
+        uint64_t size = (share < this->chunkSize) ? share : this->chunkSize;
+        size -= size % this->alignment;
+        if (size < this->alignment) {
+            size = this->alignment;
+        }
+        firstCandidate = next;
+        lastCandidate = (last - next > size) ? next + size : last;
+        
+        // the chunk is published (end last, so that it is never seen half
+        // written) before the cursor is moved past it: a worker that dies
+        // in between leaves a record of a chunk that is either its own or
+        // one it failed to claim, which is only searched twice.
+        if (NULL != this->chunkFirst) {
+            this->chunkLast->store(0);
+            this->chunkFirst->store(firstCandidate);
+            this->chunkLast->store(lastCandidate);
+        }
+        if (this->cursor->next.compare_exchange_weak(next, next + size)) {
+            break;
+        }
+    }
+    
+    this->lastSize = lastCandidate - firstCandidate;
+    this->lastClaim = now;
+    
+    return true;
+}
+
+/**
+ * Sets where the scheduler publishes, before it claims a chunk, a candidate
+ * the chunk can't start below (see WorkerStatus::lowWaterMark).
+ * 
+ * @param lowWaterMark The worker's mark, or NULL for none.
+ */
+void KeyspaceScheduler::setLowWaterMark(std::atomic<uint64_t>* lowWaterMark)
+{
+    this->lowWaterMark = lowWaterMark;
+}
+
+/**
+ * Sets where the scheduler publishes each chunk before it claims it (see
+ * WorkerStatus::chunkFirst).
+ * 
+ * @param chunkFirst The worker's first candidate, or NULL for none.
+ * @param chunkLast The worker's end of the chunk.
+ */
+void KeyspaceScheduler::setChunkRecord(std::atomic<uint64_t>* chunkFirst, std::atomic<uint64_t>* chunkLast)
+{
+    this->chunkFirst = chunkFirst;
+    this->chunkLast = chunkLast;
+}
+
+/**
+ * Returns the size the next chunk will have (before it is shrunk towards the
+ * end of the key space).
+ */
+uint64_t KeyspaceScheduler::getChunkSize()
+{
+    return this->chunkSize;
+}
+
+/**
+ * Returns the speed measured over the last chunk, in keys/second.
+ */
+uint64_t KeyspaceScheduler::getKeysPerSecond()
+{
+    return this->keysPerSecond;
+}
+
+/**
+ * Moves the chunk size towards the size that would take targetSeconds at the
+ * measured speed.
+ * 
+ * @param keys Number of candidates in the last chunk.
+ * @param seconds Time it took to search them.
+ */
+void KeyspaceScheduler::adapt(uint64_t keys, double seconds)
+{
+    if (0 >= seconds || 0 == keys) {
+        return;
+    }
+    this->keysPerSecond = (uint64_t) (keys / seconds);
+    
+    // move halfway towards the size that would have taken targetSeconds, so
+    // that a single noisy measurement can't swing the chunk size too far.
+    double ideal = (double) keys / seconds * KeyspaceScheduler::targetSeconds;
+    uint64_t size = (uint64_t) ((this->chunkSize + ideal) / 2);
+    size -= size % this->alignment;
+    
+    this->chunkSize = (size < this->alignment) ? this->alignment : size;
+}
+
+/**
+ * Sets up a cursor over [firstCandidate, lastCandidate).
+ */
+void KeyspaceScheduler::initialize(KeyspaceCursor* cursor, uint64_t firstCandidate, uint64_t lastCandidate, int workers)
+{
+    cursor->next.store(firstCandidate);
+    cursor->last = lastCandidate;
+    cursor->workers = (0 < workers) ? workers : 1;
+}
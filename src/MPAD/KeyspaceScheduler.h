@@ -0,0 +1,179 @@
+/**
+ * File: KeyspaceScheduler.h
+ * 
+ * Header file for the KeyspaceScheduler class.
+ * 
+ * @version 0.1
+ */
+
+// make sure that the signature of the class is defined only once.
+#ifndef KEYSPACESCHEDULER_H
+#define	KEYSPACESCHEDULER_H
+
+// include the atomic library for the shared cursor.
+#include <atomic>
+
+// include the fixed-width integer types.
+#include <stdint.h>
+
+/**
+ * The part of the key space that is still to be handed out, shared by every
+ * worker. It is plain data with a lock-free atomic, so it can live in memory
+ * that is shared between processes as well as between threads.
+ */
+struct KeyspaceCursor
+{
+    /**
+     * First candidate that hasn't been handed out yet.
+     */
+    std::atomic<uint64_t> next;
+    
+    /**
+     * End (exclusive) of the key space.
+     */
+    uint64_t last;
+    
+    /**
+     * Number of workers that take chunks from the cursor.
+     */
+    uint32_t workers;
+};
+
+/**
+ * Signature of the KeyspaceScheduler class.
+ * 
+ * A KeyspaceScheduler belongs to one worker (thread or child process) and
+ * hands it chunks of the key space from the shared cursor, so a worker that
+ * is done takes the next chunk instead of waiting for the slowest one.
+ * 
+ * The chunk size follows the keys/second the worker measures, aiming at a
+ * fixed time per chunk. Towards the end of the key space the chunks shrink
+ * with what is left, so that the workers finish together.
+ * 
+ * @since version 0.1
+ * @see ChildProcess
+ * @see ThreadedSearch
+ */
+class KeyspaceScheduler
+{
+    // public attributes and methods of the class.
+    public:
+        
+        /**
+         * Constructor method of the class.
+         * 
+         * @param cursor The shared cursor.
+         * @param alignment Chunks start and end on multiples of this (the
+         * number of keys the engine tests in one pass).
+         */
+        KeyspaceScheduler(KeyspaceCursor* cursor, uint64_t alignment);
+        
+        /**
+         * Claims the next chunk of the key space. The time since the last
+         * call is taken as the time the last chunk took, and the chunk size
+         * is adapted to it.
+         * 
+         * @param firstCandidate Receives the first candidate of the chunk.
+         * @param lastCandidate Receives the end (exclusive) of the chunk.
+         * @return Whether a chunk was claimed; false once the key space is
+         * exhausted.
+         */
+        bool nextChunk(uint64_t& firstCandidate, uint64_t& lastCandidate);
+        
+        /**
+         * Sets where the scheduler publishes, before it claims a chunk, a
+         * candidate the chunk can't start below (see
+         * WorkerStatus::lowWaterMark).
+         * 
+         * @param lowWaterMark The worker's mark, or NULL for none.
+         */
+        void setLowWaterMark(std::atomic<uint64_t>* lowWaterMark);
+        
+        /**
+         * Sets where the scheduler publishes each chunk before it claims it
+         * (see WorkerStatus::chunkFirst), so that a chunk is never claimed
+         * without a record of it; a worker that dies right after the claim
+         * leaves it to the one that takes its place. The record is cleared
+         * once the key space is exhausted.
+         * 
+         * @param chunkFirst The worker's first candidate, or NULL for none.
+         * @param chunkLast The worker's end of the chunk.
+         */
+        void setChunkRecord(std::atomic<uint64_t>* chunkFirst, std::atomic<uint64_t>* chunkLast);
+        
+        /**
+         * Returns the size the next chunk will have (before it is shrunk
+         * towards the end of the key space).
+         */
+        uint64_t getChunkSize();
+        
+        /**
+         * Sets up a cursor over [firstCandidate, lastCandidate).
+         */
+        static void initialize(KeyspaceCursor* cursor, uint64_t firstCandidate, uint64_t lastCandidate, int workers);
+        
+        /**
+         * Returns the speed measured over the last chunk, in keys/second.
+         */
+        uint64_t getKeysPerSecond();
+        
+        /**
+         * Time a chunk should take, in seconds. Long enough to make claiming
+         * chunks cheap, short enough for a worker to notice quickly that the
+         * search is over.
+         */
+        static const double targetSeconds;
+    
+    // private attributes and methods of the class.
+    private:
+        
+        /**
+         * The shared cursor.
+         */
+        KeyspaceCursor* cursor;
+        
+        /**
+         * Chunks start and end on multiples of this.
+         */
+        uint64_t alignment;
+        
+        /**
+         * Where the low-water mark of the worker is published, if anywhere.
+         */
+        std::atomic<uint64_t>* lowWaterMark;
+        
+        /**
+         * Where each chunk is published before it is claimed, if anywhere.
+         */
+        std::atomic<uint64_t>* chunkFirst;
+        std::atomic<uint64_t>* chunkLast;
+        
+        /**
+         * The size of the next chunk, adapted from the measured speed.
+         */
+        uint64_t chunkSize;
+        
+        /**
+         * Size of the last chunk claimed, and when it was claimed (seconds
+         * on the monotonic clock).
+         */
+        uint64_t lastSize;
+        double lastClaim;
+        
+        /**
+         * Moves the chunk size towards the size that would take
+         * targetSeconds at the measured speed.
+         * 
+         * @param keys Number of candidates in the last chunk.
+         * @param seconds Time it took to search them.
+         */
+        void adapt(uint64_t keys, double seconds);
+        
+        /**
+         * The speed measured over the last chunk.
+         */
+        uint64_t keysPerSecond;
+};
+
+// end of the class signature.
+#endif	/* KEYSPACESCHEDULER_H */
@@ -4,14 +4,13 @@
  * Source code file for the Logger class.
  * 
  * @author Onur Yaman <onuryaman@gmail.com>
- * @version 0.1
+ * @version 0.2
  * @since 2011-10-28
  */
 
-// include the stream related libraries.
-#include <iostream>
-#include <fstream>
-#include <sstream>
+// include standard libraries.
+#include <stdio.h>
+#include <stdlib.h>
 
 // include the string library for the std::string class.
 #include <string.h>
@@ -23,12 +22,29 @@
 #include <time.h>
 #include <sys/time.h>
 
+// include the file related functions.
+#include <fcntl.h>
+#include <unistd.h>
+
+// include the sched_yield function.
+#include <sched.h>
+
+// include the vector library.
+#include <vector>
+
 // include the signature of the class.
 #include "Logger.h"
 
+// the names of the log and the trace files.
+const char* Logger::logFilePath = "mpad.log";
+const char* Logger::traceFilePath = "mpad.trace";
+
+// the trace is disabled unless it is enabled.
+std::atomic<bool> Logger::traceEnabled(false);
+
 // by default, the class is not instantiated.
-bool Logger::instanceFlag = false;
-Logger* Logger::instance = NULL;
+std::atomic<Logger*> Logger::instance(NULL);
+pthread_mutex_t Logger::instanceMutex = PTHREAD_MUTEX_INITIALIZER;
 
 /**
  * If the Logger class was instantiated before; returns a pointer to
@@ -39,17 +55,72 @@ Logger* Logger::instance = NULL;
  */
 Logger* Logger::getInstance()
 {
-    // if the class was not instantiated before;
-    if (! Logger::instanceFlag) {
-        // instantiate it.
-        Logger::instance = new Logger();
+    // if the class was instantiated before, this is all it takes.
+    Logger* logger = Logger::instance.load(std::memory_order_acquire);
+    if (NULL != logger) {
+        return logger;
+    }
+    
+    // if not; instantiate it, unless another thread has just done so.
+    pthread_mutex_lock(&Logger::instanceMutex);
+    logger = Logger::instance.load(std::memory_order_relaxed);
+    if (NULL == logger) {
+        static bool handlersRegistered = false;
+        if (! handlersRegistered) {
+            pthread_atfork(NULL, NULL, Logger::forgetInstance);
+            atexit(Logger::flushAtExit);
+            handlersRegistered = true;
+        }
         
-        // mark it as instantiated.
-        Logger::instanceFlag = true;
+        logger = new Logger();
+        Logger::instance.store(logger, std::memory_order_release);
     }
-
+    pthread_mutex_unlock(&Logger::instanceMutex);
+    
     // return the singleton instance.
-    return Logger::instance;
+    return logger;
+}
+
+/**
+ * Opens the log file and starts the writer thread.
+ */
+Logger::Logger()
+{
+    this->logFile = open(Logger::logFilePath, O_WRONLY | O_APPEND | O_CREAT, 0644);
+    if (-1 == this->logFile) {
+        fprintf(stderr, "Could not open the log file %s, error %d occurred", Logger::logFilePath, errno);
+    }
+    this->traceFile = -1;
+    if (Logger::traceEnabled.load()) {
+        this->openTrace();
+    }
+    
+    // every record starts out free for the producer of its position.
+    this->ring = new Record[Logger::ringSize];
+    for (uint64_t i = 0; i < Logger::ringSize; i++) {
+        this->ring[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    this->enqueuePosition.store(0);
+    this->writtenPosition.store(0);
+    
+    // the process group and the process can't change while the process is
+    // logging (a forked child gets an instance of its own).
+    this->processId = (int) getpid();
+    this->processGroupId = (int) getpgid(this->processId);
+    this->writerTime.second = -1;
+    this->directTime.second = -1;
+    
+    pthread_mutex_init(&this->directMutex, NULL);
+    sem_init(&this->wakeUp, 0, 0);
+    this->writerSleeping.store(false);
+    this->writtenWaiters.store(0);
+    pthread_mutex_init(&this->writtenMutex, NULL);
+    pthread_cond_init(&this->writtenCondition, NULL);
+    pthread_t writer;
+    this->writerRunning = (0 == pthread_create(&writer, NULL, Logger::writerMain, this));
+    if (this->writerRunning) {
+        pthread_detach(writer);
+    }
 }
 
 /**
@@ -57,43 +128,24 @@ Logger* Logger::getInstance()
  * 
  * @param logMessage Event message that is going to be logged.
  */
-void Logger::writeToLogFile(std::string logMessage) { 
-    // open the log file in append method.
-    std::ofstream logFile("mpad.log", std::ios::app);
-    
-    // if the file is open;
-    if (logFile.is_open()) {
-        // calculate the current data and time values.
-        time_t rawTime;
-        struct tm* timeInfo;
-        char buffer[80];
-        time(&rawTime);
-        timeInfo = localtime(&rawTime);
-        
-        // format the date/time values.
-        strftime(buffer, 80, "%Y-%m-%d %H:%M:%S.", timeInfo);
-        timeval rawTimeInMicroSeconds;
-        gettimeofday(&rawTimeInMicroSeconds, NULL);
-        sprintf(buffer, "%s%d", buffer, (rawTimeInMicroSeconds.tv_usec / 1000) % 1000);
-        
-        // log the message (including the date/time values and current
-        // process' id.
-        logFile << ((std::string) buffer) << ", " << ((int) getpgid(getpid())) << ", " << ((int) getpid()) << ", " << logMessage << std::endl;
-    }
-    // if the file is not open;
-    else {
-        // log the error message.
-        fprintf(stderr, "Could not log the message %s, error %d occurred", logMessage.c_str(), errno);
+void Logger::writeToLogFile(std::string logMessage) {
+    Logger* logger = Logger::getInstance();
+    
+    // a message that doesn't fit in a record is written right away, after
+    // the ones before it.
+    if (logMessage.size() > Logger::recordTextSize || ! logger->writerRunning) {
+        logger->waitUntilWritten(logger->enqueuePosition.load());
+        logger->writeDirectly(logMessage.data(), logMessage.size());
+        return;
     }
     
-    // close the log file.
-    logFile.close();
+    logger->push(RECORD_MESSAGE, logMessage.data(), logMessage.size());
 };
 
 /**
  * Overloading method for the writeToLogFile method. The difference is
  * that, this method takes the name of a process and assigns that name
- * to the corresponding file of the logMessage which is actually a 
+ * to the corresponding file of the logMessage which is actually a
  * string format.
  * 
  * @param logMessage String format of the log message.
@@ -103,10 +155,329 @@ void Logger::writeToLogFile(std::string logMessage) {
 void Logger::writeToLogFile(std::string logMessage, std::string processName)
 {
     // update the logMessage. it won't stay as a pattern.
-    int messageLength = (int) logMessage.size() - 2 + (int) processName.size();
+    int messageLength = (int) logMessage.size() - 2 + (int) processName.size() + 1;
     char message[messageLength];
     sprintf(message, logMessage.c_str(), processName.c_str());
     
     // log the new message using the writeToLogFile (overloaded method) metod.
     Logger::writeToLogFile((std::string) message);
 }
+
+/**
+ * Starts writing the trace events of this process (and of the processes it
+ * forks) to the trace file.
+ */
+void Logger::enableTrace()
+{
+    // open the file before the first event can be logged.
+    Logger* logger = Logger::getInstance();
+    pthread_mutex_lock(&logger->directMutex);
+    if (-1 == logger->traceFile) {
+        logger->openTrace();
+    }
+    pthread_mutex_unlock(&logger->directMutex);
+    
+    // released after the file is opened: a thread that sees the trace
+    // enabled sees the trace file too.
+    Logger::traceEnabled.store(true, std::memory_order_release);
+}
+
+/**
+ * Returns whether the trace is enabled.
+ */
+bool Logger::isTraceEnabled()
+{
+    return Logger::traceEnabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * Appends an event to the trace file, if the trace is enabled. The time and
+ * the process id are filled in.
+ * 
+ * @see TraceEvent
+ */
+void Logger::writeTraceEvent(TraceEventType type, int worker, uint64_t first, uint64_t last, uint64_t counter, uint64_t value)
+{
+    if (! Logger::traceEnabled.load(std::memory_order_acquire)) {
+        return;
+    }
+    Logger* logger = Logger::getInstance();
+    
+    TraceEvent event;
+    event.timestamp = TraceEvent::now();
+    event.processId = logger->processId;
+    event.type = type;
+    event.worker = worker;
+    event.first = first;
+    event.last = last;
+    event.counter = counter;
+    event.value = value;
+    
+    if (! logger->writerRunning) {
+        pthread_mutex_lock(&logger->directMutex);
+        logger->writeAll(logger->traceFile, (const char*) &event, sizeof(event));
+        pthread_mutex_unlock(&logger->directMutex);
+        return;
+    }
+    logger->push(RECORD_TRACE, (const char*) &event, sizeof(event));
+}
+
+/**
+ * Waits until every message that has been logged so far is in the log file.
+ * Called at exit; call it before _exit or exec.
+ */
+void Logger::flush()
+{
+    Logger* logger = Logger::instance.load(std::memory_order_acquire);
+    if (NULL != logger) {
+        logger->waitUntilWritten(logger->enqueuePosition.load());
+    }
+}
+
+/**
+ * Puts a message or a trace event in the ring buffer.
+ */
+void Logger::push(RecordKind kind, const char* data, size_t length)
+{
+    // take the time now, it is formatted by the writer thread.
+    struct timeval time;
+    gettimeofday(&time, NULL);
+    
+    // claim the next position whose record is free. if the buffer is full,
+    // wait for the writer to catch up.
+    uint64_t position = this->enqueuePosition.load(std::memory_order_relaxed);
+    Record* record;
+    while (true) {
+        record = &this->ring[position & (Logger::ringSize - 1)];
+        int64_t difference = (int64_t) (record->sequence.load(std::memory_order_acquire) - position);
+        if (0 == difference) {
+            if (this->enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (0 > difference) {
+            this->wakeWriter();
+            sched_yield();
+            position = this->enqueuePosition.load(std::memory_order_relaxed);
+        } else {
+            position = this->enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+    
+    // fill it in and hand it to the writer.
+    record->time = time;
+    record->kind = kind;
+    record->length = (uint32_t) length;
+    memcpy(record->text, data, length);
+    record->sequence.store(position + 1, std::memory_order_release);
+    
+    this->wakeWriter();
+}
+
+/**
+ * Wakes the writer thread up if it is asleep. A writer that is still busy
+ * finds the records published before the call on its own, so the semaphore
+ * is only posted once per sleep, by the producer that clears the flag.
+ */
+void Logger::wakeWriter()
+{
+    // the record has to be visible to a writer that has set the flag and
+    // then looks for it, or this has to see the flag (see drain).
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (this->writerSleeping.load(std::memory_order_relaxed) && this->writerSleeping.exchange(false, std::memory_order_relaxed)) {
+        sem_post(&this->wakeUp);
+    }
+}
+
+/**
+ * Formats a message as a line of the log file.
+ * 
+ * @param cache The time cache of the calling thread.
+ * @param line Receives the line; must hold recordTextSize + 128 bytes, or
+ * more for a longer message.
+ * @return The length of the line.
+ */
+size_t Logger::formatLine(TimeCache& cache, const struct timeval& time, const char* text, size_t length, char* line)
+{
+    // the date and the time only change once a second.
+    if (time.tv_sec != cache.second) {
+        struct tm timeInfo;
+        localtime_r(&time.tv_sec, &timeInfo);
+        strftime(cache.text, sizeof(cache.text), "%Y-%m-%d %H:%M:%S.", &timeInfo);
+        cache.second = time.tv_sec;
+    }
+    
+    // log the message (including the date/time values and current process'
+    // id.
+    int prefixLength = sprintf(line, "%s%03d, %d, %d, ", cache.text, (int) ((time.tv_usec / 1000) % 1000), this->processGroupId, this->processId);
+    memcpy(line + prefixLength, text, length);
+    line[prefixLength + length] = '\n';
+    
+    return prefixLength + length + 1;
+}
+
+/**
+ * Writes a buffer to a file, however many calls it takes.
+ */
+void Logger::writeAll(int file, const char* data, size_t length)
+{
+    if (-1 == file) {
+        return;
+    }
+    
+    while (0 < length) {
+        ssize_t written = write(file, data, length);
+        if (-1 == written) {
+            if (EINTR == errno) {
+                continue;
+            }
+            
+            // log the error message.
+            fprintf(stderr, "Could not write to the log or the trace file, error %d occurred", errno);
+            return;
+        }
+        data += written;
+        length -= written;
+    }
+}
+
+/**
+ * Writes a message to the log file right away, bypassing the buffer.
+ */
+void Logger::writeDirectly(const char* text, size_t length)
+{
+    struct timeval time;
+    gettimeofday(&time, NULL);
+    
+    pthread_mutex_lock(&this->directMutex);
+    std::vector<char> line(length + 128);
+    this->writeAll(this->logFile, line.data(), this->formatLine(this->directTime, time, text, length, line.data()));
+    pthread_mutex_unlock(&this->directMutex);
+}
+
+/**
+ * Waits until every message before the given position is in the log file.
+ */
+void Logger::waitUntilWritten(uint64_t position)
+{
+    if (! this->writerRunning || this->writtenPosition.load() >= position) {
+        return;
+    }
+    
+    // the records are published, so the writer is already woken up for
+    // them; sleep until it has written them.
+    this->writtenWaiters.fetch_add(1);
+    pthread_mutex_lock(&this->writtenMutex);
+    while (this->writtenPosition.load() < position) {
+        pthread_cond_wait(&this->writtenCondition, &this->writtenMutex);
+    }
+    pthread_mutex_unlock(&this->writtenMutex);
+    this->writtenWaiters.fetch_sub(1);
+}
+
+/**
+ * Entry point of the writer thread.
+ */
+void* Logger::writerMain(void* logger)
+{
+    ((Logger*) logger)->drain();
+    
+    return NULL;
+}
+
+/**
+ * Opens the trace file.
+ */
+void Logger::openTrace()
+{
+    this->traceFile = open(Logger::traceFilePath, O_WRONLY | O_APPEND | O_CREAT, 0644);
+    if (-1 == this->traceFile) {
+        fprintf(stderr, "Could not open the trace file %s, error %d occurred", Logger::traceFilePath, errno);
+    }
+}
+
+/**
+ * Drains the ring buffer into the log and the trace files whenever it is
+ * woken up. The lines and the events go out in batches of up to 64 KB, each
+ * with a single write call.
+ */
+void Logger::drain()
+{
+    static const size_t batchSize = 64 * 1024;
+    std::vector<char> batch(batchSize);
+    std::vector<char> traceBatch(batchSize);
+    
+    uint64_t position = 0;
+    while (true) {
+        size_t used = 0, traceUsed = 0;
+        while (true) {
+            Record* record = &this->ring[position & (Logger::ringSize - 1)];
+            if (record->sequence.load(std::memory_order_acquire) != position + 1) {
+                break;
+            }
+            
+            // make room for the line or the event, then give the record
+            // back.
+            if (RECORD_TRACE == record->kind) {
+                if (batchSize - traceUsed < sizeof(TraceEvent)) {
+                    this->writeAll(this->traceFile, traceBatch.data(), traceUsed);
+                    traceUsed = 0;
+                }
+                memcpy(traceBatch.data() + traceUsed, record->text, sizeof(TraceEvent));
+                traceUsed += sizeof(TraceEvent);
+            } else {
+                if (batchSize - used < Logger::recordTextSize + 128) {
+                    this->writeAll(this->logFile, batch.data(), used);
+                    used = 0;
+                }
+                used += this->formatLine(this->writerTime, record->time, record->text, record->length, batch.data() + used);
+            }
+            record->sequence.store(position + Logger::ringSize, std::memory_order_release);
+            position++;
+        }
+        
+        if (0 < used) {
+            this->writeAll(this->logFile, batch.data(), used);
+        }
+        if (0 < traceUsed) {
+            this->writeAll(this->traceFile, traceBatch.data(), traceUsed);
+        }
+        this->writtenPosition.store(position);
+        
+        // wake up the threads that wait for their messages to be written.
+        if (0 < this->writtenWaiters.load()) {
+            pthread_mutex_lock(&this->writtenMutex);
+            pthread_cond_broadcast(&this->writtenCondition);
+            pthread_mutex_unlock(&this->writtenMutex);
+        }
+        
+        // sleep until a producer posts, unless a record was published while
+        // the flag was down. in that case a producer may have posted too,
+        // which only costs an extra pass.
+        this->writerSleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (this->ring[position & (Logger::ringSize - 1)].sequence.load(std::memory_order_acquire) == position + 1) {
+            this->writerSleeping.store(false, std::memory_order_relaxed);
+            continue;
+        }
+        while (-1 == sem_wait(&this->wakeUp) && EINTR == errno);
+    }
+}
+
+/**
+ * After a fork, the child has none of the parent's threads; it gets an
+ * instance of its own when it first logs. The parent's messages that were
+ * still buffered are the parent's to write.
+ */
+void Logger::forgetInstance()
+{
+    Logger::instance.store(NULL);
+    pthread_mutex_init(&Logger::instanceMutex, NULL);
+}
+
+/**
+ * Writes the buffered messages out at exit.
+ */
+void Logger::flushAtExit()
+{
+    Logger::flush();
+}
@@ -4,7 +4,7 @@
  * Header file for the Logger class.
  * 
  * @author Onur Yaman <onuryaman@gmail.com>
- * @version 0.1
+ * @version 0.2
  * @since 2011-10-28
  */
 
@@ -15,6 +15,22 @@
 // include the string library for the std::string class.
 #include <string>
 
+// include the atomic library for the ring buffer.
+#include <atomic>
+
+// include the fixed-width integer types.
+#include <stdint.h>
+
+// include the timeval structure.
+#include <sys/time.h>
+
+// include the TraceEvent structure.
+#include "TraceEvent.h"
+
+// include the POSIX thread and semaphore libraries.
+#include <pthread.h>
+#include <semaphore.h>
+
 /**
  * Signature of the Logger class.
  * 
@@ -25,6 +41,16 @@
  * The main process and all child processes share a common log file. The full
  * path of the log file is defined in the class.
  * 
+ * Logging doesn't touch the file: writeToLogFile only takes the time and puts
+ * the message in a lock-free ring buffer. A writer thread of the process
+ * formats the messages and appends them to the file in batches, with a
+ * single write call on a descriptor that is opened once with O_APPEND, so
+ * that the lines of different processes never interleave. Whatever is still
+ * in the buffer is written when the process exits (or on flush).
+ * 
+ * Once the trace is enabled, the same buffer and writer also carry the
+ * binary TraceEvent records of the process to the trace file.
+ * 
  * @since version 0.1
  * @see MainProcess
  * @see ChildProcess
@@ -39,6 +65,11 @@ class Logger
          */
         static const char* logFilePath;
         
+        /**
+         * Full path of the shared binary trace file.
+         */
+        static const char* traceFilePath;
+        
         /**
          * Writes a log message to the shared log file in a safe manner.
          * 
@@ -49,7 +80,7 @@ class Logger
         /**
          * Overloading method for the writeToLogFile method. The difference is
          * that, this method takes the name of a process and assigns that name
-         * to the corresponding file of the logMessage which is actually a 
+         * to the corresponding file of the logMessage which is actually a
          * string format.
          * 
          * @param logMessage String format of the log message.
@@ -58,6 +89,31 @@ class Logger
          */
         static void writeToLogFile(std::string logMessage, std::string processName);
         
+        /**
+         * Starts writing the trace events of this process (and of the
+         * processes it forks) to the trace file.
+         */
+        static void enableTrace();
+        
+        /**
+         * Returns whether the trace is enabled.
+         */
+        static bool isTraceEnabled();
+        
+        /**
+         * Appends an event to the trace file, if the trace is enabled. The
+         * time and the process id are filled in.
+         * 
+         * @see TraceEvent
+         */
+        static void writeTraceEvent(TraceEventType type, int worker, uint64_t first, uint64_t last, uint64_t counter, uint64_t value);
+        
+        /**
+         * Waits until every message that has been logged so far is in the
+         * log file. Called at exit; call it before _exit or exec.
+         */
+        static void flush();
+        
         /**
          * If the Logger class was instantiated before; returns a pointer to
          * that instance. If not; instantiates the class, stores a pointer to
@@ -66,19 +122,203 @@ class Logger
          * @return Pointer to the singleton instance.
          */
         static Logger* getInstance();
-        
+    
     // private attributes and methods of the class.
     private:
-
+        
         /**
-         * Represents whether the class was instantiated before or not.
+         * Number of records in the ring buffer (a power of two).
          */
-        static bool instanceFlag;
+        static const uint64_t ringSize = 1024;
+        
+        /**
+         * Longest message that fits in a record; longer ones are written
+         * directly, after the buffer has been flushed.
+         */
+        static const size_t recordTextSize = 224;
+        
+        /**
+         * What a record holds: a log message or a TraceEvent.
+         */
+        enum RecordKind
+        {
+            RECORD_MESSAGE,
+            RECORD_TRACE
+        };
+        
+        /**
+         * A message in the ring buffer. The sequence number tells whose turn
+         * it is: the record at position p is free for the producer of p when
+         * its sequence is p, and ready for the writer when it is p + 1.
+         */
+        struct Record
+        {
+            std::atomic<uint64_t> sequence;
+            struct timeval time;
+            uint32_t kind;
+            uint32_t length;
+            char text[recordTextSize];
+        };
         
         /**
          * The pointer to the single instance of the Logger class.
          */
-        static Logger* instance;
+        static std::atomic<Logger*> instance;
+        
+        /**
+         * Serializes the creation of the instance.
+         */
+        static pthread_mutex_t instanceMutex;
+        
+        /**
+         * Whether the trace is enabled.
+         */
+        static std::atomic<bool> traceEnabled;
+        
+        /**
+         * The log file, opened once for appending.
+         */
+        int logFile;
+        
+        /**
+         * The trace file, or -1 while the trace is disabled.
+         */
+        int traceFile;
+        
+        /**
+         * The ring buffer.
+         */
+        Record* ring;
+        
+        /**
+         * Next position a producer will take.
+         */
+        std::atomic<uint64_t> enqueuePosition;
+        
+        /**
+         * Every message before this position is in the log file.
+         */
+        std::atomic<uint64_t> writtenPosition;
+        
+        /**
+         * Wakes the writer thread up.
+         */
+        sem_t wakeUp;
+        
+        /**
+         * Whether the writer thread is about to wait on wakeUp; only then is
+         * it posted, by the first producer that clears the flag.
+         */
+        std::atomic<bool> writerSleeping;
+        
+        /**
+         * Number of threads that wait in waitUntilWritten, and what they wait
+         * on; the writer signals it after each pass while there are any.
+         */
+        std::atomic<int> writtenWaiters;
+        pthread_mutex_t writtenMutex;
+        pthread_cond_t writtenCondition;
+        
+        /**
+         * Whether the writer thread is running; if it isn't, messages are
+         * written directly.
+         */
+        bool writerRunning;
+        
+        /**
+         * Serializes direct writes in case there is no writer thread.
+         */
+        pthread_mutex_t directMutex;
+        
+        /**
+         * The process group id and the process id, which are in every line.
+         */
+        int processGroupId;
+        int processId;
+        
+        /**
+         * The formatted date and time of a second, which every message of
+         * that second shares.
+         */
+        struct TimeCache
+        {
+            time_t second;
+            char text[80];
+        };
+        
+        /**
+         * The time caches of the writer thread and of direct writes.
+         */
+        TimeCache writerTime;
+        TimeCache directTime;
+        
+        /**
+         * Opens the log file and starts the writer thread.
+         */
+        Logger();
+        
+        /**
+         * Puts a message or a trace event in the ring buffer.
+         */
+        void push(RecordKind kind, const char* data, size_t length);
+        
+        /**
+         * Formats a message as a line of the log file.
+         * 
+         * @param cache The time cache of the calling thread.
+         * @param line Receives the line; must hold recordTextSize + 128 bytes,
+         * or more for a longer message.
+         * @return The length of the line.
+         */
+        size_t formatLine(TimeCache& cache, const struct timeval& time, const char* text, size_t length, char* line);
+        
+        /**
+         * Writes a buffer to a file, however many calls it takes.
+         */
+        void writeAll(int file, const char* data, size_t length);
+        
+        /**
+         * Writes a message to the log file right away, bypassing the buffer.
+         */
+        void writeDirectly(const char* text, size_t length);
+        
+        /**
+         * Waits until every message before the given position is in the log
+         * file.
+         */
+        void waitUntilWritten(uint64_t position);
+        
+        /**
+         * Wakes the writer thread up if it is asleep.
+         */
+        void wakeWriter();
+        
+        /**
+         * Entry point of the writer thread.
+         */
+        static void* writerMain(void* logger);
+        
+        /**
+         * Opens the trace file.
+         */
+        void openTrace();
+        
+        /**
+         * Drains the ring buffer into the log and the trace files whenever
+         * it is woken up.
+         */
+        void drain();
+        
+        /**
+         * After a fork, the child has none of the parent's threads; it gets
+         * an instance of its own when it first logs.
+         */
+        static void forgetInstance();
+        
+        /**
+         * Writes the buffered messages out at exit.
+         */
+        static void flushAtExit();
 };
 
 // end of the class signature.
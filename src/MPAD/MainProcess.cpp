@@ -13,6 +13,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <signal.h>
+#include <sys/wait.h>
 
 // include the time library for date/time related functions.
 #include <time.h>
@@ -41,15 +42,87 @@
 #include "Logger.h"
 #include "AlgorithmDES.h"
 
+// include the ThreadedSearch class signature.
+#include "ThreadedSearch.h"
+
+// include the ControlBlock class signature.
+#include "ControlBlock.h"
+
+// include the SelfTest class signature.
+#include "SelfTest.h"
+
+// include the Checkpoint class signature.
+#include "Checkpoint.h"
+
+// include the Coordinator and WorkerAgent class signatures.
+#include "Coordinator.h"
+#include "WorkerAgent.h"
+
+// include the input file classes.
+#include "TargetSet.h"
+#include "KeyList.h"
+
+// include the WordList class signature.
+#include "WordList.h"
+
+// include the AlgorithmRegistry class signature.
+#include "AlgorithmRegistry.h"
+
+// include the MeetInTheMiddle class signature.
+#include "MeetInTheMiddle.h"
+
+// include the FileCipher class signature.
+#include "FileCipher.h"
+
 /**
- * Main entry of the application.
+ * Main entry of the application. "main_p selftest [seed]" checks the DES
+ * engines instead of searching (see SelfTest), "main_p agent <address>
+ * [threads]" searches for the coordinator at the address (see WorkerAgent),
+ * and "main_p encrypt|decrypt ecb|cbc <key> <iv> <input> <output> [workers]"
+ * encrypts or decrypts a file (see FileCipher).
  * 
  * @return The exit status of the application.
  */
-int main()
+int main(int argc, char** argv)
 {
+    if (1 < argc && 0 == strcmp(argv[1], "selftest")) {
+        uint64_t seed = (2 < argc) ? strtoull(argv[2], NULL, 10) : (uint64_t) time(NULL);
+        printf("Self-test seed: %llu\n", (unsigned long long) seed);
+        
+        SelfTest selfTest(seed);
+        exit(selfTest.run() ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+    if (2 < argc && 0 == strcmp(argv[1], "agent")) {
+        WorkerAgent agent(argv[2], (3 < argc) ? atoi(argv[3]) : 0);
+        exit(agent.run() ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+    if (1 < argc && (0 == strcmp(argv[1], "encrypt") || 0 == strcmp(argv[1], "decrypt"))) {
+        CipherStream::Mode mode;
+        uint64_t key, iv;
+        if (7 > argc || ! CipherStream::parseMode(argv[2], mode) || ! FileCipher::parseBlock(argv[3], key) || ! FileCipher::parseBlock(argv[4], iv)) {
+            fprintf(stderr, "usage: %s encrypt|decrypt ecb|cbc <16 hex digit key> <16 hex digit iv> <input> <output> [workers]\n", argv[0]);
+            exit(EXIT_FAILURE);
+        }
+        
+        bool decrypt = (0 == strcmp(argv[1], "decrypt"));
+        FileCipher cipher(mode, decrypt, key, iv, (7 < argc) ? atoi(argv[7]) : 0);
+        struct timespec started, finished;
+        clock_gettime(CLOCK_MONOTONIC, &started);
+        bool done = cipher.run(argv[5], argv[6]);
+        clock_gettime(CLOCK_MONOTONIC, &finished);
+        
+        if (! done) {
+            fprintf(stderr, "%s failed; see the log file.\n", decrypt ? "Decryption" : "Encryption");
+            exit(EXIT_FAILURE);
+        }
+        double seconds = (finished.tv_sec - started.tv_sec) + (finished.tv_nsec - started.tv_nsec) / 1e9;
+        printf("%s %llu bytes into %llu bytes with %d workers in %.3f seconds (%.0f MB/s)\n", decrypt ? "Decrypted" : "Encrypted", (unsigned long long) cipher.getBytesRead(),
+            (unsigned long long) cipher.getBytesWritten(), cipher.getNumberOfWorkers(), seconds, (0 < seconds) ? cipher.getBytesRead() / seconds / 1e6 : 0);
+        exit(EXIT_SUCCESS);
+    }
+    
     // instantiate the MainProcess class.
-    new MainProcess;
+    MainProcess mainProcess;
     
     // terminate the application.
     exit(EXIT_SUCCESS);
@@ -61,74 +134,296 @@ int main()
  */
 MainProcess::MainProcess()
 {
+    // the binary trace of the search is optional (trace = 1); the children
+    // read the same setting.
+    if (1 == Config::readValue("trace", "main")) {
+        Logger::enableTrace();
+    }
+    
     // log the main process' start event.
     Logger::writeToLogFile("Main process started!");
     
+    // a key file (keyFile) of candidate keys replaces the keys of the key
+    // pattern; it is mapped, and the children map it, too.
+    KeyList keys;
+    this->keyFile = Config::readString("keyFile", "main");
+    if (! this->keyFile.empty() && ! keys.open(this->keyFile)) {
+        Logger::writeToLogFile("ERROR: Can't map the key file %s. Main process exits!", this->keyFile);
+        exit(EXIT_FAILURE);
+    }
+    
+    // so does a word file (wordFile) of passwords, whose keys are derived
+    // from them as they are searched.
+    WordList words;
+    this->wordFile = Config::readString("wordFile", "main");
+    if (! this->wordFile.empty() && ! this->keyFile.empty()) {
+        Logger::writeToLogFile("ERROR: A key file and a word file can't be searched at once. Main process exits!");
+        exit(EXIT_FAILURE);
+    }
+    if (! this->wordFile.empty() && ! words.open(this->wordFile)) {
+        Logger::writeToLogFile("ERROR: Can't map the word file %s. Main process exits!", this->wordFile);
+        exit(EXIT_FAILURE);
+    }
+    const KeyList* keyList = this->keyFile.empty() ? NULL : &keys;
+    const WordList* wordList = this->wordFile.empty() ? NULL : &words;
+    
+    // the engine of the search (algorithm) is one of the registry, the
+    // bitsliced one by default; the children bind it by its id. the threads
+    // of this process, and so agents and batches, run the bitsliced one.
+    std::string algorithm = Config::readString("algorithm", "main");
+    const AlgorithmEngine* engine = algorithm.empty() ? AlgorithmRegistry::find(AlgorithmRegistry::defaultAlgorithmId) : AlgorithmRegistry::find(algorithm);
+    if (NULL == engine) {
+        Logger::writeToLogFile("ERROR: There is no %s engine. Main process exits!", algorithm);
+        exit(EXIT_FAILURE);
+    }
+    if (! engine->candidateLists && (NULL != keyList || NULL != wordList)) {
+        Logger::writeToLogFile("ERROR: The %s engine can't search a key or word file. Main process exits!", std::string(engine->name));
+        exit(EXIT_FAILURE);
+    }
+    bool inProcess = (0 != Config::readValue("searchMode", "main") || ! Config::readString("batchFile", "main").empty());
+    if (inProcess && AlgorithmRegistry::defaultAlgorithmId != engine->algorithmId) {
+        Logger::writeToLogFile("ERROR: Only child processes can search with the %s engine. Main process exits!", std::string(engine->name));
+        exit(EXIT_FAILURE);
+    }
+    this->algorithmId = engine->algorithmId;
+    
+    // the known and the unknown key bits, and the part of the key space to
+    // search.
+    uint64_t firstCandidate, lastCandidate;
+    KeyPattern pattern = this->readKeyspace(firstCandidate, lastCandidate, keyList, wordList);
+    
+    // a batch file (batchFile) holds the pairs of a batch search, which
+    // always runs in threads and isn't checkpointed.
+    std::string batchFile = Config::readString("batchFile", "main");
+    if (! batchFile.empty()) {
+        this->searchBatch(batchFile, pattern, firstCandidate, lastCandidate, Config::readValue("numberOfThreads", "main"));
+        
+        // log the main process' terminate event.
+        Logger::writeToLogFile("Main process ended!");
+        return;
+    }
+    
+    // a target file (targetFile) holds the raw/encrypted string pair to
+    // search for, in the format of a batch file.
+    this->targetFile = Config::readString("targetFile", "main");
+    std::string rawString, encryptedString;
+    if (! this->targetFile.empty() && ! TargetSet::loadPair(this->targetFile, rawString, encryptedString)) {
+        Logger::writeToLogFile("ERROR: Can't read the pair of the target file %s. Main process exits!", this->targetFile);
+        exit(EXIT_FAILURE);
+    }
+    
+    // a meet in the middle search (searchMode = 3) looks for the two keys of
+    // double DES in this process; it isn't checkpointed.
+    if (3 == Config::readValue("searchMode", "main")) {
+        if (NULL != keyList || NULL != wordList) {
+            Logger::writeToLogFile("ERROR: A key or word file can't be searched in the middle. Main process exits!");
+            exit(EXIT_FAILURE);
+        }
+        this->meetInTheMiddle(rawString, encryptedString, pattern, firstCandidate, lastCandidate);
+        
+        // log the main process' terminate event.
+        Logger::writeToLogFile("Main process ended!");
+        return;
+    }
+    
+    // a search of the same key space that was stopped goes on where it was,
+    // with the same raw/encrypted string pair. the lines of a key or word
+    // file aren't checkpointed.
+    Checkpoint checkpoint(pattern, firstCandidate, lastCandidate);
+    uint64_t searchFrom = firstCandidate;
+    if (NULL == keyList && NULL == wordList && checkpoint.load()) {
+        // the children map the target file only if it still holds the pair.
+        if (rawString != checkpoint.getRawString() || encryptedString != checkpoint.getEncryptedString()) {
+            this->targetFile.clear();
+        }
+        rawString = checkpoint.getRawString();
+        encryptedString = checkpoint.getEncryptedString();
+        searchFrom = checkpoint.getSearchedUpTo();
+        
+        std::stringstream message;
+        message << "Resuming the search from the checkpoint at candidate " << searchFrom << "!";
+        Logger::writeToLogFile(message.str());
+    } else if (this->targetFile.empty()) {
+        // create a random seed.
+        srand((unsigned) time(NULL));
+        
+        // generate the random key (NUL-terminated, it is logged as a string).
+        char key[64 + 1];
+        AlgorithmInterface::candidateToKey(this->generateRandomKey(pattern), 64, key);
+        Logger::writeToLogFile("Key is: %s", (const char*) key);
+        
+        // the keys of a Triple-DES engine past the first one are the known
+        // ones (secondKey and thirdKey in [keyspace]).
+        std::string keyString(key);
+        const char* outerKeys[] = { "secondKey", "thirdKey" };
+        for (int i = 0; 64 * (i + 1) < engine->keyLength; i++) {
+            AlgorithmInterface::candidateToKey(strtoull(Config::readString(outerKeys[i], "keyspace").c_str(), NULL, 16), 64, key);
+            keyString += key;
+        }
+        
+        // ---------------------------------------------------------------------
+        // @todo
+        AlgorithmInterface* algorithm = engine->create();
+        rawString = "This is the raw string!";
+        encryptedString = algorithm->encrpyt(rawString, keyString.c_str(), engine->keyLength);
+        delete algorithm;
+        checkpoint.setTarget(rawString, encryptedString);
+    } else {
+        checkpoint.setTarget(rawString, encryptedString);
+    }
+    
+    // the progress is written to the checkpoint file every
+    // checkpointInterval seconds (0 turns it off).
+    int checkpointInterval = (NULL == keyList && NULL == wordList) ? Config::readValue("checkpointInterval", "main") : 0;
+    
+    // the agents of a coordinator get the job over the network; they have no
+    // key or word file to map.
+    if (2 == Config::readValue("searchMode", "main") && (NULL != keyList || NULL != wordList)) {
+        Logger::writeToLogFile("ERROR: A key or word file can't be searched by agents. Main process exits!");
+        exit(EXIT_FAILURE);
+    }
+    
+    // the search runs either in worker threads of this process (searchMode =
+    // 1), on the agents that connect to this process (searchMode = 2) or in
+    // child processes, which keeps every search isolated.
+    if (1 == Config::readValue("searchMode", "main")) {
+        this->searchInThreads(rawString, encryptedString, pattern, searchFrom, lastCandidate, Config::readValue("numberOfThreads", "main"), &checkpoint, checkpointInterval,
+            keyList, wordList);
+        
+        // log the main process' terminate event.
+        Logger::writeToLogFile("Main process ended!");
+        return;
+    }
+    if (2 == Config::readValue("searchMode", "main")) {
+        this->coordinate(rawString, encryptedString, pattern, searchFrom, lastCandidate, &checkpoint, checkpointInterval);
+        
+        // log the main process' terminate event.
+        Logger::writeToLogFile("Main process ended!");
+        return;
+    }
+    
     // calculate the number of child processes to be created.
     int processCount = this->getNumberOfChildren(Config::readValue("numberOfChildren", "main"));
     
     // store the process ids of all child processes. it will be used for waiting
     // for their termination.
     int processIds[processCount];
-
-    // create a random seed.
-    srand((unsigned) time(NULL));
-    // create the key.
-    std::vector<unsigned char> key(56, '0');
-    // generate the key randomly.
-
-    for (int i = 40; i < 56; i++) {
-        int ran = (((((rand()) % 65536) + 1) >> i) & 1);
-        if (0 == ran) {
-            key.at(i) = '0';
-        } else {
-            key.at(i) = '1';
-        }
-    }
-
-    // generate the random key.
-    Logger::writeToLogFile("Key is: %s", (const char*) key.data());
     
-    // -------------------------------------------------------------------------
-    // @todo
-    AlgorithmDES algoDES;
-    std::string rawString("This is the raw string!");
-    std::string encryptedString;
-    encryptedString = algoDES.encrpyt(rawString, (const char*) key.data(), 56);
+    // the children take chunks of the key space from the control block in
+    // shared memory, so that none of them sits idle while the others are
+    // busy. they also publish their progress and the key there, and watch it
+    // for the signal to stop.
+    std::stringstream controlName;
+    controlName << "/mpad-control-" << getpid();
+    ControlBlock* control = ControlBlock::create(controlName.str(), processCount, searchFrom, lastCandidate);
+    if (NULL == control) {
+        Logger::writeToLogFile("ERROR: Could not create the shared control block. Main process exits!");
+        exit(EXIT_FAILURE);
+    }
+    Logger::writeTraceEvent(TRACE_SEARCH_START, 0, searchFrom, lastCandidate, processCount, 0);
     
     // create child processes.
     for (int i = 0; i < processCount; i++) {
         // store the child process id in the local variable.
-        processIds[i] = this->createChild(rawString, encryptedString, 1, 56, i, processCount);
+        processIds[i] = this->createChild(rawString, encryptedString, this->algorithmId, pattern, controlName.str(), i);
+        
+        // a child that was never created holds no chunk back.
+        if (0 >= processIds[i]) {
+            control->getWorker(i)->lowWaterMark.store(lastCandidate);
+        }
     }
+    checkpoint.start(control, checkpointInterval);
     // -------------------------------------------------------------------------
     
-    // wait for each child to exit.
+    // count the children that are running.
+    int runningCount = 0;
     for (int i = 0; i < processCount; i++) {
+        if (0 < processIds[i]) {
+            runningCount++;
+        }
+    }
+    
+    // a child that dies is replaced, a limited number of times, by a new one
+    // that takes over its entry in the control block and with it the chunk
+    // it left unfinished.
+    int respawnCount = 0;
+    
+    // react to whichever child exits first, instead of waiting for them in
+    // the order they were created.
+    while (0 < runningCount) {
         // create a local variable for the exit status of the child process.
         int status;
         
-        // wait for the ith child to terminate.
-        while (-1 == waitpid(processIds[i], &status, 0));
+        // wait for any child to terminate.
+        pid_t pid = waitpid(-1, &status, 0);
+        if (-1 == pid) {
+            if (EINTR == errno) {
+                continue;
+            }
+            break;
+        }
+        
+        // find which child it was.
+        int index = -1;
+        for (int i = 0; i < processCount; i++) {
+            if (pid == processIds[i]) {
+                index = i;
+            }
+        }
+        if (-1 == index) {
+            continue;
+        }
+        processIds[index] = -1;
+        runningCount--;
+        Logger::writeTraceEvent(TRACE_CHILD_EXIT, index, 0, 0, status, pid);
         
         // log the child process' terminate event.
         Logger::writeToLogFile("Child process %s is terminated!",
-            this->generateChildName(processIds[i])
+            this->generateChildName(pid)
         );
         
-        if (WIFEXITED(status)) {
-            // if the key is found;
-            if (2 == WEXITSTATUS(status)) {
-                Logger::writeToLogFile("All child processes will be terminated now!");
-
-                // kill all child processes.
-                for (int i = 0; i < processCount; i++) {
-                    kill(processIds[i], SIGTERM);
+        // if the key is found, cancel the others right away; they stop
+        // within a few passes.
+        if (WIFEXITED(status) && 2 == WEXITSTATUS(status)) {
+            Logger::writeToLogFile("All child processes will be terminated now!");
+            control->cancel();
+        }
+        
+        // if the child was killed by a signal in the middle of the search,
+        // start a new one in its place.
+        else if (WIFSIGNALED(status) && ! control->isCancelled()) {
+            if (respawnCount < MainProcess::maxRespawnCount) {
+                Logger::writeToLogFile("ERROR: Child process %s crashed, a new one will take its place!", this->generateChildName(pid));
+                respawnCount++;
+                
+                processIds[index] = this->createChild(rawString, encryptedString, this->algorithmId, pattern, controlName.str(), index);
+                if (0 < processIds[index]) {
+                    runningCount++;
                 }
+            } else {
+                WorkerStatus* worker = control->getWorker(index);
+                std::stringstream message;
+                message << "ERROR: Child process %s crashed and can't be replaced; [" << worker->chunkFirst.load() << ", " << worker->chunkLast.load() << ") is not searched!";
+                Logger::writeToLogFile(message.str(), this->generateChildName(pid));
             }
         }
     }
     
+    // the result and the progress are in the control block.
+    checkpoint.stop();
+    Logger::writeTraceEvent(TRACE_SEARCH_END, 0, searchFrom, lastCandidate, control->getKeysSearched(), control->getKeysPerSecond());
+    // a word list is handed out by byte offset, so its progress is in bytes.
+    const char* unit = (NULL != wordList) ? "bytes" : "keys";
+    std::stringstream summary;
+    summary << "Searched " << control->getKeysSearched() << " " << unit << " at " << control->getKeysPerSecond() << " " << unit << "/second!";
+    Logger::writeToLogFile(summary.str());
+    if (control->isFound()) {
+        this->logFoundKey(pattern, keyList, wordList, control->getFoundCandidate());
+    }
+    
+    ControlBlock::close(control);
+    ControlBlock::remove(controlName.str());
+    
     // log the main process' terminate event.
     Logger::writeToLogFile("Main process ended!");
 }
@@ -138,38 +433,58 @@ MainProcess::MainProcess()
  * error message.
  * 
  * @see ChildProcess
+ * @param pattern The known and the free bits of the keys searched.
+ * @param controlName Name of the shared memory segment that holds the
+ * control block.
+ * @param childIndex Index of the child's entry in the control block.
  * @return The process id of the created child process. 
  */
-pid_t MainProcess::createChild(std::string rawString, std::string encryptedString, int algorithmId, int keyLength, int partitionNumber, int partitionSize)
+pid_t MainProcess::createChild(std::string rawString, std::string encryptedString, int algorithmId, const KeyPattern& pattern, std::string controlName, int childIndex)
 {
     // log the child process' creation event.
     Logger::writeToLogFile("A new child will be created!");
     
     // fork the process (create the child).
     pid_t pid = fork();
-
+    
     // if this is the child process;
     if (0 == pid) {
         // generate a name for the child process.
         std::string childName = this->generateChildName((int) getpid()).c_str();
-
+        
         std::stringstream ss1, ss2, ss3, ss4;
         ss1 << algorithmId;
-        ss2 << keyLength;
-        ss3 << partitionNumber;
-        ss4 << partitionSize;
+        ss2 << std::hex << pattern.getKnownKey();
+        ss3 << std::hex << pattern.getUnknownMask();
+        ss4 << childIndex;
+        
+        // the strings are hex encoded, as a NUL byte would end an argument;
+        // a pair from a target file is passed as "@<path>" instead, as the
+        // arguments are limited in size. the child maps the key file and the
+        // word file, if any, named by the last two arguments ("-" is none).
+        std::string rawHex = this->targetFile.empty() ? AlgorithmInterface::encodeHex(rawString) : "@" + this->targetFile;
+        std::string encryptedHex = this->targetFile.empty() ? AlgorithmInterface::encodeHex(encryptedString) : "-";
         
         // then instantiate the ChildProcess class.
-        execl("./child_p", "child_p", childName.c_str(), rawString.c_str(), encryptedString.c_str(), ss1.str().c_str(), ss2.str().c_str(), ss3.str().c_str(), ss4.str().c_str(), NULL);
+        std::string keyArgument = this->keyFile.empty() ? "-" : this->keyFile;
+        std::string wordArgument = this->wordFile.empty() ? "-" : this->wordFile;
+        execl("./child_p", "child_p", childName.c_str(), rawHex.c_str(), encryptedHex.c_str(), ss1.str().c_str(), ss2.str().c_str(), ss3.str().c_str(), controlName.c_str(), ss4.str().c_str(),
+            keyArgument.c_str(), wordArgument.c_str(), (const char*) NULL);
+        
+        // execl only returns if child_p couldn't be run; the forked copy of
+        // the main process must not go on as one.
+        Logger::writeToLogFile("ERROR: Can't run child_p!");
+        Logger::flush();
+        _exit(EXIT_FAILURE);
         /*
         // if an error occurred;
         if (0 != status) {
             // create a local variable for the error number.
             char errorBuffer[5];
-
+            
             // write the error number to the buffer.
             sprintf(errorBuffer, "%d", errno);
-        
+            
             // log the corresponding error message (including the error number).
             Logger::writeToLogFile("ERROR: An error occurred, error %s!", errorBuffer);
         }
@@ -180,6 +495,7 @@ pid_t MainProcess::createChild(std::string rawString, std::string encryptedStrin
     else if (0 < pid) {
         // log the child process' created event.
         Logger::writeToLogFile("Created %s!", this->generateChildName(pid));
+        Logger::writeTraceEvent(TRACE_CHILD_SPAWN, childIndex, 0, 0, 0, pid);
     }
     
     // if the child could not be created;
@@ -198,6 +514,247 @@ pid_t MainProcess::createChild(std::string rawString, std::string encryptedStrin
     return pid;
 }
 
+/**
+ * Searches the key space with worker threads of the main process, one
+ * per core unless the configuration says otherwise, and logs the key if it
+ * is found.
+ * 
+ * @see ThreadedSearch
+ * @param pattern The known and the free bits of the keys searched.
+ * @param firstCandidate First candidate of the search.
+ * @param lastCandidate End of the search (the candidate after the last one).
+ * @param numberOfThreads Number of worker threads; 0 means one per core.
+ * @param checkpoint Where the progress is written to.
+ * @param checkpointInterval Seconds between two checkpoints; 0 means none.
+ * @param keys The key list searched, or NULL to search the key pattern.
+ * @param words The word list searched, or NULL.
+ */
+void MainProcess::searchInThreads(std::string rawString, std::string encryptedString, const KeyPattern& pattern, uint64_t firstCandidate, uint64_t lastCandidate, int numberOfThreads,
+    Checkpoint* checkpoint, int checkpointInterval, const KeyList* keys, const WordList* words)
+{
+    ThreadedSearch search(rawString, encryptedString, pattern, numberOfThreads);
+    search.setCheckpoint(checkpoint, checkpointInterval);
+    search.setKeyList(keys);
+    search.setWordList(words);
+    
+    // make sure that the kernels agree with the reference implementation
+    // before trusting them.
+    if (! search.getAlgorithm().selfTest()) {
+        Logger::writeToLogFile("ERROR: The bitsliced DES self-test failed. Main process exits!");
+        exit(EXIT_FAILURE);
+    }
+    
+    std::stringstream message;
+    message << "Searching with " << search.getNumberOfThreads() << " threads and the " << search.getAlgorithm().getKernelName() << " bitsliced DES kernel!";
+    Logger::writeToLogFile(message.str());
+    
+    uint64_t foundCandidate;
+    Logger::writeTraceEvent(TRACE_SEARCH_START, 0, firstCandidate, lastCandidate, search.getNumberOfThreads(), 0);
+    bool found = search.run(firstCandidate, lastCandidate, foundCandidate);
+    
+    if (NULL != search.getControlBlock()) {
+        // a word list is handed out by byte offset, so its progress is in
+        // bytes.
+        const char* unit = (NULL != words) ? "bytes" : "keys";
+        std::stringstream summary;
+        summary << "Searched " << search.getControlBlock()->getKeysSearched() << " " << unit << " at " << search.getControlBlock()->getKeysPerSecond() << " " << unit << "/second!";
+        Logger::writeTraceEvent(TRACE_SEARCH_END, 0, firstCandidate, lastCandidate, search.getControlBlock()->getKeysSearched(), search.getControlBlock()->getKeysPerSecond());
+        Logger::writeToLogFile(summary.str());
+    }
+    if (found) {
+        this->logFoundKey(pattern, keys, words, foundCandidate);
+    }
+}
+
+/**
+ * Logs the key of the matching candidate: the key of the pattern, the key on
+ * the line of the key file, or the password at the offset in the word file
+ * and its key.
+ * 
+ * @param pattern The known and the free bits of the keys searched.
+ * @param keys The key list searched, or NULL.
+ * @param words The word list searched, or NULL.
+ * @param candidate The matching candidate.
+ */
+void MainProcess::logFoundKey(const KeyPattern& pattern, const KeyList* keys, const WordList* words, uint64_t candidate)
+{
+    char key[64 + 1];
+    uint64_t listedKey;
+    if (NULL != words) {
+        std::string word = words->getWord(candidate);
+        Logger::writeToLogFile("The password is found! Password is: %s", word);
+        AlgorithmInterface::candidateToKey(WordList::deriveKey(word.data(), word.size()), 64, key);
+    } else if (NULL != keys && keys->getKey(candidate, listedKey)) {
+        AlgorithmInterface::candidateToKey(listedKey, 64, key);
+    } else {
+        pattern.getKeyString(candidate, key);
+    }
+    
+    Logger::writeToLogFile("The key is found! Key is: %s", (const char*) key);
+}
+
+/**
+ * Searches the key space for the keys of every raw/encrypted string pair in a
+ * file at once, with worker threads of the main process, and logs the key of
+ * each pair that has one.
+ * 
+ * @see TargetSet
+ * @param path The file of the pairs.
+ * @param pattern The known and the free bits of the keys searched.
+ * @param firstCandidate First candidate of the search.
+ * @param lastCandidate End of the search (the candidate after the last one).
+ * @param numberOfThreads Number of worker threads; 0 means one per core.
+ */
+void MainProcess::searchBatch(std::string path, const KeyPattern& pattern, uint64_t firstCandidate, uint64_t lastCandidate, int numberOfThreads)
+{
+    TargetSet targets;
+    if (! targets.load(path) || 0 == targets.getNumberOfTargets()) {
+        Logger::writeToLogFile("ERROR: Can't read the pairs of the batch file %s. Main process exits!", path.c_str());
+        exit(EXIT_FAILURE);
+    }
+    
+    ThreadedSearch search("", "", pattern, numberOfThreads);
+    search.setTargets(&targets);
+    if (! search.getAlgorithm().selfTest()) {
+        Logger::writeToLogFile("ERROR: The bitsliced DES self-test failed. Main process exits!");
+        exit(EXIT_FAILURE);
+    }
+    
+    std::stringstream message;
+    message << "Searching for the keys of " << targets.getNumberOfTargets() << " pairs (" << targets.getNumberOfGroups() << " different first blocks) with "
+        << search.getNumberOfThreads() << " threads and the " << search.getAlgorithm().getKernelName() << " bitsliced DES kernel!";
+    Logger::writeToLogFile(message.str());
+    
+    uint64_t foundCandidate;
+    Logger::writeTraceEvent(TRACE_SEARCH_START, 0, firstCandidate, lastCandidate, search.getNumberOfThreads(), 0);
+    search.run(firstCandidate, lastCandidate, foundCandidate);
+    
+    if (NULL != search.getControlBlock()) {
+        std::stringstream summary;
+        summary << "Searched " << search.getControlBlock()->getKeysSearched() << " keys at " << search.getControlBlock()->getKeysPerSecond() << " keys/second!";
+        Logger::writeTraceEvent(TRACE_SEARCH_END, 0, firstCandidate, lastCandidate, search.getControlBlock()->getKeysSearched(), search.getControlBlock()->getKeysPerSecond());
+        Logger::writeToLogFile(summary.str());
+    }
+    for (int i = 0; i < targets.getNumberOfTargets(); i++) {
+        if (targets.isFound(i)) {
+            char key[64 + 1];
+            pattern.getKeyString(targets.getFoundCandidate(i), key);
+            std::stringstream found;
+            found << "The key of pair " << i + 1 << " is found! Key is: " << key;
+            Logger::writeToLogFile(found.str());
+        }
+    }
+    
+    std::stringstream result;
+    result << "Found the keys of " << targets.getNumberOfFound() << " of " << targets.getNumberOfTargets() << " pairs!";
+    Logger::writeToLogFile(result.str());
+}
+
+/**
+ * Searches the two keys of double DES with a meet in the middle search in
+ * this process: the first keys are those of the key space, the second ones
+ * those of secondKey and secondUnknownMask in the [keyspace] section of the
+ * configuration file. The memory the hash table may take (memoryLimit, in
+ * MB) and where it spills to (spillDirectory) are in the [meet] section.
+ * Without a target file, a random pair of keys is searched for.
+ * 
+ * @see MeetInTheMiddle
+ * @param pattern The known and the free bits of the first keys.
+ * @param firstCandidate First candidate of the first keys.
+ * @param lastCandidate End of the first keys (the candidate after the last
+ * one).
+ */
+void MainProcess::meetInTheMiddle(std::string rawString, std::string encryptedString, const KeyPattern& pattern, uint64_t firstCandidate, uint64_t lastCandidate)
+{
+    std::string secondKey = Config::readString("secondKey", "keyspace");
+    std::string secondUnknownMask = Config::readString("secondUnknownMask", "keyspace");
+    KeyPattern secondPattern(strtoull(secondKey.c_str(), NULL, 16), strtoull(secondUnknownMask.c_str(), NULL, 16));
+    if (0 == secondPattern.getFreeBits() || 63 < secondPattern.getFreeBits()) {
+        Logger::writeToLogFile("ERROR: The unknown mask of the second key must have 1 to 63 bits set. Main process exits!");
+        exit(EXIT_FAILURE);
+    }
+    
+    int memoryLimit = Config::readValue("memoryLimit", "meet");
+    std::string spillDirectory = Config::readString("spillDirectory", "meet");
+    if (0 >= memoryLimit) {
+        memoryLimit = 256;
+    }
+    if (spillDirectory.empty()) {
+        spillDirectory = "/tmp";
+    }
+    
+    char key[64 + 1];
+    if (rawString.empty()) {
+        srand((unsigned) time(NULL));
+        uint64_t firstKey = this->generateRandomKey(pattern), secondRandomKey = this->generateRandomKey(secondPattern);
+        AlgorithmInterface::candidateToKey(firstKey, 64, key);
+        Logger::writeToLogFile("First key is: %s", (const char*) key);
+        AlgorithmInterface::candidateToKey(secondRandomKey, 64, key);
+        Logger::writeToLogFile("Second key is: %s", (const char*) key);
+        
+        rawString = "This is the raw string!";
+        encryptedString = MeetInTheMiddle::encrypt(rawString, firstKey, secondRandomKey);
+    }
+    
+    std::stringstream message;
+    message << "Meeting in the middle of " << (lastCandidate - firstCandidate) << " first keys and " << secondPattern.getNumberOfCandidates() << " second keys, in "
+        << memoryLimit << " MB!";
+    Logger::writeToLogFile(message.str());
+    
+    MeetInTheMiddle search(pattern, secondPattern, (size_t) memoryLimit << 20, spillDirectory);
+    uint64_t firstFound, secondFound;
+    if (search.search(rawString, encryptedString, firstCandidate, lastCandidate, firstFound, secondFound)) {
+        pattern.getKeyString(firstFound, key);
+        Logger::writeToLogFile("The first key is found! Key is: %s", (const char*) key);
+        secondPattern.getKeyString(secondFound, key);
+        Logger::writeToLogFile("The second key is found! Key is: %s", (const char*) key);
+    } else {
+        Logger::writeToLogFile("No pair of keys is found!");
+    }
+}
+
+/**
+ * Hands the key space out to worker agents, on this machine or on others,
+ * that connect to the address in the [coordinator] section of the
+ * configuration file, and logs the key if it is found.
+ * 
+ * @see Coordinator
+ * @see WorkerAgent
+ * @param pattern The known and the free bits of the keys searched.
+ * @param firstCandidate First candidate of the search.
+ * @param lastCandidate End of the search (the candidate after the last one).
+ * @param checkpoint Where the progress is written to.
+ * @param checkpointInterval Seconds between two checkpoints; 0 means none.
+ */
+void MainProcess::coordinate(std::string rawString, std::string encryptedString, const KeyPattern& pattern, uint64_t firstCandidate, uint64_t lastCandidate,
+    Checkpoint* checkpoint, int checkpointInterval)
+{
+    std::string address = Config::readString("address", "coordinator");
+    if (address.empty()) {
+        address = "127.0.0.1:7650";
+    }
+    
+    Coordinator coordinator(rawString, encryptedString, pattern, firstCandidate, lastCandidate);
+    coordinator.setCheckpoint(checkpoint, checkpointInterval);
+    coordinator.setLeaseTimes(Config::readValue("leaseSeconds", "coordinator"), Config::readValue("leaseTimeout", "coordinator"));
+    
+    uint64_t foundCandidate;
+    Logger::writeTraceEvent(TRACE_SEARCH_START, 0, firstCandidate, lastCandidate, 0, 0);
+    bool found = coordinator.run(address, foundCandidate);
+    Logger::writeTraceEvent(TRACE_SEARCH_END, 0, firstCandidate, lastCandidate, coordinator.getKeysSearched(), 0);
+    
+    std::stringstream summary;
+    summary << "The agents have searched " << coordinator.getKeysSearched() << " keys!";
+    Logger::writeToLogFile(summary.str());
+    if (found) {
+        // create the key string of the matching candidate.
+        char key[64 + 1];
+        pattern.getKeyString(foundCandidate, key);
+        
+        Logger::writeToLogFile("The key is found! Key is: %s", (const char*) key);
+    }
+}
+
 /**
  * Given the number of child processes to be created from the
  * configuration file, checks the process quota of the current user,
@@ -286,33 +843,89 @@ int MainProcess::getNumberOfChildren(int numberOfChildren)
         Logger::writeToLogFile("The number of child processes to be created defined in the configuration file exceeds the process quota for the current user; so the configuration setting is discarded. Instead, the maximum value will be used.");
         numberOfChildren = maxNumberOfChildProcesses;
     }
-        
+    
     // return the number of child processes to be created.
     return numberOfChildren;
 }
 
 /**
- * Given an integer that represents the length of the key to be produced,
- * generates a random key and returns it.
- * 
- * Note that the size of the key length can be 128 at maximum.
+ * Generates a random key that fits the given key pattern: the known bits as
+ * they are, random unknown bits.
  * 
- * @see ChildProcess
- * @param numberOfBits Length of the key to be generated.
- * @return The randomly generated ley.
+ * @see KeyPattern
+ * @param pattern The known and the free bits of the key.
+ * @return The randomly generated key.
  */
-std::vector<unsigned char> generateRandomKey(int numberOfBits)
+uint64_t MainProcess::generateRandomKey(const KeyPattern& pattern)
 {
-    // create the key.
-    std::vector<unsigned char> key(numberOfBits, '0');
-
-    // generate the key randomly.
-    for (int i = 0; i < numberOfBits; i++) {
-        key.at(i) = (unsigned char) (rand() % 2);
+    // rand() gives at least 15 random bits at a time.
+    uint64_t random = 0;
+    for (int i = 0; i < 5; i++) {
+        random = (random << 15) ^ (uint64_t) rand();
     }
     
     // return the key.
-    return key;
+    return pattern.getKey(random & (pattern.getNumberOfCandidates() - 1));
+}
+
+/**
+ * Reads the key space of the search from the [keyspace] section of the
+ * configuration file: the known key bits (knownKey, hex), the unknown ones
+ * (unknownMask, hex) and the candidates to search (firstCandidate, and
+ * lastCandidate, 0 for up to the last one). Without the section, key bits 40
+ * to 55 are searched. With a key list, the candidates are the lines of the
+ * list; with a word list, the byte offsets in it.
+ * 
+ * @see Config
+ * @see KeyPattern
+ * @param firstCandidate Receives the first candidate of the search.
+ * @param lastCandidate Receives the end of the search.
+ * @param keys The key list, or NULL to search the key pattern.
+ * @param words The word list, or NULL.
+ * @return The key pattern; the application exits if the section is not
+ * valid.
+ */
+KeyPattern MainProcess::readKeyspace(uint64_t& firstCandidate, uint64_t& lastCandidate, const KeyList* keys, const WordList* words)
+{
+    std::string knownKey = Config::readString("knownKey", "keyspace");
+    std::string unknownMask = Config::readString("unknownMask", "keyspace");
+    KeyPattern pattern(strtoull(knownKey.c_str(), NULL, 16), unknownMask.empty() ? 0x0000000000FFFF00ULL : strtoull(unknownMask.c_str(), NULL, 16));
+    
+    // a search of 2^64 candidates can't be counted in 64 bits; the parity
+    // bits are ignored by DES anyway.
+    if (NULL == keys && NULL == words && (0 == pattern.getFreeBits() || 63 < pattern.getFreeBits())) {
+        Logger::writeToLogFile("ERROR: The unknown key mask must have 1 to 63 bits set. Main process exits!");
+        exit(EXIT_FAILURE);
+    }
+    
+    // a search can be resumed from a candidate on, and end early.
+    firstCandidate = strtoull(Config::readString("firstCandidate", "keyspace").c_str(), NULL, 10);
+    lastCandidate = strtoull(Config::readString("lastCandidate", "keyspace").c_str(), NULL, 10);
+    uint64_t numberOfCandidates = pattern.getNumberOfCandidates();
+    if (NULL != keys) {
+        numberOfCandidates = keys->getNumberOfKeys();
+    } else if (NULL != words) {
+        numberOfCandidates = words->getSize();
+    }
+    if (0 == lastCandidate || numberOfCandidates < lastCandidate) {
+        lastCandidate = numberOfCandidates;
+    }
+    if (firstCandidate >= lastCandidate) {
+        Logger::writeToLogFile("ERROR: The first candidate is past the last one. Main process exits!");
+        exit(EXIT_FAILURE);
+    }
+    
+    std::stringstream message;
+    if (NULL != words) {
+        message << "Searching bytes " << firstCandidate << " to " << lastCandidate << " of the word file!";
+    } else if (NULL != keys) {
+        message << "Searching lines " << firstCandidate << " to " << lastCandidate << " of the key file!";
+    } else {
+        message << "Searching candidates " << firstCandidate << " to " << lastCandidate << " of " << pattern.getFreeBits() << " unknown key bits!";
+    }
+    Logger::writeToLogFile(message.str());
+    
+    return pattern;
 }
 
 /**
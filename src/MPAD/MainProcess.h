@@ -18,6 +18,18 @@
 // include the vector library.
 #include <vector>
 
+// include the KeyPattern class signature.
+#include "KeyPattern.h"
+
+// include the Checkpoint class signature.
+#include "Checkpoint.h"
+
+// include the KeyList class signature.
+#include "KeyList.h"
+
+// include the WordList class signature.
+#include "WordList.h"
+
 /**
  * Signature of the MainProcess class.
  * 
@@ -42,9 +54,118 @@ class MainProcess
          * Tries to create a new child process.
          * 
          * @see ChildProcess
+         * @param pattern The known and the free bits of the keys searched.
+         * @param controlName Name of the shared memory segment that holds the
+         * control block.
+         * @param childIndex Index of the child's entry in the control block.
          * @return The process id of the created child process. 
          */
-        pid_t createChild(std::string rawString, std::string encryptedString, int algorithmId, int keyLength, int partitionNumber, int partitionSize);
+        pid_t createChild(std::string rawString, std::string encryptedString, int algorithmId, const KeyPattern& pattern, std::string controlName, int childIndex);
+        
+        /**
+         * Searches the key space with worker threads of the main
+         * process instead of child processes, and logs the key if it is
+         * found.
+         * 
+         * @see ThreadedSearch
+         * @param pattern The known and the free bits of the keys searched.
+         * @param firstCandidate First candidate of the search.
+         * @param lastCandidate End of the search (the candidate after the
+         * last one).
+         * @param numberOfThreads Number of worker threads; 0 means one per
+         * core.
+         * @param checkpoint Where the progress is written to.
+         * @param checkpointInterval Seconds between two checkpoints; 0 means
+         * none.
+         * @param keys The key list searched, or NULL to search the key
+         * pattern.
+         * @param words The word list searched, or NULL.
+         */
+        void searchInThreads(std::string rawString, std::string encryptedString, const KeyPattern& pattern, uint64_t firstCandidate, uint64_t lastCandidate, int numberOfThreads,
+            Checkpoint* checkpoint, int checkpointInterval, const KeyList* keys, const WordList* words);
+        
+        /**
+         * Logs the key of the matching candidate: the key of the pattern,
+         * the key on the line of the key file, or the password at the offset
+         * in the word file and its key.
+         * 
+         * @param pattern The known and the free bits of the keys searched.
+         * @param keys The key list searched, or NULL.
+         * @param words The word list searched, or NULL.
+         * @param candidate The matching candidate.
+         */
+        void logFoundKey(const KeyPattern& pattern, const KeyList* keys, const WordList* words, uint64_t candidate);
+        
+        /**
+         * Hands the key space out to worker agents, on this machine or on
+         * others, that connect to the address in the [coordinator] section
+         * of the configuration file, and logs the key if it is found.
+         * 
+         * @see Coordinator
+         * @see WorkerAgent
+         * @param pattern The known and the free bits of the keys searched.
+         * @param firstCandidate First candidate of the search.
+         * @param lastCandidate End of the search (the candidate after the
+         * last one).
+         * @param checkpoint Where the progress is written to.
+         * @param checkpointInterval Seconds between two checkpoints; 0 means
+         * none.
+         */
+        void coordinate(std::string rawString, std::string encryptedString, const KeyPattern& pattern, uint64_t firstCandidate, uint64_t lastCandidate,
+            Checkpoint* checkpoint, int checkpointInterval);
+        
+        /**
+         * Searches the key space for the keys of every raw/encrypted string
+         * pair in a file at once, with worker threads of the main process,
+         * and logs the key of each pair that has one.
+         * 
+         * @see TargetSet
+         * @param path The file of the pairs.
+         * @param pattern The known and the free bits of the keys searched.
+         * @param firstCandidate First candidate of the search.
+         * @param lastCandidate End of the search (the candidate after the
+         * last one).
+         * @param numberOfThreads Number of worker threads; 0 means one per
+         * core.
+         */
+        void searchBatch(std::string path, const KeyPattern& pattern, uint64_t firstCandidate, uint64_t lastCandidate, int numberOfThreads);
+        
+        /**
+         * Searches the two keys of double DES with a meet in the middle
+         * search in this process: the first keys are those of the key space,
+         * the second ones those of secondKey and secondUnknownMask in the
+         * [keyspace] section of the configuration file. The memory the hash
+         * table may take (memoryLimit, in MB) and where it spills to
+         * (spillDirectory) are in the [meet] section. Without a target file,
+         * a random pair of keys is searched for.
+         * 
+         * @see MeetInTheMiddle
+         * @param pattern The known and the free bits of the first keys.
+         * @param firstCandidate First candidate of the first keys.
+         * @param lastCandidate End of the first keys (the candidate after the
+         * last one).
+         */
+        void meetInTheMiddle(std::string rawString, std::string encryptedString, const KeyPattern& pattern, uint64_t firstCandidate, uint64_t lastCandidate);
+        
+        /**
+         * Reads the key space of the search from the [keyspace] section of
+         * the configuration file: the known key bits (knownKey, hex), the
+         * unknown ones (unknownMask, hex) and the candidates to search
+         * (firstCandidate, and lastCandidate, 0 for up to the last one).
+         * Without the section, key bits 40 to 55 are searched. With a key
+         * list, the candidates are the lines of the list; with a word list,
+         * the byte offsets in it.
+         * 
+         * @see Config
+         * @see KeyPattern
+         * @param firstCandidate Receives the first candidate of the search.
+         * @param lastCandidate Receives the end of the search.
+         * @param keys The key list, or NULL to search the key pattern.
+         * @param words The word list, or NULL.
+         * @return The key pattern; the application exits if the section is
+         * not valid.
+         */
+        KeyPattern readKeyspace(uint64_t& firstCandidate, uint64_t& lastCandidate, const KeyList* keys, const WordList* words);
         
         /**
          * Given the number of child processes to be created from the
@@ -59,17 +180,14 @@ class MainProcess
         int getNumberOfChildren(int numberOfChildren);
         
         /**
-         * Given the exact number of key length (e.g. 20-bits length), generates
-         * a random key.
-         * 
-         * For the purpose of this project, maximum number of key size is
-         * 128-bits.
+         * Generates a random key that fits the given key pattern: the known
+         * bits as they are, random unknown bits.
          * 
-         * @see ChildProcess
-         * @param numberOfBits Exact value of key length.
+         * @see KeyPattern
+         * @param pattern The known and the free bits of the key.
          * @return The randomly generated key.
          */
-        std::vector<unsigned char> generateRandomKey(int numberOfBits);
+        uint64_t generateRandomKey(const KeyPattern& pattern);
         
         /**
          * Given the process id of a child process, generates a unique name for
@@ -82,6 +200,28 @@ class MainProcess
          * @return Uniquely created name of the child process.
          */
         std::string generateChildName(pid_t childPID);
+        
+        /**
+         * Number of times a crashed child is replaced by a new one during a
+         * search, so that a child that crashes every time can't keep the main
+         * process busy forever.
+         */
+        static const int maxRespawnCount = 8;
+        
+        /**
+         * The file the string pair was read from, and the file of candidate
+         * keys or of passwords, if any; the children map them instead of
+         * getting their content on the command line.
+         */
+        std::string targetFile;
+        std::string keyFile;
+        std::string wordFile;
+        
+        /**
+         * Id of the engine the children search with (see
+         * AlgorithmRegistry).
+         */
+        int algorithmId;
 };
 
 // end of the class signature.
@@ -0,0 +1,144 @@
+/**
+ * File: MappedFile.cpp
+ * 
+ * Source code file for the MappedFile class.
+ * 
+ * @version 0.1
+ */
+
+// include the string library.
+#include <string.h>
+
+// include the file and memory mapping libraries.
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// include the signature of the class.
+#include "MappedFile.h"
+
+/**
+ * Constructor method of the class; nothing is mapped.
+ */
+MappedFile::MappedFile()
+{
+    this->data = NULL;
+    this->size = 0;
+}
+
+/**
+ * Destructor method of the class; unmaps the file.
+ */
+MappedFile::~MappedFile()
+{
+    if (NULL != this->data) {
+        munmap((void*) this->data, this->size);
+    }
+}
+
+/**
+ * Maps the file at the given path. The descriptor isn't needed once the file
+ * is mapped.
+ * 
+ * @return Whether the file could be opened and mapped; an empty file maps to
+ * no data.
+ */
+bool MappedFile::open(const std::string& path)
+{
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (0 > file) {
+        return false;
+    }
+    
+    struct stat status;
+    if (0 != fstat(file, &status) || ! S_ISREG(status.st_mode)) {
+        close(file);
+        return false;
+    }
+    
+    // mmap can't map zero bytes.
+    bool mapped = true;
+    if (0 < status.st_size) {
+        void* address = mmap(NULL, status.st_size, PROT_READ, MAP_SHARED, file, 0);
+        mapped = (MAP_FAILED != address);
+        if (mapped) {
+            this->data = (const char*) address;
+            this->size = status.st_size;
+        }
+    }
+    close(file);
+    
+    return mapped;
+}
+
+/**
+ * Tells the kernel that the file will be read from the beginning to the end,
+ * so that it reads ahead and drops the pages behind.
+ */
+void MappedFile::adviseSequential()
+{
+    if (NULL != this->data) {
+        madvise((void*) this->data, this->size, MADV_SEQUENTIAL);
+    }
+}
+
+/**
+ * Asks the kernel to start reading the given bytes in, so that they are in
+ * memory when they are touched. madvise takes whole pages; the range is
+ * widened to them.
+ */
+void MappedFile::prefetch(size_t offset, size_t length)
+{
+    if (NULL == this->data || offset >= this->size) {
+        return;
+    }
+    
+    size_t pageSize = (size_t) sysconf(_SC_PAGESIZE);
+    size_t start = offset - offset % pageSize;
+    size_t end = (offset + length < this->size) ? offset + length : this->size;
+    madvise((void*) (this->data + start), end - start, MADV_WILLNEED);
+}
+
+/**
+ * Returns the mapped bytes.
+ */
+const char* MappedFile::getData() const
+{
+    return this->data;
+}
+
+/**
+ * Returns the number of mapped bytes.
+ */
+size_t MappedFile::getSize() const
+{
+    return this->size;
+}
+
+/**
+ * Finds the line that starts at the given offset; a last line without a
+ * newline is a line too.
+ * 
+ * @param offset Offset of the line; receives the offset of the next one.
+ * @param line Receives the start of the line.
+ * @param length Receives the length of the line, without the newline (and
+ * the carriage return before it, if any).
+ * @return Whether there was a line at the offset.
+ */
+bool MappedFile::nextLine(size_t& offset, const char*& line, size_t& length) const
+{
+    if (offset >= this->size) {
+        return false;
+    }
+    
+    line = this->data + offset;
+    const char* end = (const char*) memchr(line, '\n', this->size - offset);
+    length = (NULL != end) ? end - line : this->size - offset;
+    offset += length + 1;
+    if (0 < length && '\r' == line[length - 1]) {
+        length--;
+    }
+    
+    return true;
+}
@@ -0,0 +1,107 @@
+/**
+ * File: MappedFile.h
+ * 
+ * Header file for the MappedFile class.
+ * 
+ * @version 0.1
+ */
+
+// make sure that the signature of the class is defined only once.
+#ifndef MAPPEDFILE_H
+#define	MAPPEDFILE_H
+
+// include the string library for the std::string class.
+#include <string>
+
+// include the size_t type.
+#include <stddef.h>
+
+/**
+ * Signature of the MappedFile class.
+ * 
+ * MappedFile maps an input file (a target file, a batch file or a list of
+ * candidate keys) into memory, read-only. Nothing is read up front: the
+ * pages are brought in as they are first touched, and come from the page
+ * cache, so every process that maps the same file (the main process and
+ * all its children) shares a single copy of it.
+ * 
+ * @since version 0.1
+ * @see TargetSet
+ * @see KeyList
+ */
+class MappedFile
+{
+    // public attributes and methods of the class.
+    public:
+        
+        /**
+         * Constructor method of the class; nothing is mapped.
+         */
+        MappedFile();
+        
+        /**
+         * Destructor method of the class; unmaps the file.
+         */
+        ~MappedFile();
+        
+        /**
+         * Maps the file at the given path.
+         * 
+         * @return Whether the file could be opened and mapped; an empty file
+         * maps to no data.
+         */
+        bool open(const std::string& path);
+        
+        /**
+         * Tells the kernel that the file will be read from the beginning to
+         * the end, so that it reads ahead and drops the pages behind.
+         */
+        void adviseSequential();
+        
+        /**
+         * Asks the kernel to start reading the given bytes in, so that they
+         * are in memory when they are touched.
+         */
+        void prefetch(size_t offset, size_t length);
+        
+        /**
+         * Returns the mapped bytes.
+         */
+        const char* getData() const;
+        
+        /**
+         * Returns the number of mapped bytes.
+         */
+        size_t getSize() const;
+        
+        /**
+         * Finds the line that starts at the given offset; a last line
+         * without a newline is a line too.
+         * 
+         * @param offset Offset of the line; receives the offset of the next
+         * one.
+         * @param line Receives the start of the line.
+         * @param length Receives the length of the line, without the newline
+         * (and the carriage return before it, if any).
+         * @return Whether there was a line at the offset.
+         */
+        bool nextLine(size_t& offset, const char*& line, size_t& length) const;
+    
+    // private attributes and methods of the class.
+    private:
+        
+        /**
+         * The mapped bytes (NULL if none), and their number.
+         */
+        const char* data;
+        size_t size;
+        
+        /**
+         * Copying would unmap the file twice.
+         */
+        MappedFile(const MappedFile&);
+        MappedFile& operator=(const MappedFile&);
+};
+
+// end of the class signature.
+#endif	/* MAPPEDFILE_H */
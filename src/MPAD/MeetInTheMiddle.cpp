@@ -0,0 +1,363 @@
+/**
+ * File: MeetInTheMiddle.cpp
+ * 
+ * Source code file for the MeetInTheMiddle class.
+ * 
+ * @version 0.1
+ */
+
+// include the stream related libraries.
+#include <sstream>
+
+// include the memory functions.
+#include <string.h>
+
+// include the mkstemp and unlink functions.
+#include <stdlib.h>
+#include <unistd.h>
+
+// include the signature of the class.
+#include "MeetInTheMiddle.h"
+
+// include the DESCore class signature.
+#include "DESCore.h"
+
+// include the AlgorithmInterface header file.
+#include "AlgorithmInterface.h"
+
+// include the Logger class signature.
+#include "Logger.h"
+
+/**
+ * Returns a block given as 8 bytes as a big-endian 64-bit word.
+ */
+static uint64_t loadBlock(const unsigned char* bytes)
+{
+    uint64_t block = 0;
+    for (int i = 0; i < 8; i++) {
+        block = (block << 8) | bytes[i];
+    }
+    return block;
+}
+
+/**
+ * Constructor method of the class.
+ * 
+ * @param firstPattern The known and the free bits of the first key.
+ * @param secondPattern The known and the free bits of the second key.
+ * @param memoryLimit Most bytes the hash table may take.
+ * @param spillDirectory Where the temporary files go.
+ */
+MeetInTheMiddle::MeetInTheMiddle(const KeyPattern& firstPattern, const KeyPattern& secondPattern, size_t memoryLimit, const std::string& spillDirectory)
+    : firstPattern(firstPattern), secondPattern(secondPattern)
+{
+    this->memoryLimit = memoryLimit;
+    this->spillDirectory = spillDirectory;
+    this->numberOfPartitions = 0;
+    this->rawString = NULL;
+    this->encryptedString = NULL;
+}
+
+/**
+ * Searches the first keys of [firstCandidate, lastCandidate) and every
+ * second key for the pair that encrypts the raw string into the encrypted
+ * one.
+ * 
+ * @param firstFound Receives the candidate of the first key, if any.
+ * @param secondFound Receives the candidate of the second key.
+ * @return Whether a pair was found; false on an error, too, which is logged.
+ */
+bool MeetInTheMiddle::search(const std::string& rawString, const std::string& encryptedString, uint64_t firstCandidate, uint64_t lastCandidate, uint64_t& firstFound, uint64_t& secondFound)
+{
+    // the blocks meet on the first block of the text, which has to be known:
+    // a trimmed string starts with a printable character.
+    if (8 > encryptedString.size() || rawString.empty() || 32 >= (unsigned char) rawString[0]) {
+        Logger::writeToLogFile("ERROR: A meet in the middle search needs the first block of the raw string!");
+        return false;
+    }
+    this->rawString = &rawString;
+    this->encryptedString = &encryptedString;
+    memset(this->plainBlock, ' ', sizeof(this->plainBlock));
+    memcpy(this->plainBlock, rawString.data(), (8 < rawString.size()) ? 8 : rawString.size());
+    memcpy(this->cipherBlock, encryptedString.data(), 8);
+    this->data.assign(encryptedString.size() - encryptedString.size() % 8, '\0');
+    
+    // the table is split into as many partitions as it takes for the table
+    // of one to fit; a partition gets an eighth more than its share, for the
+    // ones that come out bigger.
+    uint64_t entries = lastCandidate - firstCandidate;
+    int partitionBits = 0;
+    while (MeetInTheMiddle::maximumPartitions >= (1 << partitionBits)
+        && MeetInTheMiddle::getTableSlots((entries >> partitionBits) + (entries >> partitionBits) / 8) * sizeof(Entry) > this->memoryLimit) {
+        partitionBits++;
+    }
+    if (MeetInTheMiddle::maximumPartitions < (1 << partitionBits)) {
+        std::stringstream message;
+        message << "ERROR: The memory limit is too small for a meet in the middle search of " << entries << " first keys!";
+        Logger::writeToLogFile(message.str());
+        return false;
+    }
+    this->numberOfPartitions = 1 << partitionBits;
+    
+    if (0 == partitionBits) {
+        return this->searchInMemory(firstCandidate, lastCandidate, firstFound, secondFound);
+    }
+    return this->searchPartitioned(firstCandidate, lastCandidate, partitionBits, firstFound, secondFound);
+}
+
+/**
+ * Returns the number of partitions the last search was split into; 1 if its
+ * table fit in memory.
+ */
+int MeetInTheMiddle::getNumberOfPartitions()
+{
+    return this->numberOfPartitions;
+}
+
+/**
+ * Encrypts the raw string (padded with spaces to whole blocks) with double
+ * DES.
+ */
+std::string MeetInTheMiddle::encrypt(const std::string& rawString, uint64_t firstKey, uint64_t secondKey)
+{
+    std::string data(AlgorithmInterface::encryptedLength(rawString.size()), ' ');
+    memcpy(&data[0], rawString.data(), rawString.size());
+    
+    DESCore crypto;
+    crypto.setKey(firstKey);
+    crypto.encrypt((const unsigned char*) data.data(), (unsigned char*) &data[0], data.size());
+    crypto.setKey(secondKey);
+    crypto.encrypt((const unsigned char*) data.data(), (unsigned char*) &data[0], data.size());
+    
+    return data;
+}
+
+/**
+ * Searches with the whole table in memory.
+ */
+bool MeetInTheMiddle::searchInMemory(uint64_t firstCandidate, uint64_t lastCandidate, uint64_t& firstFound, uint64_t& secondFound)
+{
+    unsigned char block[8];
+    DESCore crypto;
+    
+    // the keys are patched from one candidate to the next, as the key
+    // searches do.
+    this->resetTable(lastCandidate - firstCandidate);
+    uint64_t key = this->firstPattern.getKey(firstCandidate);
+    crypto.setKey(key);
+    for (uint64_t i = firstCandidate; i < lastCandidate; i++, key = this->firstPattern.getNextKey(key)) {
+        crypto.updateKey(key);
+        crypto.encryptBlock(this->plainBlock, block);
+        this->insert(loadBlock(block), i);
+    }
+    
+    key = this->secondPattern.getKey(0);
+    crypto.setKey(key);
+    for (uint64_t i = 0; i < this->secondPattern.getNumberOfCandidates(); i++, key = this->secondPattern.getNextKey(key)) {
+        crypto.updateKey(key);
+        crypto.decryptBlock(this->cipherBlock, block);
+        if (this->probe(loadBlock(block), i, firstFound)) {
+            secondFound = i;
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+/**
+ * Searches with both sides split into partition files: the blocks of the
+ * first keys and of the second keys are written to the file of their
+ * partition, and then the table of each partition is built from its first
+ * file and probed with its second one.
+ */
+bool MeetInTheMiddle::searchPartitioned(uint64_t firstCandidate, uint64_t lastCandidate, int partitionBits, uint64_t& firstFound, uint64_t& secondFound)
+{
+    const int partitions = 1 << partitionBits;
+    std::stringstream message;
+    message << "Meet in the middle: the table of " << (lastCandidate - firstCandidate) << " first keys is split into " << partitions << " partitions in "
+        << this->spillDirectory << "!";
+    Logger::writeToLogFile(message.str());
+    
+    // the files are buffered with a share of the memory limit.
+    size_t bufferSize = this->memoryLimit / (4 * partitions);
+    bufferSize = (4096 > bufferSize) ? 4096 : ((1 << 20) < bufferSize) ? (1 << 20) : bufferSize;
+    std::vector<FILE*> firstFiles(partitions, (FILE*) NULL), secondFiles(partitions, (FILE*) NULL);
+    std::vector<uint64_t> firstCounts(partitions, 0);
+    bool opened = true;
+    for (int p = 0; p < partitions && opened; p++) {
+        firstFiles[p] = this->createSpillFile(bufferSize);
+        secondFiles[p] = this->createSpillFile(bufferSize);
+        opened = (NULL != firstFiles[p] && NULL != secondFiles[p]);
+    }
+    
+    bool written = opened, found = false;
+    if (opened) {
+        unsigned char block[8];
+        DESCore crypto;
+        Entry entry;
+        
+        uint64_t key = this->firstPattern.getKey(firstCandidate);
+        crypto.setKey(key);
+        for (uint64_t i = firstCandidate; i < lastCandidate; i++, key = this->firstPattern.getNextKey(key)) {
+            crypto.updateKey(key);
+            crypto.encryptBlock(this->plainBlock, block);
+            entry.middle = loadBlock(block);
+            entry.candidate = i;
+            int p = MeetInTheMiddle::hash(entry.middle) >> (64 - partitionBits);
+            fwrite(&entry, sizeof(entry), 1, firstFiles[p]);
+            firstCounts[p]++;
+        }
+        
+        key = this->secondPattern.getKey(0);
+        crypto.setKey(key);
+        for (uint64_t i = 0; i < this->secondPattern.getNumberOfCandidates(); i++, key = this->secondPattern.getNextKey(key)) {
+            crypto.updateKey(key);
+            crypto.decryptBlock(this->cipherBlock, block);
+            entry.middle = loadBlock(block);
+            entry.candidate = i;
+            fwrite(&entry, sizeof(entry), 1, secondFiles[MeetInTheMiddle::hash(entry.middle) >> (64 - partitionBits)]);
+        }
+        
+        for (int p = 0; p < partitions; p++) {
+            written = written && 0 == fflush(firstFiles[p]) && 0 == fflush(secondFiles[p]) && ! ferror(firstFiles[p]) && ! ferror(secondFiles[p]);
+        }
+    }
+    
+    // the partitions are joined one at a time, reading the files in
+    // chunks.
+    if (written) {
+        std::vector<Entry> chunk(4096);
+        for (int p = 0; p < partitions && ! found; p++) {
+            this->resetTable(firstCounts[p]);
+            rewind(firstFiles[p]);
+            size_t count;
+            while (0 < (count = fread(&chunk[0], sizeof(Entry), chunk.size(), firstFiles[p]))) {
+                for (size_t i = 0; i < count; i++) {
+                    this->insert(chunk[i].middle, chunk[i].candidate);
+                }
+            }
+            
+            rewind(secondFiles[p]);
+            while (! found && 0 < (count = fread(&chunk[0], sizeof(Entry), chunk.size(), secondFiles[p]))) {
+                for (size_t i = 0; i < count; i++) {
+                    if (this->probe(chunk[i].middle, chunk[i].candidate, firstFound)) {
+                        secondFound = chunk[i].candidate;
+                        found = true;
+                        break;
+                    }
+                }
+            }
+        }
+    } else {
+        Logger::writeToLogFile("ERROR: Can't write the partition files of the meet in the middle search to %s!", this->spillDirectory);
+    }
+    
+    for (int p = 0; p < partitions; p++) {
+        if (NULL != firstFiles[p]) {
+            fclose(firstFiles[p]);
+        }
+        if (NULL != secondFiles[p]) {
+            fclose(secondFiles[p]);
+        }
+    }
+    
+    // the memory of the last table is given back.
+    std::vector<Entry>().swap(this->table);
+    
+    return found;
+}
+
+/**
+ * Clears the table and sizes it for the given number of entries.
+ */
+void MeetInTheMiddle::resetTable(uint64_t entries)
+{
+    Entry empty = { 0, MeetInTheMiddle::emptySlot };
+    this->table.assign(MeetInTheMiddle::getTableSlots(entries), empty);
+}
+
+/**
+ * Adds an entry to the table.
+ */
+void MeetInTheMiddle::insert(uint64_t middle, uint64_t candidate)
+{
+    const uint64_t mask = this->table.size() - 1;
+    uint64_t slot = MeetInTheMiddle::hash(middle) & mask;
+    while (MeetInTheMiddle::emptySlot != this->table[slot].candidate) {
+        slot = (slot + 1) & mask;
+    }
+    this->table[slot].middle = middle;
+    this->table[slot].candidate = candidate;
+}
+
+/**
+ * Checks the first keys the table has for a block in the middle against a
+ * second key.
+ * 
+ * @param firstFound Receives the candidate of the first key, if it matches.
+ * @return Whether one matched.
+ */
+bool MeetInTheMiddle::probe(uint64_t middle, uint64_t secondCandidate, uint64_t& firstFound)
+{
+    const uint64_t mask = this->table.size() - 1;
+    for (uint64_t slot = MeetInTheMiddle::hash(middle) & mask; MeetInTheMiddle::emptySlot != this->table[slot].candidate; slot = (slot + 1) & mask) {
+        if (middle == this->table[slot].middle && this->confirm(this->table[slot].candidate, secondCandidate)) {
+            firstFound = this->table[slot].candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Tells whether a pair of candidates decrypts the whole text.
+ */
+bool MeetInTheMiddle::confirm(uint64_t firstCandidate, uint64_t secondCandidate)
+{
+    DESCore crypto;
+    unsigned char* text = (unsigned char*) &this->data[0];
+    crypto.setKey(this->secondPattern.getKey(secondCandidate));
+    crypto.decrypt((const unsigned char*) this->encryptedString->data(), text, this->data.size());
+    crypto.setKey(this->firstPattern.getKey(firstCandidate));
+    crypto.decrypt(text, text, this->data.size());
+    
+    return AlgorithmInterface::matchesRawString((const unsigned char*) this->rawString->data(), this->rawString->size(), text, this->data.size());
+}
+
+/**
+ * Creates a temporary file in the spill directory; it is removed as soon as
+ * it is closed.
+ * 
+ * @return The file, or NULL.
+ */
+FILE* MeetInTheMiddle::createSpillFile(size_t bufferSize)
+{
+    std::string path = this->spillDirectory + "/mpad-spill-XXXXXX";
+    int descriptor = mkstemp(&path[0]);
+    if (0 > descriptor) {
+        return NULL;
+    }
+    unlink(path.c_str());
+    
+    FILE* file = fdopen(descriptor, "w+b");
+    if (NULL == file) {
+        close(descriptor);
+        return NULL;
+    }
+    setvbuf(file, NULL, _IOFBF, bufferSize);
+    return file;
+}
+
+/**
+ * Returns the number of table slots for the given number of entries: the
+ * power of two that keeps the table at most two thirds full.
+ */
+uint64_t MeetInTheMiddle::getTableSlots(uint64_t entries)
+{
+    uint64_t slots = 16;
+    while (slots < entries + entries / 2) {
+        slots <<= 1;
+    }
+    return slots;
+}
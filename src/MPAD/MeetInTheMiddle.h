@@ -0,0 +1,200 @@
+/**
+ * File: MeetInTheMiddle.h
+ * 
+ * Header file for the MeetInTheMiddle class.
+ * 
+ * @version 0.1
+ */
+
+// make sure that the signature of the class is defined only once.
+#ifndef MEETINTHEMIDDLE_H
+#define	MEETINTHEMIDDLE_H
+
+// include the string library for the std::string class.
+#include <string>
+
+// include the vector library.
+#include <vector>
+
+// include the standard I/O library for the spill files.
+#include <stdio.h>
+
+// include the KeyPattern class signature.
+#include "KeyPattern.h"
+
+/**
+ * Signature of the MeetInTheMiddle class.
+ * 
+ * MeetInTheMiddle searches the two keys of double DES, where the text is
+ * encrypted with the first key and the result with the second one, in the
+ * time of two key searches instead of their product: the first block of the
+ * raw string is encrypted with every first key, and the results go to a hash
+ * table; then the first block of the encrypted string is decrypted with
+ * every second key and looked up in it. A pair of keys whose blocks meet is
+ * checked against the whole text.
+ * 
+ * The table takes 16 bytes per first key, plus the free slots. If it doesn't
+ * fit in the memory limit, both sides are written to temporary files
+ * instead, split by the top bits of the hash of the block into as many
+ * partitions as it takes for the table of one to fit, and the partitions are
+ * joined one at a time.
+ * 
+ * @since version 0.1
+ * @see AlgorithmTripleDES
+ * @see MainProcess
+ */
+class MeetInTheMiddle
+{
+    // public attributes and methods of the class.
+    public:
+        
+        /**
+         * Constructor method of the class.
+         * 
+         * @param firstPattern The known and the free bits of the first key.
+         * @param secondPattern The known and the free bits of the second key.
+         * @param memoryLimit Most bytes the hash table may take.
+         * @param spillDirectory Where the temporary files go.
+         */
+        MeetInTheMiddle(const KeyPattern& firstPattern, const KeyPattern& secondPattern, size_t memoryLimit, const std::string& spillDirectory);
+        
+        /**
+         * Searches the first keys of [firstCandidate, lastCandidate) and
+         * every second key for the pair that encrypts the raw string into
+         * the encrypted one.
+         * 
+         * @param firstFound Receives the candidate of the first key, if any.
+         * @param secondFound Receives the candidate of the second key.
+         * @return Whether a pair was found; false on an error, too, which is
+         * logged.
+         */
+        bool search(const std::string& rawString, const std::string& encryptedString, uint64_t firstCandidate, uint64_t lastCandidate, uint64_t& firstFound, uint64_t& secondFound);
+        
+        /**
+         * Returns the number of partitions the last search was split into;
+         * 1 if its table fit in memory.
+         */
+        int getNumberOfPartitions();
+        
+        /**
+         * Encrypts the raw string (padded with spaces to whole blocks) with
+         * double DES.
+         */
+        static std::string encrypt(const std::string& rawString, uint64_t firstKey, uint64_t secondKey);
+    
+    // private attributes and methods of the class.
+    private:
+        
+        /**
+         * A block in the middle and the candidate of the key that gave it.
+         * An empty slot of the table has the candidate emptySlot.
+         */
+        struct Entry
+        {
+            uint64_t middle;
+            uint64_t candidate;
+        };
+        
+        static const uint64_t emptySlot = ~(uint64_t) 0;
+        
+        /**
+         * Most partitions; each takes two open files.
+         */
+        static const int maximumPartitions = 256;
+        
+        /**
+         * The keys searched.
+         */
+        KeyPattern firstPattern;
+        KeyPattern secondPattern;
+        
+        /**
+         * The memory limit, and the directory of the temporary files.
+         */
+        size_t memoryLimit;
+        std::string spillDirectory;
+        
+        /**
+         * The number of partitions of the last search.
+         */
+        int numberOfPartitions;
+        
+        /**
+         * The hash table: a power of two slots, probed linearly.
+         */
+        std::vector<Entry> table;
+        
+        /**
+         * The pair being searched for, and the first plaintext and
+         * ciphertext blocks.
+         */
+        const std::string* rawString;
+        const std::string* encryptedString;
+        unsigned char plainBlock[8];
+        unsigned char cipherBlock[8];
+        
+        /**
+         * Buffer the candidate pairs are decrypted into.
+         */
+        std::string data;
+        
+        /**
+         * Searches with the whole table in memory.
+         */
+        bool searchInMemory(uint64_t firstCandidate, uint64_t lastCandidate, uint64_t& firstFound, uint64_t& secondFound);
+        
+        /**
+         * Searches with both sides split into partition files.
+         */
+        bool searchPartitioned(uint64_t firstCandidate, uint64_t lastCandidate, int partitionBits, uint64_t& firstFound, uint64_t& secondFound);
+        
+        /**
+         * Clears the table and sizes it for the given number of entries.
+         */
+        void resetTable(uint64_t entries);
+        
+        /**
+         * Adds an entry to the table.
+         */
+        void insert(uint64_t middle, uint64_t candidate);
+        
+        /**
+         * Checks the first keys the table has for a block in the middle
+         * against a second key.
+         * 
+         * @param firstFound Receives the candidate of the first key, if it
+         * matches.
+         * @return Whether one matched.
+         */
+        bool probe(uint64_t middle, uint64_t secondCandidate, uint64_t& firstFound);
+        
+        /**
+         * Tells whether a pair of candidates decrypts the whole text.
+         */
+        bool confirm(uint64_t firstCandidate, uint64_t secondCandidate);
+        
+        /**
+         * Creates a temporary file in the spill directory; it is removed as
+         * soon as it is closed.
+         * 
+         * @return The file, or NULL.
+         */
+        FILE* createSpillFile(size_t bufferSize);
+        
+        /**
+         * Returns the number of table slots for the given number of
+         * entries.
+         */
+        static uint64_t getTableSlots(uint64_t entries);
+        
+        /**
+         * Mixes the bits of a block in the middle.
+         */
+        static uint64_t hash(uint64_t middle)
+        {
+            return middle * 0x9E3779B97F4A7C15ULL;
+        }
+};
+
+// end of the class signature.
+#endif	/* MEETINTHEMIDDLE_H */
@@ -0,0 +1,166 @@
+/**
+ * File: PasswordPipeline.cpp
+ * 
+ * Source code file for the PasswordPipeline class.
+ * 
+ * @version 0.1
+ */
+
+// include the signature of the class.
+#include "PasswordPipeline.h"
+
+// include the Logger class signature.
+#include "Logger.h"
+
+/**
+ * Constructor method of the class; starts deriving the first batch.
+ * 
+ * @param words The word list.
+ * @param firstPosition First candidate of the chunk.
+ * @param lastPosition End of the chunk.
+ * @param batchSize Most keys in a batch.
+ * @param scratch The arena the batches are taken from; they are given back
+ * with it. Each one starts a cache line of its own, so the thread filling
+ * one doesn't slow down the one testing the other.
+ */
+PasswordPipeline::PasswordPipeline(const WordList& words, uint64_t firstPosition, uint64_t lastPosition, size_t batchSize, Arena& scratch)
+    : words(words)
+{
+    this->position = firstPosition;
+    this->lastPosition = lastPosition;
+    this->batchSize = batchSize;
+    for (int i = 0; i < 2; i++) {
+        this->batches[i].keys = scratch.allocateArray<uint64_t>(batchSize);
+        this->batches[i].positions = scratch.allocateArray<uint64_t>(batchSize);
+        this->batches[i].count = 0;
+    }
+    this->filling = 0;
+    this->testing = 0;
+    this->ready = 0;
+    this->finished = false;
+    this->stopping = false;
+    pthread_mutex_init(&this->mutex, NULL);
+    pthread_cond_init(&this->condition, NULL);
+    
+    this->deriverRunning = (0 == pthread_create(&this->deriver, NULL, PasswordPipeline::deriverMain, this));
+    if (! this->deriverRunning) {
+        Logger::writeToLogFile("ERROR: Can't create the key derivation thread!");
+    }
+}
+
+/**
+ * Destructor method of the class; stops the thread.
+ */
+PasswordPipeline::~PasswordPipeline()
+{
+    if (this->deriverRunning) {
+        pthread_mutex_lock(&this->mutex);
+        this->stopping = true;
+        pthread_cond_signal(&this->condition);
+        pthread_mutex_unlock(&this->mutex);
+        
+        pthread_join(this->deriver, NULL);
+    }
+    pthread_cond_destroy(&this->condition);
+    pthread_mutex_destroy(&this->mutex);
+}
+
+/**
+ * Waits for the next batch of keys; it is the caller's until release() is
+ * called.
+ * 
+ * @param keys Receives the keys.
+ * @param positions Receives the offsets of their words.
+ * @param count Receives the number of keys.
+ * @return Whether there was a batch; false once the chunk is done.
+ */
+bool PasswordPipeline::next(const uint64_t*& keys, const uint64_t*& positions, size_t& count)
+{
+    Batch& batch = this->batches[this->testing];
+    
+    if (! this->deriverRunning) {
+        if (! this->fill(batch)) {
+            return false;
+        }
+    } else {
+        pthread_mutex_lock(&this->mutex);
+        while (0 == this->ready && ! this->finished) {
+            pthread_cond_wait(&this->condition, &this->mutex);
+        }
+        bool available = (0 < this->ready);
+        pthread_mutex_unlock(&this->mutex);
+        if (! available) {
+            return false;
+        }
+    }
+    
+    keys = batch.keys;
+    positions = batch.positions;
+    count = batch.count;
+    return true;
+}
+
+/**
+ * Hands the batch of the last next() back to be filled again.
+ */
+void PasswordPipeline::release()
+{
+    if (! this->deriverRunning) {
+        return;
+    }
+    
+    pthread_mutex_lock(&this->mutex);
+    this->ready--;
+    this->testing ^= 1;
+    pthread_cond_signal(&this->condition);
+    pthread_mutex_unlock(&this->mutex);
+}
+
+/**
+ * Fills the given batch with the next keys of the chunk.
+ * 
+ * @return Whether there were any.
+ */
+bool PasswordPipeline::fill(Batch& batch)
+{
+    batch.count = this->words.deriveKeys(this->position, this->lastPosition, batch.keys, batch.positions, this->batchSize);
+    return 0 < batch.count;
+}
+
+/**
+ * Entry point of the thread: fills the batches as they are released, until
+ * the chunk is done or stop is set.
+ * 
+ * @param pipeline Pointer to the PasswordPipeline.
+ */
+void* PasswordPipeline::deriverMain(void* pipeline)
+{
+    PasswordPipeline* self = (PasswordPipeline*) pipeline;
+    
+    pthread_mutex_lock(&self->mutex);
+    while (! self->stopping) {
+        if (2 == self->ready) {
+            pthread_cond_wait(&self->condition, &self->mutex);
+            continue;
+        }
+        
+        // the batch is filled without the lock, while the other one is
+        // being tested.
+        Batch& batch = self->batches[self->filling];
+        pthread_mutex_unlock(&self->mutex);
+        bool filled = self->fill(batch);
+        pthread_mutex_lock(&self->mutex);
+        
+        if (! filled) {
+            break;
+        }
+        self->ready++;
+        self->filling ^= 1;
+        pthread_cond_signal(&self->condition);
+    }
+    self->finished = true;
+    pthread_cond_signal(&self->condition);
+    pthread_mutex_unlock(&self->mutex);
+    
+    return NULL;
+}
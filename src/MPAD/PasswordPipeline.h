@@ -0,0 +1,150 @@
+/**
+ * File: PasswordPipeline.h
+ * 
+ * Header file for the PasswordPipeline class.
+ * 
+ * @version 0.1
+ */
+
+// make sure that the signature of the class is defined only once.
+#ifndef PASSWORDPIPELINE_H
+#define	PASSWORDPIPELINE_H
+
+// include the POSIX thread library.
+#include <pthread.h>
+
+// include the fixed-width integer types.
+#include <stdint.h>
+
+// include the WordList class signature.
+#include "WordList.h"
+
+// include the Arena class signature.
+#include "Arena.h"
+
+/**
+ * Signature of the PasswordPipeline class.
+ * 
+ * PasswordPipeline derives the keys of the words of a chunk of a WordList in
+ * a thread of its own, a batch at a time, while the thread that created it
+ * tests the batch before: there are two batches, one being filled and one
+ * being tested, so reading and deriving the words costs no time of the
+ * search as long as it is faster than the kernel.
+ * 
+ * If the thread can't be started, next() derives every batch itself.
+ * 
+ * @since version 0.1
+ * @see WordList
+ * @see AlgorithmDESBitslice
+ */
+class PasswordPipeline
+{
+    // public attributes and methods of the class.
+    public:
+        
+        /**
+         * Constructor method of the class; starts deriving the first batch.
+         * 
+         * @param words The word list.
+         * @param firstPosition First candidate of the chunk.
+         * @param lastPosition End of the chunk.
+         * @param batchSize Most keys in a batch.
+         * @param scratch The arena the batches are taken from; they are
+         * given back with it.
+         */
+        PasswordPipeline(const WordList& words, uint64_t firstPosition, uint64_t lastPosition, size_t batchSize, Arena& scratch);
+        
+        /**
+         * Destructor method of the class; stops the thread.
+         */
+        ~PasswordPipeline();
+        
+        /**
+         * Waits for the next batch of keys; it is the caller's until
+         * release() is called.
+         * 
+         * @param keys Receives the keys.
+         * @param positions Receives the offsets of their words.
+         * @param count Receives the number of keys.
+         * @return Whether there was a batch; false once the chunk is done.
+         */
+        bool next(const uint64_t*& keys, const uint64_t*& positions, size_t& count);
+        
+        /**
+         * Hands the batch of the last next() back to be filled again.
+         */
+        void release();
+    
+    // private attributes and methods of the class.
+    private:
+        
+        /**
+         * A batch of keys and the offsets of their words.
+         */
+        struct Batch
+        {
+            uint64_t* keys;
+            uint64_t* positions;
+            size_t count;
+        };
+        
+        /**
+         * Most keys in a batch.
+         */
+        size_t batchSize;
+        
+        /**
+         * The word list, and the chunk of it left to derive.
+         */
+        const WordList& words;
+        uint64_t position;
+        uint64_t lastPosition;
+        
+        /**
+         * The two batches; filling is the one the thread fills next, and
+         * testing the one next() hands out next.
+         */
+        Batch batches[2];
+        int filling;
+        int testing;
+        
+        /**
+         * Number of batches ready to be tested, whether the chunk is done,
+         * and whether the thread is to stop.
+         */
+        int ready;
+        bool finished;
+        bool stopping;
+        
+        /**
+         * The thread, and what it and next() wait on.
+         */
+        pthread_t deriver;
+        bool deriverRunning;
+        pthread_mutex_t mutex;
+        pthread_cond_t condition;
+        
+        /**
+         * Fills the given batch with the next keys of the chunk.
+         * 
+         * @return Whether there were any.
+         */
+        bool fill(Batch& batch);
+        
+        /**
+         * Entry point of the thread: fills the batches as they are
+         * released, until the chunk is done or stop is set.
+         * 
+         * @param pipeline Pointer to the PasswordPipeline.
+         */
+        static void* deriverMain(void* pipeline);
+        
+        /**
+         * Copying a pipeline would copy its thread.
+         */
+        PasswordPipeline(const PasswordPipeline&);
+        PasswordPipeline& operator=(const PasswordPipeline&);
+};
+
+// end of the class signature.
+#endif	/* PASSWORDPIPELINE_H */
@@ -0,0 +1,1182 @@
+/**
+ * File: SelfTest.cpp
+ * 
+ * Source code file for the SelfTest class.
+ * 
+ * @version 0.1
+ */
+
+// include standard libraries.
+#include <cstdlib>
+#include <stdio.h>
+
+// include the string library.
+#include <string.h>
+
+// include the stream related libraries.
+#include <sstream>
+
+// include the vector library.
+#include <vector>
+
+// include the signature of the class.
+#include "SelfTest.h"
+
+// include the DES engines.
+#include "AlgorithmDES.h"
+#include "AlgorithmDESLegacy.h"
+#include "AlgorithmDESBitslice.h"
+#include "AlgorithmTripleDES.h"
+#include "DESCore.h"
+
+// include the ThreadedSearch class signature.
+#include "ThreadedSearch.h"
+
+// include the TargetSet class signature.
+#include "TargetSet.h"
+
+// include the KeyList class signature.
+#include "KeyList.h"
+
+// include the WordList and PasswordPipeline class signatures.
+#include "WordList.h"
+#include "PasswordPipeline.h"
+
+// include the AlgorithmRegistry class signature.
+#include "AlgorithmRegistry.h"
+
+// include the MeetInTheMiddle class signature.
+#include "MeetInTheMiddle.h"
+
+// include the CipherStream class signature.
+#include "CipherStream.h"
+
+// include the FileCipher class signature.
+#include "FileCipher.h"
+
+// include the Arena and AllocationCounter class signatures.
+#include "Arena.h"
+#include "AllocationCounter.h"
+
+// include the file functions of the key and word list tests.
+#include <unistd.h>
+
+// include the Logger class signature.
+#include "Logger.h"
+
+/**
+ * A known-answer vector: a key, a plaintext block and its ciphertext.
+ */
+struct KnownAnswer
+{
+    uint64_t key;
+    uint64_t plainText;
+    uint64_t cipherText;
+};
+
+/**
+ * Known-answer vectors from FIPS 46 (the worked example), NIST SP 800-17
+ * (the variable plaintext and variable key tests) and the DES validation
+ * set.
+ */
+static const KnownAnswer knownAnswers[] = {
+    { 0x133457799BBCDFF1ULL, 0x0123456789ABCDEFULL, 0x85E813540F0AB405ULL },
+    { 0x0E329232EA6D0D73ULL, 0x8787878787878787ULL, 0x0000000000000000ULL },
+    { 0x0101010101010101ULL, 0x8000000000000000ULL, 0x95F8A5E5DD31D900ULL },
+    { 0x0101010101010101ULL, 0x4000000000000000ULL, 0xDD7F121CA5015619ULL },
+    { 0x0101010101010101ULL, 0x2000000000000000ULL, 0x2E8653104F3834EAULL },
+    { 0x8001010101010101ULL, 0x0000000000000000ULL, 0x95A8D72813DAA94DULL },
+    { 0x4001010101010101ULL, 0x0000000000000000ULL, 0x0EEC1487DD8C26D5ULL },
+    { 0x1046913489980131ULL, 0x0000000000000000ULL, 0x88D55E54F54C97B4ULL },
+    { 0x7CA110454A1A6E57ULL, 0x01A1D6D039776742ULL, 0x690F5B0D9A26939BULL },
+    { 0x0131D9619DC1376EULL, 0x5CD54CA83DEF57DAULL, 0x7A389D10354BD271ULL }
+};
+
+/**
+ * The bitslice kernels; the ones the CPU doesn't support are skipped.
+ */
+static const char* bitsliceKernels[] = { "scalar", "avx2", "avx512" };
+
+/**
+ * Writes a block into 8 bytes, most significant byte first.
+ */
+static void storeBlock(uint64_t block, unsigned char* bytes)
+{
+    for (int i = 0; i < 8; i++) {
+        bytes[i] = (unsigned char) (block >> (56 - 8 * i));
+    }
+}
+
+/**
+ * Reads a block from 8 bytes, most significant byte first.
+ */
+static uint64_t loadBlock(const unsigned char* bytes)
+{
+    uint64_t block = 0;
+    for (int i = 0; i < 8; i++) {
+        block = (block << 8) | bytes[i];
+    }
+    return block;
+}
+
+/**
+ * Constructor method of the class.
+ * 
+ * @param seed Seed of the random tests.
+ */
+SelfTest::SelfTest(uint64_t seed)
+{
+    // xorshift must not start from 0.
+    this->state = (0 != seed) ? seed : 0x9E3779B97F4A7C15ULL;
+    this->passed = 0;
+    this->failed = 0;
+}
+
+/**
+ * Encrypts or decrypts one block with the given engine and compares the
+ * result to the expected block.
+ */
+template <typename Engine>
+void SelfTest::checkBlock(Engine& engine, std::string name, uint64_t key, uint64_t input, uint64_t expected, bool decrypt)
+{
+    unsigned char in[8], out[8];
+    storeBlock(input, in);
+    std::string keyText = SelfTest::keyString(key);
+    if (decrypt) {
+        engine.decrypt(in, 8, out, keyText.c_str(), 64);
+    } else {
+        engine.encrypt(in, 8, out, keyText.c_str(), 64);
+    }
+    
+    std::string description = name + (decrypt ? " decrypt " : " encrypt ") + SelfTest::hexString(input) + " with key " + SelfTest::hexString(key)
+        + ": expected " + SelfTest::hexString(expected) + ", got " + SelfTest::hexString(loadBlock(out));
+    this->check(loadBlock(out) == expected, description);
+}
+
+/**
+ * DESCore works on 64-bit keys and single blocks.
+ */
+template <>
+void SelfTest::checkBlock<DESCore>(DESCore& engine, std::string name, uint64_t key, uint64_t input, uint64_t expected, bool decrypt)
+{
+    unsigned char in[8], out[8];
+    storeBlock(input, in);
+    engine.setKey(key);
+    if (decrypt) {
+        engine.decryptBlock(in, out);
+    } else {
+        engine.encryptBlock(in, out);
+    }
+    
+    std::string description = name + (decrypt ? " decrypt " : " encrypt ") + SelfTest::hexString(input) + " with key " + SelfTest::hexString(key)
+        + ": expected " + SelfTest::hexString(expected) + ", got " + SelfTest::hexString(loadBlock(out));
+    this->check(loadBlock(out) == expected, description);
+}
+
+/**
+ * Searches [firstCandidate, lastCandidate) with the given engine and compares
+ * the result to the expected one.
+ */
+template <typename Engine>
+void SelfTest::checkSearch(Engine& engine, std::string name, const std::string& rawString, const std::string& encryptedString,
+    const KeyPattern& pattern, uint64_t firstCandidate, uint64_t lastCandidate, bool expectedFound, uint64_t expectedCandidate)
+{
+    uint64_t foundCandidate = 0;
+    bool found = engine.searchKeys(rawString, encryptedString, pattern, firstCandidate, lastCandidate, foundCandidate);
+    
+    std::ostringstream description;
+    description << name << " search of [" << firstCandidate << ", " << lastCandidate << ") (" << SelfTest::hexString(pattern.getUnknownMask()) << "): expected ";
+    if (expectedFound) {
+        description << expectedCandidate;
+    } else {
+        description << "nothing";
+    }
+    description << ", got ";
+    if (found) {
+        description << foundCandidate;
+    } else {
+        description << "nothing";
+    }
+    this->check(found == expectedFound && (! found || foundCandidate == expectedCandidate), description.str());
+}
+
+/**
+ * Runs every test and prints one line per failure and a summary.
+ * 
+ * @return Whether every test passed.
+ */
+bool SelfTest::run()
+{
+    this->testKnownAnswers();
+    this->testDifferential(256);
+    this->testSearch(KeyPattern(20), 16);
+    this->testSearch(KeyPattern(56), 16);
+    this->testSearch(this->randomPattern(5), 16);
+    this->testSearch(this->randomPattern(24), 16);
+    this->testSearch(this->randomPattern(48), 16);
+    this->testBatch(KeyPattern(20), 12);
+    this->testBatch(this->randomPattern(32), 12);
+    this->testKeyList(8);
+    this->testWordList(8);
+    this->testRegistry(this->randomPattern(24), 4);
+    this->testTripleDES();
+    this->testMeetInTheMiddle(4);
+    this->testCipherStream(32);
+    this->testFileCipher(12);
+    this->testScratchAllocations(8);
+    
+    std::ostringstream summary;
+    summary << "Self-test: " << this->passed << " checks passed, " << this->failed << " failed!";
+    printf("%s\n", summary.str().c_str());
+    Logger::writeToLogFile(summary.str());
+    
+    return 0 == this->failed;
+}
+
+/**
+ * Checks the known-answer vectors on every engine, encrypting and
+ * decrypting.
+ */
+void SelfTest::testKnownAnswers()
+{
+    AlgorithmDESLegacy legacy;
+    AlgorithmDES reference;
+    AlgorithmTripleDES tripleDES(3);
+    DESCore core;
+    
+    for (size_t i = 0; i < sizeof(knownAnswers) / sizeof(knownAnswers[0]); i++) {
+        const KnownAnswer& answer = knownAnswers[i];
+        for (int decrypt = 0; decrypt < 2; decrypt++) {
+            uint64_t input = decrypt ? answer.cipherText : answer.plainText;
+            uint64_t expected = decrypt ? answer.plainText : answer.cipherText;
+            
+            this->checkBlock(legacy, "legacy", answer.key, input, expected, decrypt);
+            this->checkBlock(reference, "reference", answer.key, input, expected, decrypt);
+            this->checkBlock(tripleDES, "triple-des single key", answer.key, input, expected, decrypt);
+            this->checkBlock(core, "core", answer.key, input, expected, decrypt);
+            for (int j = 0; j < 3; j++) {
+                AlgorithmDESBitslice bitslice;
+                if (bitslice.useKernel(bitsliceKernels[j])) {
+                    this->checkBlock(bitslice, std::string("bitslice-") + bitsliceKernels[j], answer.key, input, expected, decrypt);
+                }
+            }
+        }
+    }
+    
+    // the bitslice engine tests its kernel by itself, too.
+    for (int j = 0; j < 3; j++) {
+        AlgorithmDESBitslice bitslice;
+        if (bitslice.useKernel(bitsliceKernels[j])) {
+            this->check(bitslice.selfTest(), std::string("bitslice-") + bitsliceKernels[j] + " built-in self-test");
+        }
+    }
+}
+
+/**
+ * Checks that every engine encrypts random blocks with random keys the way
+ * the core implementation does, and decrypts them back.
+ */
+void SelfTest::testDifferential(int count)
+{
+    AlgorithmDESLegacy legacy;
+    AlgorithmDES reference;
+    DESCore core;
+    
+    for (int i = 0; i < count; i++) {
+        uint64_t key = this->random();
+        uint64_t plainText = this->random();
+        
+        unsigned char input[8], output[8];
+        storeBlock(plainText, input);
+        core.setKey(key);
+        core.encryptBlock(input, output);
+        uint64_t cipherText = loadBlock(output);
+        
+        for (int decrypt = 0; decrypt < 2; decrypt++) {
+            uint64_t from = decrypt ? cipherText : plainText;
+            uint64_t to = decrypt ? plainText : cipherText;
+            
+            this->checkBlock(legacy, "legacy", key, from, to, decrypt);
+            this->checkBlock(reference, "reference", key, from, to, decrypt);
+            this->checkBlock(core, "core", key, from, to, decrypt);
+            for (int j = 0; j < 3; j++) {
+                AlgorithmDESBitslice bitslice;
+                if (bitslice.useKernel(bitsliceKernels[j])) {
+                    this->checkBlock(bitslice, std::string("bitslice-") + bitsliceKernels[j], key, from, to, decrypt);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Checks the key search of every engine, and of the threaded search, with
+ * random keys of the given key pattern. Every key is searched for in ranges of a
+ * few hundred candidates: around it with unaligned ends, starting at it,
+ * ending right after it and just after it.
+ */
+void SelfTest::testSearch(const KeyPattern& pattern, int count)
+{
+    const uint64_t keys = pattern.getNumberOfCandidates();
+    
+    AlgorithmDESLegacy legacy;
+    AlgorithmDES reference;
+    
+    for (int i = 0; i < count; i++) {
+        uint64_t candidate = this->random() & (keys - 1);
+        char key[64 + 1];
+        pattern.getKeyString(candidate, key);
+        
+        // a printable text of two blocks and a bit, so that the search has
+        // to confirm the first block against the rest.
+        std::string rawString(19, ' ');
+        for (size_t j = 0; j < rawString.size(); j++) {
+            rawString[j] = 'A' + this->random() % 26;
+        }
+        std::string encryptedString = reference.encrpyt(rawString, key, 64);
+        
+        uint64_t before = 1 + this->random() % 300;
+        uint64_t after = 1 + this->random() % 300;
+        uint64_t ranges[4][2] = {
+            { (candidate > before) ? candidate - before : 0, (candidate + after < keys) ? candidate + after : keys },
+            { candidate, (candidate + after < keys) ? candidate + after : keys },
+            { (candidate > before) ? candidate - before : 0, candidate + 1 },
+            { candidate + 1, (candidate + 1 + after < keys) ? candidate + 1 + after : keys }
+        };
+        
+        for (int j = 0; j < 4; j++) {
+            uint64_t first = ranges[j][0], last = ranges[j][1];
+            uint64_t expected = 0;
+            bool expectedFound = SelfTest::firstEquivalent(pattern, candidate, first, last, expected);
+            
+            this->checkSearch(legacy, "legacy", rawString, encryptedString, pattern, first, last, expectedFound, expected);
+            this->checkSearch(reference, "reference", rawString, encryptedString, pattern, first, last, expectedFound, expected);
+            for (int k = 0; k < 3; k++) {
+                AlgorithmDESBitslice bitslice;
+                if (bitslice.useKernel(bitsliceKernels[k])) {
+                    this->checkSearch(bitslice, std::string("bitslice-") + bitsliceKernels[k], rawString, encryptedString, pattern,
+                        first, last, expectedFound, expected);
+                }
+            }
+        }
+        
+        // the threaded search may report any equivalent key in the range,
+        // not only the first one.
+        uint64_t first = (candidate > 4096) ? candidate - 4096 : 0;
+        uint64_t last = (candidate + 4096 < keys) ? candidate + 4096 : keys;
+        ThreadedSearch search(rawString, encryptedString, pattern, 3);
+        uint64_t foundCandidate = 0;
+        bool found = search.run(first, last, foundCandidate);
+        
+        uint64_t equivalent = 0;
+        std::ostringstream description;
+        description << "threaded search of [" << first << ", " << last << ") for " << candidate << " (" << SelfTest::hexString(pattern.getUnknownMask()) << ")";
+        this->check(found && SelfTest::firstEquivalent(pattern, candidate, foundCandidate, foundCandidate + 1, equivalent), description.str());
+    }
+}
+
+/**
+ * Checks the batch search of every kernel, and of the threaded search, with a
+ * batch of random keys of the given key pattern. Most of the targets share
+ * their first plaintext block, so that they are looked up in the same table;
+ * every fifth has a block of its own, two have the same key and one has a
+ * key outside of the range searched.
+ */
+void SelfTest::testBatch(const KeyPattern& pattern, int count)
+{
+    const uint64_t keys = pattern.getNumberOfCandidates();
+    const uint64_t first = this->random() % (keys - 8192);
+    const uint64_t last = first + 2048 + this->random() % 2048;
+    
+    AlgorithmDES reference;
+    std::vector<std::string> rawStrings, encryptedStrings;
+    std::vector<uint64_t> candidates;
+    for (int i = 0; i < count + 2; i++) {
+        uint64_t candidate = first + this->random() % (last - first);
+        if (count - 1 == i) {
+            candidate = candidates[0];
+        } else if (count == i) {
+            candidate = last + this->random() % 2048;
+        }
+        char key[64 + 1];
+        pattern.getKeyString(candidate, key);
+        
+        std::string rawString = (4 == i % 5) ? "" : "MPAD-KEY";
+        while (19 > rawString.size()) {
+            rawString += (char) ('A' + this->random() % 26);
+        }
+        rawStrings.push_back(rawString);
+        encryptedStrings.push_back(reference.encrpyt(rawString, key, 64));
+        candidates.push_back(candidate);
+    }
+    
+    for (int k = 0; k < 3; k++) {
+        AlgorithmDESBitslice bitslice;
+        if (! bitslice.useKernel(bitsliceKernels[k])) {
+            continue;
+        }
+        TargetSet targets;
+        for (size_t i = 0; i < rawStrings.size(); i++) {
+            targets.add(rawStrings[i], encryptedStrings[i]);
+        }
+        targets.build();
+        bitslice.searchTargets(targets, pattern, first, last);
+        
+        for (size_t i = 0; i < candidates.size(); i++) {
+            uint64_t expected = 0;
+            bool expectedFound = SelfTest::firstEquivalent(pattern, candidates[i], first, last, expected);
+            std::ostringstream description;
+            description << "bitslice-" << bitsliceKernels[k] << " batch search of [" << first << ", " << last << ") for " << candidates[i]
+                << " (" << SelfTest::hexString(pattern.getUnknownMask()) << ")";
+            this->check(expectedFound == targets.isFound(i) && (! expectedFound || expected == targets.getFoundCandidate(i)), description.str());
+        }
+    }
+    
+    // the threaded search stops once every target has its key, so the
+    // targets that have one are left out of it.
+    TargetSet targets;
+    for (size_t i = 0; i < rawStrings.size(); i++) {
+        if (count != (int) i) {
+            targets.add(rawStrings[i], encryptedStrings[i]);
+        }
+    }
+    targets.build();
+    ThreadedSearch search("", "", pattern, 3);
+    search.setTargets(&targets);
+    uint64_t foundCandidate = 0;
+    bool allFound = search.run(first, last, foundCandidate);
+    
+    bool found = allFound;
+    for (int i = 0; i < targets.getNumberOfTargets(); i++) {
+        uint64_t equivalent = 0;
+        uint64_t candidate = candidates[(i < count) ? i : i + 1];
+        found = found && targets.isFound(i) && SelfTest::firstEquivalent(pattern, candidate, targets.getFoundCandidate(i), targets.getFoundCandidate(i) + 1, equivalent);
+    }
+    std::ostringstream description;
+    description << "threaded batch search of [" << first << ", " << last << ") (" << SelfTest::hexString(pattern.getUnknownMask()) << ")";
+    this->check(found, description.str());
+}
+
+/**
+ * Checks the key list search of every kernel, and of the threaded search,
+ * with a temporary key file of a few thousand random keys. The key searched
+ * for is on a random line, and one of the lines before it isn't a key, which
+ * the search has to skip.
+ */
+void SelfTest::testKeyList(int count)
+{
+    char path[] = "/tmp/mpad-selftest-XXXXXX";
+    int file = mkstemp(path);
+    if (0 > file) {
+        this->check(false, "key list file");
+        return;
+    }
+    
+    const uint64_t numberOfKeys = 3000 + this->random() % 2000;
+    std::string lines;
+    std::vector<uint64_t> listed(numberOfKeys);
+    for (uint64_t i = 0; i < numberOfKeys; i++) {
+        listed[i] = this->random();
+        char line[KeyList::lineLength + 1];
+        snprintf(line, sizeof(line), "%016llX\n", (unsigned long long) listed[i]);
+        lines += line;
+    }
+    const uint64_t malformed = 1 + this->random() % 1000;
+    lines[malformed * KeyList::lineLength + 3] = 'x';
+    bool written = (ssize_t) lines.size() == write(file, lines.data(), lines.size());
+    close(file);
+    
+    KeyList keys;
+    bool opened = written && keys.open(path);
+    unlink(path);
+    this->check(opened && numberOfKeys == keys.getNumberOfKeys(), "key list file");
+    if (! opened) {
+        return;
+    }
+    
+    AlgorithmDES reference;
+    for (int i = 0; i < count; i++) {
+        uint64_t line = malformed + 1 + this->random() % (numberOfKeys - malformed - 1);
+        char key[64 + 1];
+        AlgorithmInterface::candidateToKey(listed[line], 64, key);
+        
+        std::string rawString(19, ' ');
+        for (size_t j = 0; j < rawString.size(); j++) {
+            rawString[j] = 'A' + this->random() % 26;
+        }
+        std::string encryptedString = reference.encrpyt(rawString, key, 64);
+        
+        // the ranges start before the malformed line, at the key and right
+        // after it.
+        uint64_t ranges[3][2] = { { this->random() % malformed, numberOfKeys }, { line, line + 1 }, { line + 1, numberOfKeys } };
+        for (int j = 0; j < 3; j++) {
+            for (int k = 0; k < 3; k++) {
+                AlgorithmDESBitslice bitslice;
+                if (! bitslice.useKernel(bitsliceKernels[k])) {
+                    continue;
+                }
+                uint64_t foundCandidate = 0;
+                bool found = bitslice.searchKeyList(rawString, encryptedString, keys, ranges[j][0], ranges[j][1], foundCandidate);
+                
+                std::ostringstream description;
+                description << "bitslice-" << bitsliceKernels[k] << " key list search of [" << ranges[j][0] << ", " << ranges[j][1] << ") for line " << line;
+                this->check((2 != j) ? found && line == foundCandidate : ! found, description.str());
+            }
+        }
+        
+        ThreadedSearch search(rawString, encryptedString, KeyPattern(56), 3);
+        search.setKeyList(&keys);
+        uint64_t foundCandidate = 0;
+        bool found = search.run(0, numberOfKeys, foundCandidate);
+        
+        std::ostringstream description;
+        description << "threaded key list search for line " << line;
+        this->check(found && line == foundCandidate, description.str());
+    }
+}
+
+/**
+ * Records the result of a check; a failure is printed.
+ */
+void SelfTest::check(bool condition, std::string description)
+{
+    if (condition) {
+        this->passed++;
+    } else {
+        this->failed++;
+        printf("FAIL %s\n", description.c_str());
+    }
+}
+
+/**
+ * Checks the ECB and CBC streams against the FIPS 81 examples, the block
+ * runs of every kernel against DESCore, and random texts, fed to update in
+ * random pieces, against a block at a time DESCore reference and back.
+ */
+void SelfTest::testCipherStream(int count)
+{
+    const uint64_t key = 0x0123456789ABCDEFULL, iv = 0x1234567890ABCDEFULL;
+    const std::string rawString = "Now is the time for all ";
+    const uint64_t expected[2][4] = {
+        { 0x3FA40E8A984D4815ULL, 0x6A271787AB8883F9ULL, 0x893D51EC4B563B53ULL, 0 },
+        { 0xE5C7CDDE872BF27CULL, 0x43E934008C389C0FULL, 0x683788499A7C05F6ULL, 0x62C16A27E4FCF277ULL }
+    };
+    
+    // FIPS 81 has no padding; its CBC example is checked with the PKCS#5
+    // block, too.
+    for (int m = 0; m < 2; m++) {
+        CipherStream::Mode mode = m ? CipherStream::CBC : CipherStream::ECB;
+        for (int padding = 0; padding < 2; padding++) {
+            if (padding && CipherStream::ECB == mode) {
+                continue;
+            }
+            CipherStream stream(mode, false, key, iv);
+            stream.setPadding(padding);
+            unsigned char output[40];
+            size_t written, last;
+            written = stream.update((const unsigned char*) rawString.data(), rawString.size(), output);
+            bool finished = stream.finish(output + written, last);
+            
+            bool matches = finished && (padding ? 32 : 24) == written + last;
+            for (size_t i = 0; matches && i < (written + last) / 8; i++) {
+                matches = (expected[m][i] == loadBlock(output + 8 * i));
+            }
+            this->check(matches, std::string(m ? "cbc" : "ecb") + (padding ? " padded" : "") + " known answer");
+        }
+    }
+    
+    // the runs of blocks around the lanes of every kernel.
+    const size_t runs[] = { 1, 63, 64, 65, 257, 600, 1100 };
+    DESCore core;
+    for (int j = 0; j < 3; j++) {
+        AlgorithmDESBitslice bitslice;
+        if (! bitslice.useKernel(bitsliceKernels[j])) {
+            continue;
+        }
+        for (size_t r = 0; r < sizeof(runs) / sizeof(runs[0]); r++) {
+            uint64_t runKey = this->random();
+            core.setKey(runKey);
+            std::vector<unsigned char> input(runs[r] * 8), output(runs[r] * 8), reference(runs[r] * 8);
+            for (size_t i = 0; i < input.size(); i++) {
+                input[i] = (unsigned char) this->random();
+            }
+            for (int decrypt = 0; decrypt < 2; decrypt++) {
+                bitslice.cryptBlocks(runKey, &input[0], &output[0], runs[r], decrypt);
+                if (decrypt) {
+                    core.decrypt(&input[0], &reference[0], input.size());
+                } else {
+                    core.encrypt(&input[0], &reference[0], input.size());
+                }
+                std::ostringstream description;
+                description << "bitslice-" << bitsliceKernels[j] << " run of " << runs[r] << " blocks" << (decrypt ? ", decrypting" : "");
+                this->check(output == reference, description.str());
+            }
+        }
+    }
+    
+    for (int i = 0; i < count; i++) {
+        CipherStream::Mode mode = (this->random() & 1) ? CipherStream::CBC : CipherStream::ECB;
+        bool padding = (0 != (this->random() & 3));
+        uint64_t streamKey = this->random(), streamIv = this->random();
+        size_t length = this->random() % 4000;
+        if (! padding) {
+            length -= length % 8;
+        }
+        std::vector<unsigned char> input(length);
+        for (size_t k = 0; k < length; k++) {
+            input[k] = (unsigned char) this->random();
+        }
+        
+        // the reference: padded, then chained a block at a time.
+        std::vector<unsigned char> reference(input);
+        if (padding) {
+            reference.resize(length + 8 - length % 8, (unsigned char) (8 - length % 8));
+        }
+        core.setKey(streamKey);
+        unsigned char chain[8];
+        storeBlock(streamIv, chain);
+        for (size_t k = 0; k < reference.size(); k += 8) {
+            if (CipherStream::CBC == mode) {
+                for (int b = 0; b < 8; b++) {
+                    reference[k + b] ^= chain[b];
+                }
+            }
+            core.encryptBlock(&reference[k], &reference[k]);
+            memcpy(chain, &reference[k], 8);
+        }
+        
+        // both ways in random pieces, each stream used twice, since finish
+        // starts it over.
+        std::ostringstream description;
+        description << ((CipherStream::CBC == mode) ? "cbc" : "ecb") << " stream of " << length << " bytes" << (padding ? "" : " without padding");
+        for (int decrypt = 0; decrypt < 2; decrypt++) {
+            const std::vector<unsigned char>& from = decrypt ? reference : input;
+            const std::vector<unsigned char>& to = decrypt ? input : reference;
+            CipherStream stream(mode, decrypt, streamKey, streamIv);
+            stream.setPadding(padding);
+            for (int repeat = 0; repeat < 2; repeat++) {
+                std::vector<unsigned char> output(from.size() + 16);
+                size_t read = 0, written = 0, last = 0;
+                while (read < from.size()) {
+                    size_t piece = 1 + this->random() % ((this->random() & 1) ? 17 : 1500);
+                    piece = (piece < from.size() - read) ? piece : from.size() - read;
+                    written += stream.update(&from[read], piece, &output[written]);
+                    read += piece;
+                }
+                bool finished = stream.finish(&output[written], last);
+                output.resize(written + last);
+                this->check(finished && output == to, description.str() + (decrypt ? ", decrypting" : ", encrypting"));
+            }
+        }
+        
+        // a cut text, or a last block that isn't padding, doesn't finish.
+        if (padding && 0 < length) {
+            std::string cut((const char*) &reference[0], reference.size() - 1), output;
+            this->check(! CipherStream::process(mode, true, streamKey, streamIv, cut, output), description.str() + ", cut short");
+        }
+    }
+    
+    CipherStream stream(CipherStream::ECB, false, key, iv);
+    stream.setPadding(false);
+    unsigned char block[8] = { 1, 2, 3, 4, 5, 6, 7, 9 }, output[16];
+    size_t written, last;
+    written = stream.update(block, 8, output);
+    stream.finish(output + written, last);
+    std::string padded((const char*) output, written + last), unpadded;
+    this->check(8 == padded.size() && ! CipherStream::process(CipherStream::ECB, true, key, iv, padded, unpadded), "invalid padding");
+}
+
+/**
+ * Checks the file cipher against a single stream on temporary files of
+ * random sizes, some of them empty or shorter than a block, with chunks of
+ * a few blocks so that a file spans many of them, and back. A file cut short
+ * doesn't decrypt, and leaves no output file behind.
+ */
+void SelfTest::testFileCipher(int count)
+{
+    char inputPath[] = "/tmp/mpad-selftest-XXXXXX";
+    char outputPath[] = "/tmp/mpad-selftest-XXXXXX";
+    int input = mkstemp(inputPath);
+    int output = mkstemp(outputPath);
+    if (0 > input || 0 > output) {
+        this->check(false, "file cipher temporary files");
+        if (0 <= input) {
+            close(input);
+            unlink(inputPath);
+        }
+        if (0 <= output) {
+            close(output);
+            unlink(outputPath);
+        }
+        return;
+    }
+    close(output);
+    
+    for (int i = 0; i < count; i++) {
+        CipherStream::Mode mode = (this->random() & 1) ? CipherStream::CBC : CipherStream::ECB;
+        uint64_t key = this->random(), iv = this->random();
+        size_t length = (0 == i) ? 0 : (1 == i) ? 5 : this->random() % 20000;
+        size_t chunkSize = 8 * (1 + this->random() % 300);
+        int workers = 1 + this->random() % 4;
+        
+        std::string text(length, '\0'), expected, back;
+        for (size_t k = 0; k < length; k++) {
+            text[k] = (char) this->random();
+        }
+        CipherStream::process(mode, false, key, iv, text, expected);
+        
+        std::ostringstream description;
+        description << "file cipher " << ((CipherStream::CBC == mode) ? "cbc" : "ecb") << " of " << length << " bytes in chunks of " << chunkSize << " with " << workers
+            << " workers";
+        
+        // through the files both ways: the input file is rewritten each
+        // time, and the output file is read back.
+        bool same = true;
+        std::string from = text;
+        for (int decrypt = 0; decrypt < 2; decrypt++) {
+            bool written = (0 == ftruncate(input, 0)) && (from.empty() || (ssize_t) from.size() == pwrite(input, from.data(), from.size(), 0));
+            FileCipher cipher(mode, decrypt, key, iv, workers, chunkSize);
+            bool done = written && cipher.run(inputPath, outputPath);
+            
+            MappedFile result;
+            std::string read;
+            if (done && result.open(outputPath)) {
+                read.assign(result.getData() ? result.getData() : "", result.getSize());
+            }
+            same = same && done && read == (decrypt ? text : expected) && cipher.getBytesWritten() == read.size();
+            from = read;
+        }
+        this->check(same, description.str());
+        
+        // the encrypted text, cut short.
+        if (! expected.empty()) {
+            expected.resize(expected.size() - 1 - this->random() % 7);
+            bool written = (0 == ftruncate(input, 0)) && (expected.empty() || (ssize_t) expected.size() == pwrite(input, expected.data(), expected.size(), 0));
+            FileCipher cipher(mode, true, key, iv, workers, chunkSize);
+            this->check(written && ! cipher.run(inputPath, outputPath) && 0 != access(outputPath, F_OK), description.str() + ", cut short");
+        }
+    }
+    
+    close(input);
+    unlink(inputPath);
+    unlink(outputPath);
+}
+
+/**
+ * Returns the next random number.
+ */
+uint64_t SelfTest::random()
+{
+    this->state ^= this->state >> 12;
+    this->state ^= this->state << 25;
+    this->state ^= this->state >> 27;
+    return this->state * 0x2545F4914F6CDD1DULL;
+}
+
+/**
+ * Returns the first candidate of [firstCandidate, lastCandidate) that is the
+ * given key or differs from it only in parity bits. The parity bits are the
+ * last bit of every byte of the key.
+ * 
+ * @return Whether there is such a candidate.
+ */
+bool SelfTest::firstEquivalent(const KeyPattern& pattern, uint64_t candidate, uint64_t firstCandidate, uint64_t lastCandidate, uint64_t& equivalent)
+{
+    const uint64_t parityBits = 0x0101010101010101ULL;
+    const uint64_t key = pattern.getKey(candidate) & ~parityBits;
+    
+    bool found = false;
+    for (uint64_t i = firstCandidate; i < lastCandidate; i++) {
+        if ((pattern.getKey(i) & ~parityBits) == key) {
+            equivalent = i;
+            found = true;
+            break;
+        }
+    }
+    return found;
+}
+
+/**
+ * Returns a random key pattern with the given number of unknown bits, the
+ * known ones random, too.
+ */
+KeyPattern SelfTest::randomPattern(int freeBits)
+{
+    uint64_t unknownMask = 0;
+    while (freeBits > __builtin_popcountll(unknownMask)) {
+        unknownMask |= (uint64_t) 1 << (this->random() % 64);
+    }
+    return KeyPattern(this->random(), unknownMask);
+}
+
+/**
+ * Returns the key string ('0'/'1' characters) of a 64-bit key.
+ */
+std::string SelfTest::keyString(uint64_t key)
+{
+    char text[64 + 1];
+    AlgorithmInterface::candidateToKey(key, 64, text);
+    return text;
+}
+
+/**
+ * Returns a block as 16 hex digits.
+ */
+std::string SelfTest::hexString(uint64_t block)
+{
+    char text[16 + 1];
+    snprintf(text, sizeof(text), "%016llX", (unsigned long long) block);
+    return text;
+}
+
+/**
+ * Checks the key derivation of passwords, the pipeline that derives them and
+ * the word list search of every kernel, and of the threaded search, with a
+ * temporary file of random words; some lines end in a carriage return and
+ * some are empty. The word searched for is a random one, and the ranges
+ * start and end in the middle of words.
+ */
+void SelfTest::testWordList(int count)
+{
+    // the characters of a password fill the 7 upper bits of the key bytes;
+    // the ninth one is folded into the first byte.
+    this->check(0x828486888A8C8E90ULL == WordList::deriveKey("ABCDEFGH", 8), "password key derivation");
+    this->check(0x108486888A8C8E90ULL == WordList::deriveKey("ABCDEFGHI", 9), "password key folding");
+    
+    char path[] = "/tmp/mpad-selftest-XXXXXX";
+    int file = mkstemp(path);
+    if (0 > file) {
+        this->check(false, "word list file");
+        return;
+    }
+    
+    const int numberOfWords = 20000 + this->random() % 10000;
+    std::string lines;
+    std::vector<uint64_t> positions(numberOfWords);
+    std::vector<std::string> listed(numberOfWords);
+    for (int i = 0; i < numberOfWords; i++) {
+        if (0 == this->random() % 50) {
+            lines += "\n";
+        }
+        positions[i] = lines.size();
+        listed[i].resize(4 + this->random() % 17);
+        for (size_t j = 0; j < listed[i].size(); j++) {
+            listed[i][j] = 'a' + this->random() % 26;
+        }
+        lines += listed[i] + ((0 == this->random() % 10) ? "\r\n" : "\n");
+    }
+    bool written = (ssize_t) lines.size() == write(file, lines.data(), lines.size());
+    close(file);
+    
+    WordList words;
+    bool opened = written && words.open(path);
+    unlink(path);
+    this->check(opened && lines.size() == words.getSize(), "word list file");
+    if (! opened) {
+        return;
+    }
+    
+    // small batches, so that the pipeline hands many of them over.
+    std::vector<uint64_t> derived;
+    Arena scratch;
+    PasswordPipeline pipeline(words, 0, words.getSize(), 100, scratch);
+    const uint64_t* keys;
+    const uint64_t* offsets;
+    size_t batchSize;
+    bool derivedAll = true;
+    while (pipeline.next(keys, offsets, batchSize)) {
+        for (size_t i = 0; i < batchSize; i++) {
+            size_t index = derived.size();
+            derivedAll = derivedAll && index < positions.size() && positions[index] == offsets[i]
+                && WordList::deriveKey(listed[index].data(), listed[index].size()) == keys[i];
+            derived.push_back(offsets[i]);
+        }
+        pipeline.release();
+    }
+    this->check(derivedAll && derived.size() == positions.size(), "password pipeline");
+    
+    AlgorithmDES reference;
+    for (int i = 0; i < count; i++) {
+        int index = 1 + this->random() % (numberOfWords - 2);
+        uint64_t position = positions[index];
+        char key[64 + 1];
+        AlgorithmInterface::candidateToKey(WordList::deriveKey(listed[index].data(), listed[index].size()), 64, key);
+        
+        std::string rawString(19, ' ');
+        for (size_t j = 0; j < rawString.size(); j++) {
+            rawString[j] = 'A' + this->random() % 26;
+        }
+        std::string encryptedString = reference.encrpyt(rawString, key, 64);
+        
+        // the ranges start in the middle of a word before it, at the word,
+        // and in the middle of the word itself.
+        uint64_t before = positions[this->random() % index] + 1;
+        uint64_t ranges[3][2] = { { before, words.getSize() }, { position, position + 1 }, { position + 1, words.getSize() } };
+        for (int j = 0; j < 3; j++) {
+            for (int k = 0; k < 3; k++) {
+                AlgorithmDESBitslice bitslice;
+                if (! bitslice.useKernel(bitsliceKernels[k])) {
+                    continue;
+                }
+                uint64_t foundCandidate = 0;
+                bool found = bitslice.searchWordList(rawString, encryptedString, words, ranges[j][0], ranges[j][1], foundCandidate);
+                
+                std::ostringstream description;
+                description << "bitslice-" << bitsliceKernels[k] << " word list search of [" << ranges[j][0] << ", " << ranges[j][1] << ") for \"" << listed[index] << "\"";
+                this->check((2 != j) ? found && position == foundCandidate : ! found, description.str());
+            }
+        }
+        
+        ThreadedSearch search(rawString, encryptedString, KeyPattern(56), 3);
+        search.setWordList(&words);
+        uint64_t foundCandidate = 0;
+        bool found = search.run(0, words.getSize(), foundCandidate);
+        
+        std::ostringstream description;
+        description << "threaded word list search for \"" << listed[index] << "\"";
+        this->check(found && position == foundCandidate && listed[index] == words.getWord(foundCandidate), description.str());
+    }
+}
+
+/**
+ * Checks that every engine of the registry is found by its id and its name,
+ * encrypts through the AlgorithmInterface, and finds a random key of the
+ * given key pattern with the search it is bound to.
+ */
+void SelfTest::testRegistry(const KeyPattern& pattern, int count)
+{
+    this->check(NULL != AlgorithmRegistry::find(AlgorithmRegistry::defaultAlgorithmId) && NULL == AlgorithmRegistry::find(0) && NULL == AlgorithmRegistry::find("rot13"), "algorithm registry lookups");
+    
+    for (int i = 0; i < AlgorithmRegistry::getNumberOfEngines(); i++) {
+        const AlgorithmEngine& engine = AlgorithmRegistry::getEngine(i);
+        this->check(&engine == AlgorithmRegistry::find(engine.algorithmId) && &engine == AlgorithmRegistry::find(std::string(engine.name)) && 8 == engine.blockSize && 0 < engine.batchWidth,
+            std::string(engine.name) + " registry entry");
+        
+        AlgorithmInterface* algorithm = engine.create();
+        std::string description;
+        this->check(engine.prepare(algorithm, NULL, description), std::string(engine.name) + " engine preparation");
+        
+        // the keys of a Triple-DES engine past the first one are random,
+        // and follow the first one in its key strings.
+        std::string outerKeys;
+        if (64 < engine.keyLength) {
+            AlgorithmTripleDES* tripleDES = static_cast<AlgorithmTripleDES*>(algorithm);
+            tripleDES->setOuterKeys(this->random(), this->random());
+            outerKeys = tripleDES->getOuterKeyString();
+        }
+        this->check(64 + outerKeys.size() == (size_t) engine.keyLength, std::string(engine.name) + " key length");
+        
+        for (int j = 0; j < count; j++) {
+            uint64_t candidate = this->random() & (pattern.getNumberOfCandidates() - 1);
+            char firstKey[64 + 1];
+            pattern.getKeyString(candidate, firstKey);
+            std::string key = firstKey + outerKeys;
+            
+            std::string rawString(19, ' ');
+            for (size_t k = 0; k < rawString.size(); k++) {
+                rawString[k] = 'A' + this->random() % 26;
+            }
+            std::string encryptedString = algorithm->encrpyt(rawString, key.c_str(), engine.keyLength);
+            
+            // the key is searched for around it, and right after it, where
+            // only a key that differs from it in parity bits can be found.
+            uint64_t first = (candidate > 100) ? candidate - 100 : 0;
+            uint64_t last = (candidate + 100 < pattern.getNumberOfCandidates()) ? candidate + 100 : pattern.getNumberOfCandidates();
+            SearchJob job = { &rawString, &encryptedString, &pattern, NULL, NULL };
+            for (int k = 0; k < 2; k++) {
+                uint64_t from = (0 == k) ? first : candidate + 1;
+                uint64_t expectedCandidate = 0, foundCandidate = 0;
+                bool expectedFound = this->firstEquivalent(pattern, candidate, from, last, expectedCandidate);
+                bool found = engine.searchChunk(algorithm, job, from, last, foundCandidate);
+                
+                std::ostringstream message;
+                message << engine.name << " registry search of [" << from << ", " << last << ") for candidate " << candidate;
+                this->check(found == expectedFound && (! found || foundCandidate == expectedCandidate), message.str());
+            }
+            this->check(algorithm->decrypt(encryptedString, key.c_str(), engine.keyLength) == rawString, std::string(engine.name) + " decryption through the interface");
+        }
+        delete algorithm;
+    }
+}
+
+/**
+ * Checks Triple-DES with two and three keys against the worked example of
+ * NIST SP 800-67, encrypting and decrypting.
+ */
+void SelfTest::testTripleDES()
+{
+    const std::string rawString = "The qufck brown fox jump";
+    const uint64_t keys[3] = { 0x0123456789ABCDEFULL, 0x23456789ABCDEF01ULL, 0x456789ABCDEF0123ULL };
+    const uint64_t expected[2][3] = {
+        { 0xC44862F70CF2FBDCULL, 0x9077D0909FA91B88ULL, 0x4CABD61FC58E0CBBULL },
+        { 0xA826FD8CE53B855FULL, 0xCCE21C8112256FE6ULL, 0x68D5C05DD9B6B900ULL }
+    };
+    
+    for (int numberOfKeys = 2; numberOfKeys <= 3; numberOfKeys++) {
+        AlgorithmTripleDES tripleDES(numberOfKeys);
+        std::string key;
+        for (int i = 0; i < numberOfKeys; i++) {
+            key += SelfTest::keyString(keys[i]);
+        }
+        
+        std::string encryptedString = tripleDES.encrpyt(rawString, key.c_str(), 64 * numberOfKeys);
+        bool matches = (24 == encryptedString.size());
+        for (int i = 0; matches && i < 3; i++) {
+            matches = (expected[numberOfKeys - 2][i] == loadBlock((const unsigned char*) encryptedString.data() + 8 * i));
+        }
+        
+        std::ostringstream name;
+        name << "triple-des EDE" << numberOfKeys;
+        this->check(matches, name.str() + " known answer");
+        this->check(tripleDES.decrypt(encryptedString, key.c_str(), 64 * numberOfKeys) == rawString, name.str() + " decryption");
+    }
+}
+
+/**
+ * Checks the meet in the middle search of double DES with random keys of
+ * random key patterns: with the table in memory, and with a memory limit
+ * that splits it into partition files. The first keys searched are a range
+ * around the first key, or right after it, where only a key that differs
+ * from it in parity bits can be found.
+ */
+void SelfTest::testMeetInTheMiddle(int count)
+{
+    const uint64_t parityBits = 0x0101010101010101ULL;
+    
+    for (int i = 0; i < count; i++) {
+        KeyPattern firstPattern = this->randomPattern(12);
+        KeyPattern secondPattern = this->randomPattern(12);
+        uint64_t firstCandidate = this->random() & (firstPattern.getNumberOfCandidates() - 1);
+        uint64_t secondCandidate = this->random() & (secondPattern.getNumberOfCandidates() - 1);
+        
+        std::string rawString(19, ' ');
+        for (size_t k = 0; k < rawString.size(); k++) {
+            rawString[k] = 'A' + this->random() % 26;
+        }
+        std::string encryptedString = MeetInTheMiddle::encrypt(rawString, firstPattern.getKey(firstCandidate), secondPattern.getKey(secondCandidate));
+        
+        // double DES is DES twice.
+        AlgorithmDES reference;
+        std::string firstKey = SelfTest::keyString(firstPattern.getKey(firstCandidate)), secondKey = SelfTest::keyString(secondPattern.getKey(secondCandidate));
+        this->check(encryptedString == reference.encrpyt(reference.encrpyt(rawString, firstKey.c_str(), 64), secondKey.c_str(), 64), "double DES encryption");
+        
+        uint64_t last = (firstCandidate + 100 < firstPattern.getNumberOfCandidates()) ? firstCandidate + 100 : firstPattern.getNumberOfCandidates();
+        for (int k = 0; k < 4; k++) {
+            uint64_t from = (2 > k) ? ((firstCandidate > 100) ? firstCandidate - 100 : 0) : firstCandidate + 1;
+            size_t memoryLimit = (0 == k % 2) ? 64 << 20 : 512;
+            MeetInTheMiddle search(firstPattern, secondPattern, memoryLimit, "/tmp");
+            
+            uint64_t expectedCandidate = 0, firstFound = 0, secondFound = 0;
+            bool expectedFound = this->firstEquivalent(firstPattern, firstCandidate, from, last, expectedCandidate);
+            bool found = search.search(rawString, encryptedString, from, last, firstFound, secondFound);
+            
+            std::ostringstream message;
+            message << "meet in the middle search of [" << from << ", " << last << ") in " << search.getNumberOfPartitions() << " partitions for candidates "
+                << firstCandidate << " and " << secondCandidate;
+            bool partitioned = (1 < search.getNumberOfPartitions());
+            this->check(found == expectedFound && partitioned == (1 == k % 2 && 64 < last - from)
+                && (! found || ((firstPattern.getKey(firstFound) ^ firstPattern.getKey(firstCandidate)) & ~parityBits) == 0), message.str());
+            this->check(! found || ((secondPattern.getKey(secondFound) ^ secondPattern.getKey(secondCandidate)) & ~parityBits) == 0, message.str() + ", second key");
+        }
+    }
+}
+
+/**
+ * Checks that arena buffers start at cache lines, that rewinding gives the
+ * same buffers back and that a warm arena adds no blocks; then searches
+ * chunk after chunk with every engine of the registry, and with the
+ * bitsliced engine on texts of random lengths, and checks that none of them
+ * goes to the heap after its first chunk.
+ */
+void SelfTest::testScratchAllocations(int count)
+{
+    Arena arena;
+    bool aligned = true;
+    Arena::Mark start = arena.getMark();
+    for (int i = 0; i < 100; i++) {
+        void* buffer = arena.allocate(1 + this->random() % 3000);
+        aligned = aligned && 0 == ((uintptr_t) buffer & (Arena::lineSize - 1));
+    }
+    this->check(aligned, "arena buffer alignment");
+    
+    // a buffer taken again after a rewind is the same one, and a warm
+    // arena doesn't grow.
+    arena.rewind(start);
+    size_t numberOfBlocks = arena.getNumberOfBlocks();
+    unsigned char* firstBuffer = NULL;
+    bool reused = true;
+    for (int i = 0; i < count; i++) {
+        ArenaScope outer(arena);
+        unsigned char* first = arena.allocateArray<unsigned char>(100);
+        unsigned char* second;
+        {
+            ArenaScope inner(arena);
+            second = arena.allocateArray<unsigned char>(5000);
+        }
+        reused = reused && (NULL == firstBuffer || first == firstBuffer) && second == arena.allocateArray<unsigned char>(5000);
+        firstBuffer = first;
+    }
+    this->check(reused && numberOfBlocks == arena.getNumberOfBlocks(), "arena scopes reuse their buffers");
+    
+    KeyPattern pattern(24);
+    for (int i = 0; i < AlgorithmRegistry::getNumberOfEngines(); i++) {
+        const AlgorithmEngine& engine = AlgorithmRegistry::getEngine(i);
+        AlgorithmInterface* algorithm = engine.create();
+        std::string description;
+        if (! engine.prepare(algorithm, NULL, description)) {
+            this->check(false, std::string(engine.name) + " engine preparation");
+            delete algorithm;
+            continue;
+        }
+        
+        std::string rawString(19, ' ');
+        for (size_t j = 0; j < rawString.size(); j++) {
+            rawString[j] = 'A' + this->random() % 26;
+        }
+        std::string encryptedString(rawString.size(), ' ');
+        for (size_t j = 0; j < encryptedString.size(); j++) {
+            encryptedString[j] = this->random();
+        }
+        
+        // the first chunk warms the engine up; the next ones are counted.
+        SearchJob job = { &rawString, &encryptedString, &pattern, NULL, NULL };
+        uint64_t foundCandidate = 0, first = this->random() % 1000;
+        engine.searchChunk(algorithm, job, first, first + 4 * engine.batchWidth, foundCandidate);
+        uint64_t allocations = AllocationCounter::getThreadAllocations();
+        for (int j = 0; j < count; j++) {
+            first = this->random() % (pattern.getNumberOfCandidates() - 4 * engine.batchWidth);
+            engine.searchChunk(algorithm, job, first, first + 1 + this->random() % (4 * engine.batchWidth), foundCandidate);
+        }
+        
+        allocations = AllocationCounter::getThreadAllocations() - allocations;
+        std::ostringstream message;
+        message << engine.name << " steady-state heap allocations: " << allocations;
+        this->check(0 == allocations, message.str());
+        delete algorithm;
+    }
+    
+    // texts of other lengths take buffers of other sizes from the blocks the
+    // engine already has, or add one; once each length has been searched,
+    // none adds any more.
+    AlgorithmDESBitslice bitslice;
+    std::vector<std::string> rawStrings(count), encryptedStrings(count);
+    for (int i = 0; i < count; i++) {
+        rawStrings[i].resize(8 + this->random() % 4000);
+        encryptedStrings[i].resize(rawStrings[i].size());
+        for (size_t j = 0; j < rawStrings[i].size(); j++) {
+            rawStrings[i][j] = 'A' + this->random() % 26;
+            encryptedStrings[i][j] = this->random();
+        }
+    }
+    uint64_t allocations = 0, foundCandidate = 0;
+    for (int round = 0; round < 2; round++) {
+        if (1 == round) {
+            allocations = AllocationCounter::getThreadAllocations();
+        }
+        for (int i = 0; i < count; i++) {
+            bitslice.searchKeys(rawStrings[i], encryptedStrings[i], pattern, 0, 256, foundCandidate);
+        }
+    }
+    allocations = AllocationCounter::getThreadAllocations() - allocations;
+    this->check(0 == allocations, "bitslice steady-state heap allocations over texts of random lengths");
+}
@@ -0,0 +1,211 @@
+/**
+ * File: SelfTest.h
+ * 
+ * Header file for the SelfTest class.
+ * 
+ * @version 0.1
+ */
+
+// make sure that the signature of the class is defined only once.
+#ifndef SELFTEST_H
+#define	SELFTEST_H
+
+// include the string library for the std::string class.
+#include <string>
+
+// include the fixed-width integer types.
+#include <stdint.h>
+
+// include the KeyPattern class signature.
+#include "KeyPattern.h"
+
+/**
+ * Signature of the SelfTest class.
+ * 
+ * SelfTest checks every DES path of the application before it is trusted
+ * with a search: the legacy, reference and core implementations and every
+ * bitslice kernel the CPU supports. It runs
+ * 
+ *   - the FIPS 46 / NIST known-answer vectors, encrypting and decrypting,
+ *   - randomized differential tests: random keys and blocks must give the
+ *     same ciphertext on every engine and decrypt back,
+ *   - randomized search tests: a key hidden in a range with unaligned ends
+ *     (or right at an end) must be found by every engine and by the
+ *     threaded search, as the first candidate of the range that is the key
+ *     or differs from it only in parity bits. The unknown key bits are the
+ *     first ones of the key, or scattered over it,
+ *   - the Triple-DES known answers and the meet in the middle search of
+ *     double DES,
+ *   - the FIPS 81 examples of the ECB and CBC streams, random texts
+ *     streamed in random pieces both ways, and random files encrypted and
+ *     decrypted by the file cipher,
+ *   - the scratch arena, and that an engine searching chunk after chunk
+ *     makes no heap allocation after its first one.
+ * 
+ * It is started with "main_p selftest [seed]"; the seed of the random tests
+ * is printed, so that a failure can be repeated.
+ * 
+ * @since version 0.1
+ * @see AlgorithmDES
+ * @see AlgorithmDESLegacy
+ * @see AlgorithmDESBitslice
+ * @see DESCore
+ */
+class SelfTest
+{
+    // public attributes and methods of the class.
+    public:
+        
+        /**
+         * Constructor method of the class.
+         * 
+         * @param seed Seed of the random tests.
+         */
+        SelfTest(uint64_t seed);
+        
+        /**
+         * Runs every test and prints one line per failure and a summary.
+         * 
+         * @return Whether every test passed.
+         */
+        bool run();
+    
+    // private attributes and methods of the class.
+    private:
+        
+        /**
+         * State of the random number generator (xorshift64*).
+         */
+        uint64_t state;
+        
+        /**
+         * Number of checks that passed and failed.
+         */
+        int passed;
+        int failed;
+        
+        /**
+         * Checks the known-answer vectors on every engine.
+         */
+        void testKnownAnswers();
+        
+        /**
+         * Checks that every engine encrypts random blocks with random keys
+         * the way the core implementation does, and decrypts them back.
+         */
+        void testDifferential(int count);
+        
+        /**
+         * Checks the key search of every engine, and of the threaded search,
+         * with random keys of the given key pattern.
+         */
+        void testSearch(const KeyPattern& pattern, int count);
+        
+        /**
+         * Checks the batch search of every kernel, and of the threaded
+         * search, with a batch of random keys of the given key pattern.
+         */
+        void testBatch(const KeyPattern& pattern, int count);
+        
+        /**
+         * Checks the key list search of every kernel, and of the threaded
+         * search, with a temporary key file of random keys.
+         */
+        void testKeyList(int count);
+        
+        /**
+         * Checks the key derivation of passwords, and the word list search
+         * of every kernel and of the threaded search, with a temporary file
+         * of random words.
+         */
+        void testWordList(int count);
+        
+        /**
+         * Checks that every engine of the registry is found by its id and
+         * its name, and finds random keys of the given key pattern with the
+         * search it is bound to.
+         */
+        void testRegistry(const KeyPattern& pattern, int count);
+        
+        /**
+         * Checks Triple-DES with two and three keys against known answers.
+         */
+        void testTripleDES();
+        
+        /**
+         * Checks the meet in the middle search of double DES, with the
+         * table in memory and split into partition files.
+         */
+        void testMeetInTheMiddle(int count);
+        
+        /**
+         * Checks the ECB and CBC streams against known answers and against
+         * DESCore, with random texts fed in random pieces, and the block
+         * runs of every kernel.
+         */
+        void testCipherStream(int count);
+        
+        /**
+         * Checks the file cipher against a single stream, with small chunks
+         * and several workers, on temporary files of random sizes.
+         */
+        void testFileCipher(int count);
+        
+        /**
+         * Checks the alignment and the reuse of arena buffers, and counts
+         * the heap allocations of every registry engine searching chunks
+         * after the first one.
+         */
+        void testScratchAllocations(int count);
+        
+        /**
+         * Returns a random key pattern with the given number of unknown bits.
+         */
+        KeyPattern randomPattern(int freeBits);
+        
+        /**
+         * Encrypts or decrypts one block with the given engine and compares
+         * the result to the expected block.
+         */
+        template <typename Engine>
+        void checkBlock(Engine& engine, std::string name, uint64_t key, uint64_t input, uint64_t expected, bool decrypt);
+        
+        /**
+         * Searches [firstCandidate, lastCandidate) with the given engine and
+         * compares the result to the expected one.
+         */
+        template <typename Engine>
+        void checkSearch(Engine& engine, std::string name, const std::string& rawString, const std::string& encryptedString,
+            const KeyPattern& pattern, uint64_t firstCandidate, uint64_t lastCandidate, bool expectedFound, uint64_t expectedCandidate);
+        
+        /**
+         * Records the result of a check; a failure is printed.
+         */
+        void check(bool condition, std::string description);
+        
+        /**
+         * Returns the next random number.
+         */
+        uint64_t random();
+        
+        /**
+         * Returns the first candidate of [firstCandidate, lastCandidate) that
+         * is the given key or differs from it only in parity bits.
+         * 
+         * @return Whether there is such a candidate.
+         */
+        static bool firstEquivalent(const KeyPattern& pattern, uint64_t candidate, uint64_t firstCandidate, uint64_t lastCandidate, uint64_t& equivalent);
+        
+        /**
+         * Returns the key string ('0'/'1' characters) of a 64-bit key.
+         */
+        static std::string keyString(uint64_t key);
+        
+        /**
+         * Returns a block as 16 hex digits.
+         */
+        static std::string hexString(uint64_t block);
+};
+
+// end of the class signature.
+#endif	/* SELFTEST_H */
@@ -0,0 +1,218 @@
+/**
+ * File: SocketChannel.cpp
+ * 
+ * Source code file for the SocketChannel class.
+ * 
+ * @version 0.1
+ */
+
+// include standard libraries.
+#include <stdio.h>
+#include <string.h>
+
+// include the socket libraries.
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netdb.h>
+#include <unistd.h>
+
+// include the errno library for the errno variable.
+#include <errno.h>
+
+// include the signature of the class.
+#include "SocketChannel.h"
+
+/**
+ * Constructor method of the class.
+ * 
+ * @param socket A connected socket; the channel closes it.
+ */
+SocketChannel::SocketChannel(int socket)
+{
+    this->socket = socket;
+    pthread_mutex_init(&this->sendMutex, NULL);
+}
+
+/**
+ * Destructor method of the class; closes the socket.
+ */
+SocketChannel::~SocketChannel()
+{
+    close(this->socket);
+    pthread_mutex_destroy(&this->sendMutex);
+}
+
+/**
+ * Returns the socket, for poll().
+ */
+int SocketChannel::getSocket()
+{
+    return this->socket;
+}
+
+/**
+ * Sends one line; the newline is added. A peer that has gone away doesn't
+ * raise SIGPIPE, the send just fails.
+ * 
+ * @return Whether the line was sent.
+ */
+bool SocketChannel::sendLine(const std::string& line)
+{
+    std::string message = line + "\n";
+    
+    pthread_mutex_lock(&this->sendMutex);
+    size_t sent = 0;
+    while (sent < message.size()) {
+        ssize_t count = send(this->socket, message.data() + sent, message.size() - sent, MSG_NOSIGNAL);
+        if (0 > count && EINTR == errno) {
+            continue;
+        }
+        if (0 >= count) {
+            break;
+        }
+        sent += count;
+    }
+    pthread_mutex_unlock(&this->sendMutex);
+    
+    return sent == message.size();
+}
+
+/**
+ * Reads what has arrived on the socket into the line buffer; it is called
+ * when poll() says the socket is readable, so it doesn't block.
+ * 
+ * @return Whether the connection is still open.
+ */
+bool SocketChannel::receive()
+{
+    char data[4096];
+    ssize_t count = recv(this->socket, data, sizeof(data), 0);
+    if (0 > count && EINTR == errno) {
+        return true;
+    }
+    if (0 >= count) {
+        return false;
+    }
+    this->buffer.append(data, count);
+    
+    // a line that doesn't end is not a line of the protocol.
+    return this->buffer.size() <= SocketChannel::maximumLineLength || std::string::npos != this->buffer.find('\n');
+}
+
+/**
+ * Takes the next complete line out of the line buffer.
+ * 
+ * @param line Receives the line, without the newline.
+ * @return Whether there was a complete line.
+ */
+bool SocketChannel::nextLine(std::string& line)
+{
+    size_t end = this->buffer.find('\n');
+    if (std::string::npos == end) {
+        return false;
+    }
+    line = this->buffer.substr(0, end);
+    this->buffer.erase(0, end + 1);
+    return true;
+}
+
+/**
+ * Opens a listening socket on the given address. A Unix domain socket left
+ * behind by an earlier run is replaced.
+ * 
+ * @return The socket, or -1 if the address can't be listened on.
+ */
+int SocketChannel::listenOn(const std::string& address)
+{
+    int listener = SocketChannel::openSocket(address, true);
+    if (0 <= listener && 0 != listen(listener, 64)) {
+        close(listener);
+        return -1;
+    }
+    return listener;
+}
+
+/**
+ * Connects to the given address.
+ * 
+ * @return The socket, or -1 if it can't be connected to.
+ */
+int SocketChannel::connectTo(const std::string& address)
+{
+    return SocketChannel::openSocket(address, false);
+}
+
+/**
+ * Opens a socket of the given address, bound to it or connected to it.
+ */
+int SocketChannel::openSocket(const std::string& address, bool listening)
+{
+    // "unix:path" is a Unix domain socket.
+    if (0 == address.compare(0, 5, "unix:")) {
+        struct sockaddr_un unixAddress;
+        std::string path = address.substr(5);
+        if (path.empty() || path.size() >= sizeof(unixAddress.sun_path)) {
+            return -1;
+        }
+        memset(&unixAddress, 0, sizeof(unixAddress));
+        unixAddress.sun_family = AF_UNIX;
+        strcpy(unixAddress.sun_path, path.c_str());
+        
+        int unixSocket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (0 > unixSocket) {
+            return -1;
+        }
+        if (listening) {
+            unlink(path.c_str());
+        }
+        int result = listening ? bind(unixSocket, (struct sockaddr*) &unixAddress, sizeof(unixAddress))
+            : connect(unixSocket, (struct sockaddr*) &unixAddress, sizeof(unixAddress));
+        if (0 != result) {
+            close(unixSocket);
+            return -1;
+        }
+        return unixSocket;
+    }
+    
+    // anything else is "host:port"; an empty host means every interface.
+    size_t colon = address.rfind(':');
+    if (std::string::npos == colon) {
+        return -1;
+    }
+    std::string host = address.substr(0, colon);
+    std::string port = address.substr(colon + 1);
+    
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = listening ? AI_PASSIVE : 0;
+    struct addrinfo* addresses;
+    if (0 != getaddrinfo(host.empty() ? NULL : host.c_str(), port.c_str(), &hints, &addresses)) {
+        return -1;
+    }
+    
+    int tcpSocket = -1;
+    for (struct addrinfo* candidate = addresses; NULL != candidate && 0 > tcpSocket; candidate = candidate->ai_next) {
+        tcpSocket = ::socket(candidate->ai_family, candidate->ai_socktype, candidate->ai_protocol);
+        if (0 > tcpSocket) {
+            continue;
+        }
+        
+        int result;
+        if (listening) {
+            int reuse = 1;
+            setsockopt(tcpSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+            result = bind(tcpSocket, candidate->ai_addr, candidate->ai_addrlen);
+        } else {
+            result = connect(tcpSocket, candidate->ai_addr, candidate->ai_addrlen);
+        }
+        if (0 != result) {
+            close(tcpSocket);
+            tcpSocket = -1;
+        }
+    }
+    freeaddrinfo(addresses);
+    
+    return tcpSocket;
+}
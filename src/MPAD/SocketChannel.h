@@ -0,0 +1,124 @@
+/**
+ * File: SocketChannel.h
+ * 
+ * Header file for the SocketChannel class.
+ * 
+ * @version 0.1
+ */
+
+// make sure that the signature of the class is defined only once.
+#ifndef SOCKETCHANNEL_H
+#define	SOCKETCHANNEL_H
+
+// include the string library for the std::string class.
+#include <string>
+
+// include the pthread library for the send mutex.
+#include <pthread.h>
+
+/**
+ * Signature of the SocketChannel class.
+ * 
+ * SocketChannel is one end of a connection between the coordinator and a
+ * worker agent: a stream socket that carries one message per line, the
+ * words of a message separated by spaces. Addresses are either "host:port"
+ * (TCP) or "unix:path" (a Unix domain socket).
+ * 
+ * Lines can be sent from several threads; receiving is left to one thread,
+ * which calls receive() when the socket is readable and then takes the
+ * complete lines with nextLine().
+ * 
+ * @since version 0.1
+ * @see Coordinator
+ * @see WorkerAgent
+ */
+class SocketChannel
+{
+    // public attributes and methods of the class.
+    public:
+        
+        /**
+         * Constructor method of the class.
+         * 
+         * @param socket A connected socket; the channel closes it.
+         */
+        SocketChannel(int socket);
+        
+        /**
+         * Destructor method of the class; closes the socket.
+         */
+        ~SocketChannel();
+        
+        /**
+         * Returns the socket, for poll().
+         */
+        int getSocket();
+        
+        /**
+         * Sends one line; the newline is added.
+         * 
+         * @return Whether the line was sent.
+         */
+        bool sendLine(const std::string& line);
+        
+        /**
+         * Reads what has arrived on the socket into the line buffer.
+         * 
+         * @return Whether the connection is still open.
+         */
+        bool receive();
+        
+        /**
+         * Takes the next complete line out of the line buffer.
+         * 
+         * @param line Receives the line, without the newline.
+         * @return Whether there was a complete line.
+         */
+        bool nextLine(std::string& line);
+        
+        /**
+         * Opens a listening socket on the given address.
+         * 
+         * @return The socket, or -1 if the address can't be listened on.
+         */
+        static int listenOn(const std::string& address);
+        
+        /**
+         * Connects to the given address.
+         * 
+         * @return The socket, or -1 if it can't be connected to.
+         */
+        static int connectTo(const std::string& address);
+        
+        /**
+         * Longest line accepted; a peer that sends a longer one is cut off.
+         */
+        static const size_t maximumLineLength = 4096;
+    
+    // private attributes and methods of the class.
+    private:
+        
+        /**
+         * The connected socket.
+         */
+        int socket;
+        
+        /**
+         * What has been received and not taken out as lines yet.
+         */
+        std::string buffer;
+        
+        /**
+         * Serializes the lines sent from several threads.
+         */
+        pthread_mutex_t sendMutex;
+        
+        /**
+         * Opens a socket of the given address, bound to it or connected to
+         * it.
+         */
+        static int openSocket(const std::string& address, bool listening);
+};
+
+// end of the class signature.
+#endif	/* SOCKETCHANNEL_H */
@@ -0,0 +1,352 @@
+/**
+ * File: TargetSet.cpp
+ * 
+ * Source code file for the TargetSet class.
+ * 
+ * @version 0.1
+ */
+
+// include the signature of the class.
+#include "TargetSet.h"
+
+// include the hex decoding of the pairs.
+#include "AlgorithmInterface.h"
+
+// include the block permutations of the bitsliced kernel.
+#include "BitsliceDES.h"
+
+// include the MappedFile class signature.
+#include "MappedFile.h"
+
+/**
+ * Constructor method of the class; the set is empty.
+ */
+TargetSet::TargetSet()
+{
+    this->numberOfFound.store(0);
+    pthread_mutex_init(&this->mutex, NULL);
+}
+
+/**
+ * Destructor method of the class.
+ */
+TargetSet::~TargetSet()
+{
+    pthread_mutex_destroy(&this->mutex);
+}
+
+/**
+ * Reads the targets of a file and groups them. The file is mapped, not read
+ * into a buffer, and the hex is decoded straight out of the mapping.
+ * 
+ * @return Whether the file was read and every line of it is a target.
+ */
+bool TargetSet::load(const std::string& path)
+{
+    MappedFile file;
+    if (! file.open(path)) {
+        return false;
+    }
+    file.adviseSequential();
+    
+    size_t offset = 0, length;
+    const char* line;
+    while (file.nextLine(offset, line, length)) {
+        std::string rawString, encryptedString;
+        bool blank;
+        if (! TargetSet::parsePair(line, length, rawString, encryptedString, blank)) {
+            return false;
+        }
+        if (! blank && ! this->add(rawString, encryptedString)) {
+            return false;
+        }
+    }
+    
+    this->build();
+    return true;
+}
+
+/**
+ * Reads the first raw/encrypted string pair of a file of the same format, for
+ * a search of a single pair of any length.
+ * 
+ * @return Whether the file was read and has a pair.
+ */
+bool TargetSet::loadPair(const std::string& path, std::string& rawString, std::string& encryptedString)
+{
+    MappedFile file;
+    if (! file.open(path)) {
+        return false;
+    }
+    
+    size_t offset = 0, length;
+    const char* line;
+    while (file.nextLine(offset, line, length)) {
+        bool blank;
+        if (! TargetSet::parsePair(line, length, rawString, encryptedString, blank)) {
+            return false;
+        }
+        if (! blank) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Parses a "<raw hex> <encrypted hex>" line.
+ * 
+ * @param blank Receives whether the line is blank or a comment, which isn't
+ * an error.
+ * @return Whether the line is a pair, blank or a comment.
+ */
+bool TargetSet::parsePair(const char* line, size_t length, std::string& rawString, std::string& encryptedString, bool& blank)
+{
+    // split the line into its words.
+    const char* words[3];
+    size_t lengths[3];
+    int count = 0;
+    for (size_t i = 0; i < length; ) {
+        while (i < length && (' ' == line[i] || '\t' == line[i])) {
+            i++;
+        }
+        if (i == length) {
+            break;
+        }
+        if (3 == count) {
+            return false;
+        }
+        words[count] = line + i;
+        while (i < length && ' ' != line[i] && '\t' != line[i]) {
+            i++;
+        }
+        lengths[count] = line + i - words[count];
+        count++;
+    }
+    
+    blank = (0 == count || '#' == words[0][0]);
+    if (blank) {
+        return true;
+    }
+    return 2 == count && AlgorithmInterface::decodeHex(words[0], lengths[0], rawString) && AlgorithmInterface::decodeHex(words[1], lengths[1], encryptedString);
+}
+
+/**
+ * Adds a target; build() must be called before the set is searched.
+ * 
+ * @return Whether the target is long enough to be searched for.
+ */
+bool TargetSet::add(const std::string& rawString, const std::string& encryptedString)
+{
+    if (8 > rawString.size() || 8 > encryptedString.size()) {
+        return false;
+    }
+    
+    Target target;
+    target.rawString = rawString;
+    target.encryptedString = encryptedString;
+    target.ipPlain = bitslicePermute(bitsliceLoadBlock((const unsigned char*) rawString.data()), bitsliceIP);
+    target.ipCipher = bitslicePermute(bitsliceLoadBlock((const unsigned char*) encryptedString.data()), bitsliceIP);
+    target.found = false;
+    target.foundCandidate = 0;
+    this->targets.push_back(target);
+    return true;
+}
+
+/**
+ * Groups the targets by their first plaintext block and builds the block
+ * table of every group: at least twice as many slots as targets, so that a
+ * lookup seldom looks at more than a slot or two.
+ */
+void TargetSet::build()
+{
+    this->groups.clear();
+    for (size_t i = 0; i < this->targets.size(); i++) {
+        size_t group = 0;
+        while (group < this->groups.size() && this->groups[group].ipPlain != this->targets[i].ipPlain) {
+            group++;
+        }
+        if (group == this->groups.size()) {
+            this->groups.push_back(Group());
+            this->groups[group].ipPlain = this->targets[i].ipPlain;
+        }
+        this->groups[group].targets.push_back((int) i);
+    }
+    
+    for (size_t g = 0; g < this->groups.size(); g++) {
+        Group& group = this->groups[g];
+        
+        // the empty slots hold a value none of the targets has.
+        uint64_t empty = ~(uint64_t) 0;
+        for (bool taken = true; taken; ) {
+            taken = false;
+            for (size_t i = 0; i < group.targets.size() && ! taken; i++) {
+                taken = (empty == this->targets[group.targets[i]].ipCipher);
+            }
+            if (taken) {
+                empty--;
+            }
+        }
+        
+        int bits = 1;
+        while (((size_t) 1 << bits) < 2 * group.targets.size()) {
+            bits++;
+        }
+        group.slots.assign((size_t) 1 << bits, empty);
+        group.table.mask = group.slots.size() - 1;
+        group.table.shift = 64 - bits;
+        group.table.empty = empty;
+        group.table.slots = &group.slots[0];
+        
+        for (size_t i = 0; i < group.targets.size(); i++) {
+            uint64_t block = this->targets[group.targets[i]].ipCipher;
+            uint64_t slot = group.table.slotOf(block);
+            while (empty != group.slots[slot] && block != group.slots[slot]) {
+                slot = (slot + 1) & group.table.mask;
+            }
+            group.slots[slot] = block;
+        }
+    }
+}
+
+/**
+ * Returns the number of targets.
+ */
+int TargetSet::getNumberOfTargets() const
+{
+    return (int) this->targets.size();
+}
+
+/**
+ * Returns the raw string of a target.
+ */
+const std::string& TargetSet::getRawString(int target) const
+{
+    return this->targets[target].rawString;
+}
+
+/**
+ * Returns the encrypted string of a target.
+ */
+const std::string& TargetSet::getEncryptedString(int target) const
+{
+    return this->targets[target].encryptedString;
+}
+
+/**
+ * Returns the number of groups.
+ */
+int TargetSet::getNumberOfGroups() const
+{
+    return (int) this->groups.size();
+}
+
+/**
+ * Returns the first plaintext block of a group's targets, after IP.
+ */
+uint64_t TargetSet::getGroupPlain(int group) const
+{
+    return this->groups[group].ipPlain;
+}
+
+/**
+ * Returns the table of the first ciphertext blocks of a group's targets,
+ * after IP.
+ */
+const BitsliceBlockTable& TargetSet::getGroupTable(int group) const
+{
+    return this->groups[group].table;
+}
+
+/**
+ * Returns the targets of a group.
+ */
+const std::vector<int>& TargetSet::getGroupTargets(int group) const
+{
+    return this->groups[group].targets;
+}
+
+/**
+ * Returns the first ciphertext block of a target, after IP.
+ */
+uint64_t TargetSet::getCipherBlock(int target) const
+{
+    return this->targets[target].ipCipher;
+}
+
+/**
+ * Records the key found for a target; of two keys found for the same target
+ * (keys that differ only in parity bits), the lower candidate is kept.
+ * 
+ * @return Whether the target had no key yet.
+ */
+bool TargetSet::reportFound(int target, uint64_t candidate)
+{
+    pthread_mutex_lock(&this->mutex);
+    Target& entry = this->targets[target];
+    bool first = ! entry.found;
+    if (first || candidate < entry.foundCandidate) {
+        entry.foundCandidate = candidate;
+    }
+    entry.found = true;
+    if (first) {
+        this->numberOfFound.fetch_add(1);
+    }
+    pthread_mutex_unlock(&this->mutex);
+    
+    return first;
+}
+
+/**
+ * Tells whether a key has been found for a target.
+ */
+bool TargetSet::isFound(int target)
+{
+    pthread_mutex_lock(&this->mutex);
+    bool found = this->targets[target].found;
+    pthread_mutex_unlock(&this->mutex);
+    
+    return found;
+}
+
+/**
+ * Returns the candidate found for a target.
+ */
+uint64_t TargetSet::getFoundCandidate(int target)
+{
+    pthread_mutex_lock(&this->mutex);
+    uint64_t candidate = this->targets[target].foundCandidate;
+    pthread_mutex_unlock(&this->mutex);
+    
+    return candidate;
+}
+
+/**
+ * Tells whether every target of a group has its key.
+ */
+bool TargetSet::isGroupDone(int group)
+{
+    const std::vector<int>& members = this->groups[group].targets;
+    for (size_t i = 0; i < members.size(); i++) {
+        if (! this->isFound(members[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Returns the number of targets that have their keys.
+ */
+int TargetSet::getNumberOfFound() const
+{
+    return this->numberOfFound.load();
+}
+
+/**
+ * Tells whether every target has its key.
+ */
+bool TargetSet::isAllFound() const
+{
+    return this->numberOfFound.load() == (int) this->targets.size();
+}
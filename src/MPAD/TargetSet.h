@@ -0,0 +1,223 @@
+/**
+ * File: TargetSet.h
+ * 
+ * Header file for the TargetSet class.
+ * 
+ * @version 0.1
+ */
+
+// make sure that the signature of the class is defined only once.
+#ifndef TARGETSET_H
+#define	TARGETSET_H
+
+// include the string library for the std::string class.
+#include <string>
+
+// include the vector library.
+#include <vector>
+
+// include the fixed-width integer types.
+#include <stdint.h>
+
+// include the pthread library for the mutex.
+#include <pthread.h>
+
+// include the atomic library for the number of keys found.
+#include <atomic>
+
+// include the kernel declarations for the block table.
+#include "BitsliceKernels.h"
+
+/**
+ * Signature of the TargetSet class.
+ * 
+ * TargetSet holds the known raw/encrypted string pairs of a batch search,
+ * one target per pair, and the keys found for them so far. The targets are
+ * grouped by their first plaintext block: a candidate key is tried once per
+ * group, and its result is looked up among the first ciphertext blocks of
+ * the group's targets in a hash table (see BitsliceBlockTable). The cost of
+ * a batch search thus grows with the number of different first plaintext
+ * blocks, not with the number of targets.
+ * 
+ * The targets are read from a file with one "<raw hex> <encrypted hex>"
+ * pair per line; blank lines and lines starting with '#' are skipped. Both
+ * texts must be at least one block long. The file is mapped rather than
+ * read, so that a large one isn't copied.
+ * 
+ * The found keys may be reported from several threads.
+ * 
+ * @since version 0.1
+ * @see AlgorithmDESBitslice
+ * @see ThreadedSearch
+ */
+class TargetSet
+{
+    // public attributes and methods of the class.
+    public:
+        
+        /**
+         * Constructor method of the class; the set is empty.
+         */
+        TargetSet();
+        
+        /**
+         * Destructor method of the class.
+         */
+        ~TargetSet();
+        
+        /**
+         * Reads the targets of a file and groups them.
+         * 
+         * @return Whether the file was read and every line of it is a
+         * target.
+         */
+        bool load(const std::string& path);
+        
+        /**
+         * Reads the first raw/encrypted string pair of a file of the same
+         * format, for a search of a single pair of any length.
+         * 
+         * @return Whether the file was read and has a pair.
+         */
+        static bool loadPair(const std::string& path, std::string& rawString, std::string& encryptedString);
+        
+        /**
+         * Adds a target; build() must be called before the set is searched.
+         * 
+         * @return Whether the target is long enough to be searched for.
+         */
+        bool add(const std::string& rawString, const std::string& encryptedString);
+        
+        /**
+         * Groups the targets by their first plaintext block and builds the
+         * block table of every group.
+         */
+        void build();
+        
+        /**
+         * Returns the number of targets.
+         */
+        int getNumberOfTargets() const;
+        
+        /**
+         * Returns the raw string of a target.
+         */
+        const std::string& getRawString(int target) const;
+        
+        /**
+         * Returns the encrypted string of a target.
+         */
+        const std::string& getEncryptedString(int target) const;
+        
+        /**
+         * Returns the number of groups.
+         */
+        int getNumberOfGroups() const;
+        
+        /**
+         * Returns the first plaintext block of a group's targets, after IP.
+         */
+        uint64_t getGroupPlain(int group) const;
+        
+        /**
+         * Returns the table of the first ciphertext blocks of a group's
+         * targets, after IP.
+         */
+        const BitsliceBlockTable& getGroupTable(int group) const;
+        
+        /**
+         * Returns the targets of a group.
+         */
+        const std::vector<int>& getGroupTargets(int group) const;
+        
+        /**
+         * Returns the first ciphertext block of a target, after IP.
+         */
+        uint64_t getCipherBlock(int target) const;
+        
+        /**
+         * Records the key found for a target; of two keys found for the same
+         * target, the lower candidate is kept.
+         * 
+         * @return Whether the target had no key yet.
+         */
+        bool reportFound(int target, uint64_t candidate);
+        
+        /**
+         * Tells whether a key has been found for a target.
+         */
+        bool isFound(int target);
+        
+        /**
+         * Returns the candidate found for a target.
+         */
+        uint64_t getFoundCandidate(int target);
+        
+        /**
+         * Tells whether every target of a group has its key.
+         */
+        bool isGroupDone(int group);
+        
+        /**
+         * Returns the number of targets that have their keys.
+         */
+        int getNumberOfFound() const;
+        
+        /**
+         * Tells whether every target has its key.
+         */
+        bool isAllFound() const;
+    
+    // private attributes and methods of the class.
+    private:
+        
+        /**
+         * A known raw/encrypted pair and what has been found for it.
+         */
+        struct Target
+        {
+            std::string rawString;
+            std::string encryptedString;
+            uint64_t ipPlain;
+            uint64_t ipCipher;
+            bool found;
+            uint64_t foundCandidate;
+        };
+        
+        /**
+         * The targets that share a first plaintext block, and the table of
+         * their first ciphertext blocks.
+         */
+        struct Group
+        {
+            uint64_t ipPlain;
+            std::vector<int> targets;
+            std::vector<uint64_t> slots;
+            BitsliceBlockTable table;
+        };
+        
+        /**
+         * The targets and the groups.
+         */
+        std::vector<Target> targets;
+        std::vector<Group> groups;
+        
+        /**
+         * Number of targets that have their keys, and the mutex the keys are
+         * reported under.
+         */
+        std::atomic<int> numberOfFound;
+        pthread_mutex_t mutex;
+        
+        /**
+         * Parses a "<raw hex> <encrypted hex>" line.
+         * 
+         * @param blank Receives whether the line is blank or a comment, which
+         * isn't an error.
+         * @return Whether the line is a pair, blank or a comment.
+         */
+        static bool parsePair(const char* line, size_t length, std::string& rawString, std::string& encryptedString, bool& blank);
+};
+
+// end of the class signature.
+#endif	/* TARGETSET_H */
@@ -0,0 +1,314 @@
+/**
+ * File: ThreadedSearch.cpp
+ * 
+ * Source code file for the ThreadedSearch class.
+ * 
+ * @version 0.1
+ */
+
+// include the sysconf function.
+#include <unistd.h>
+
+// include the CPU affinity functions.
+#include <sched.h>
+
+// include the vector library.
+#include <vector>
+
+// include the signature of the class.
+#include "ThreadedSearch.h"
+
+// include the Logger class signature.
+#include "Logger.h"
+
+/**
+ * Constructor method of the class.
+ * 
+ * @param pattern The known and the free bits of the keys searched.
+ * @param numberOfThreads Number of worker threads; 0 means one per online
+ * core.
+ */
+ThreadedSearch::ThreadedSearch(std::string rawString, std::string encryptedString, const KeyPattern& pattern, int numberOfThreads)
+    : pattern(pattern)
+{
+    this->rawString = rawString;
+    this->encryptedString = encryptedString;
+    this->numberOfThreads = (0 < numberOfThreads) ? numberOfThreads : ThreadedSearch::getNumberOfCores();
+    this->control = NULL;
+    this->cancelled = false;
+    pthread_mutex_init(&this->controlMutex, NULL);
+    this->checkpoint = NULL;
+    this->checkpointInterval = 0;
+    this->targets = NULL;
+    this->keys = NULL;
+    this->words = NULL;
+    for (int i = 0; i < this->numberOfThreads; i++) {
+        this->engines.push_back(new AlgorithmDESBitslice());
+    }
+}
+
+/**
+ * Destructor method of the class.
+ */
+ThreadedSearch::~ThreadedSearch()
+{
+    if (NULL != this->control) {
+        ControlBlock::close(this->control);
+    }
+    pthread_mutex_destroy(&this->controlMutex);
+    for (size_t i = 0; i < this->engines.size(); i++) {
+        delete this->engines[i];
+    }
+}
+
+/**
+ * Makes run() write its progress to the given checkpoint.
+ * 
+ * @param checkpoint The checkpoint, or NULL for none.
+ * @param intervalSeconds Seconds between two writes.
+ */
+void ThreadedSearch::setCheckpoint(Checkpoint* checkpoint, int intervalSeconds)
+{
+    this->checkpoint = checkpoint;
+    this->checkpointInterval = intervalSeconds;
+}
+
+/**
+ * Makes run() search for the keys of a batch of targets instead of the key of
+ * the string pair; run() then returns whether every target has its key, and
+ * the keys are in the set.
+ * 
+ * @param targets The targets, or NULL for the string pair.
+ */
+void ThreadedSearch::setTargets(TargetSet* targets)
+{
+    this->targets = targets;
+}
+
+/**
+ * Makes run() search the keys of a key list instead of the keys of the key
+ * pattern; the candidates are then lines of the list.
+ * 
+ * @param keys The key list, or NULL for the key pattern.
+ */
+void ThreadedSearch::setKeyList(const KeyList* keys)
+{
+    this->keys = keys;
+}
+
+/**
+ * Makes run() search the keys of the passwords of a word list instead of the
+ * keys of the key pattern; the candidates are then offsets in the list.
+ * 
+ * @param words The word list, or NULL for the key pattern.
+ */
+void ThreadedSearch::setWordList(const WordList* words)
+{
+    this->words = words;
+}
+
+/**
+ * Stops the search that is running, and makes any later run() return right
+ * away; it may be called from another thread.
+ */
+void ThreadedSearch::cancel()
+{
+    pthread_mutex_lock(&this->controlMutex);
+    this->cancelled = true;
+    if (NULL != this->control) {
+        this->control->cancel();
+    }
+    pthread_mutex_unlock(&this->controlMutex);
+}
+
+/**
+ * Returns the number of worker threads.
+ */
+int ThreadedSearch::getNumberOfThreads()
+{
+    return this->numberOfThreads;
+}
+
+/**
+ * Returns the key search engine of the first thread; the others use the same
+ * kernel.
+ */
+AlgorithmDESBitslice& ThreadedSearch::getAlgorithm()
+{
+    return *this->engines[0];
+}
+
+/**
+ * Returns the control block of the search that is running (or has run last),
+ * for its progress; NULL before the first run.
+ */
+ControlBlock* ThreadedSearch::getControlBlock()
+{
+    return this->control;
+}
+
+/**
+ * Returns the number of online cores.
+ */
+int ThreadedSearch::getNumberOfCores()
+{
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    return (0 < cores) ? (int) cores : 1;
+}
+
+/**
+ * Searches [firstCandidate, lastCandidate) with the threads, which take chunks
+ * of it from a shared cursor, and waits for all of them.
+ * 
+ * @param foundCandidate Receives the matching candidate, if any.
+ * @return Whether a matching candidate was found.
+ */
+bool ThreadedSearch::run(uint64_t firstCandidate, uint64_t lastCandidate, uint64_t& foundCandidate)
+{
+    // every run gets a fresh control block, shared by the threads only.
+    pthread_mutex_lock(&this->controlMutex);
+    if (NULL != this->control) {
+        ControlBlock::close(this->control);
+    }
+    this->control = ControlBlock::create("", this->numberOfThreads, firstCandidate, lastCandidate);
+    if (NULL != this->control && this->cancelled) {
+        this->control->cancel();
+    }
+    pthread_mutex_unlock(&this->controlMutex);
+    if (NULL == this->control) {
+        Logger::writeToLogFile("ERROR: Can't create the control block of the search threads!");
+        return false;
+    }
+    for (int i = 0; i < this->numberOfThreads; i++) {
+        this->engines[i]->setCancelFlag(this->control->getCancelFlag());
+    }
+    
+    std::vector<Worker> workers(this->numberOfThreads);
+    for (int i = 0; i < this->numberOfThreads; i++) {
+        workers[i].search = this;
+        workers[i].index = i;
+    }
+    
+    if (NULL != this->checkpoint) {
+        this->checkpoint->start(this->control, this->checkpointInterval);
+    }
+    
+    // start the threads; if one can't be started, this thread joins in the
+    // search once the others are running.
+    std::vector<bool> started(this->numberOfThreads, false);
+    for (int i = 0; i < this->numberOfThreads; i++) {
+        started[i] = (0 == pthread_create(&workers[i].thread, NULL, ThreadedSearch::workerMain, &workers[i]));
+        if (! started[i]) {
+            Logger::writeToLogFile("ERROR: Can't create a search thread!");
+        }
+    }
+    for (int i = 0; i < this->numberOfThreads; i++) {
+        if (! started[i]) {
+            this->work(&workers[i]);
+        }
+    }
+    
+    // wait for every thread to exit.
+    for (int i = 0; i < this->numberOfThreads; i++) {
+        if (started[i]) {
+            pthread_join(workers[i].thread, NULL);
+        }
+    }
+    if (NULL != this->checkpoint) {
+        this->checkpoint->stop();
+    }
+    
+    if (NULL != this->targets) {
+        return this->targets->isAllFound();
+    }
+    if (! this->control->isFound()) {
+        return false;
+    }
+    foundCandidate = this->control->getFoundCandidate();
+    return true;
+}
+
+/**
+ * Entry point of the worker threads: pins the thread to a core and starts
+ * searching.
+ * 
+ * @param worker Pointer to the Worker of the thread.
+ */
+void* ThreadedSearch::workerMain(void* worker)
+{
+    Worker* self = (Worker*) worker;
+
+#ifdef __linux__
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(self->index % ThreadedSearch::getNumberOfCores(), &cpus);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+#endif
+    
+    self->search->work(self);
+    
+    return NULL;
+}
+
+/**
+ * Searches chunk after chunk until the key space is exhausted or another
+ * thread has found the key.
+ */
+void ThreadedSearch::work(Worker* worker)
+{
+    AlgorithmDESBitslice& algorithm = *this->engines[worker->index];
+    KeyspaceScheduler scheduler(this->control->getKeyspace(), algorithm.getLanes());
+    WorkerStatus* status = this->control->getWorker(worker->index);
+    scheduler.setLowWaterMark(&status->lowWaterMark);
+    
+    uint64_t first, last, candidate;
+    while (! this->control->isCancelled() && scheduler.nextChunk(first, last)) {
+        uint64_t started = TraceEvent::now();
+        
+        // a batch search goes on until every target has its key.
+        if (NULL != this->targets) {
+            algorithm.searchTargets(*this->targets, this->pattern, first, last);
+            
+            // an engine that sees the cancel flag gives up in the middle of
+            // the chunk, which then doesn't count as searched.
+            if (this->control->isCancelled()) {
+                return;
+            }
+            Logger::writeTraceEvent(TRACE_CHUNK_DONE, worker->index, first, last, last - first, TraceEvent::now() - started);
+            status->keysSearched.fetch_add(last - first, std::memory_order_relaxed);
+            status->keysPerSecond.store(scheduler.getKeysPerSecond(), std::memory_order_relaxed);
+            if (this->targets->isAllFound()) {
+                this->control->cancel();
+            }
+            continue;
+        }
+        
+        bool found;
+        if (NULL != this->words) {
+            found = algorithm.searchWordList(this->rawString, this->encryptedString, *this->words, first, last, candidate);
+        } else if (NULL != this->keys) {
+            found = algorithm.searchKeyList(this->rawString, this->encryptedString, *this->keys, first, last, candidate);
+        } else {
+            found = algorithm.searchKeys(this->rawString, this->encryptedString, this->pattern, first, last, candidate);
+        }
+        
+        // a search that sees the cancel flag gives up somewhere in the
+        // chunk, and its progress is unknown.
+        if (! found && this->control->isCancelled()) {
+            return;
+        }
+        // a search that finds the key stops there.
+        uint64_t keys = found ? candidate + 1 - first : last - first;
+        Logger::writeTraceEvent(TRACE_CHUNK_DONE, worker->index, first, last, keys, TraceEvent::now() - started);
+        status->keysSearched.fetch_add(keys, std::memory_order_relaxed);
+        status->keysPerSecond.store(scheduler.getKeysPerSecond(), std::memory_order_relaxed);
+        
+        if (found) {
+            // only the first thread to find a key reports it; the others see
+            // the cancel flag it sets.
+            Logger::writeTraceEvent(TRACE_KEY_FOUND, worker->index, candidate, candidate + 1, 0, 0);
+            this->control->reportFound(candidate);
+            return;
+        }
+    }
+}
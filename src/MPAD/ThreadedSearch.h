@@ -0,0 +1,226 @@
+/**
+ * File: ThreadedSearch.h
+ * 
+ * Header file for the ThreadedSearch class.
+ * 
+ * @version 0.1
+ */
+
+// make sure that the signature of the class is defined only once.
+#ifndef THREADEDSEARCH_H
+#define	THREADEDSEARCH_H
+
+// include the string library for the std::string class.
+#include <string>
+
+// include the vector library.
+#include <vector>
+
+// include the POSIX thread library.
+#include <pthread.h>
+
+// include the bitsliced DES engine.
+#include "AlgorithmDESBitslice.h"
+
+// include the ControlBlock class signature.
+#include "ControlBlock.h"
+
+// include the Checkpoint class signature.
+#include "Checkpoint.h"
+
+// include the TargetSet class signature.
+#include "TargetSet.h"
+
+/**
+ * Signature of the ThreadedSearch class.
+ * 
+ * ThreadedSearch runs the key search in worker threads of the calling process
+ * instead of in child processes: one thread per core, each pinned to its own
+ * core. The threads share a single copy of the raw/encrypted string pair and
+ * a ControlBlock, the same one child processes use: they take chunks of the
+ * key space from it, publish their progress in it and stop as soon as one of
+ * them reports the key there. Each thread has an engine of its own, whose
+ * scratch buffers it reuses from one chunk to the next.
+ * 
+ * Given a TargetSet, the threads search for the keys of every target in it
+ * instead of for the key of the string pair, and stop once each target has
+ * its key.
+ * 
+ * @since version 0.1
+ * @see MainProcess
+ */
+class ThreadedSearch
+{
+    // public attributes and methods of the class.
+    public:
+        
+        /**
+         * Constructor method of the class.
+         * 
+         * @param pattern The known and the free bits of the keys searched.
+         * @param numberOfThreads Number of worker threads; 0 means one per
+         * online core.
+         */
+        ThreadedSearch(std::string rawString, std::string encryptedString, const KeyPattern& pattern, int numberOfThreads);
+        
+        /**
+         * Searches [firstCandidate, lastCandidate) with the threads, which
+         * take chunks of it from a shared cursor, and waits for all of them.
+         * 
+         * @param foundCandidate Receives the matching candidate, if any.
+         * @return Whether a matching candidate was found.
+         */
+        bool run(uint64_t firstCandidate, uint64_t lastCandidate, uint64_t& foundCandidate);
+        
+        /**
+         * Makes run() write its progress to the given checkpoint.
+         * 
+         * @param checkpoint The checkpoint, or NULL for none.
+         * @param intervalSeconds Seconds between two writes.
+         */
+        void setCheckpoint(Checkpoint* checkpoint, int intervalSeconds);
+        
+        /**
+         * Makes run() search for the keys of a batch of targets instead of
+         * the key of the string pair; run() then returns whether every
+         * target has its key, and the keys are in the set.
+         * 
+         * @param targets The targets, or NULL for the string pair.
+         */
+        void setTargets(TargetSet* targets);
+        
+        /**
+         * Makes run() search the keys of a key list instead of the keys of
+         * the key pattern; the candidates are then lines of the list.
+         * 
+         * @param keys The key list, or NULL for the key pattern.
+         */
+        void setKeyList(const KeyList* keys);
+        
+        /**
+         * Makes run() search the keys of the passwords of a word list
+         * instead of the keys of the key pattern; the candidates are then
+         * offsets in the list.
+         * 
+         * @param words The word list, or NULL for the key pattern.
+         */
+        void setWordList(const WordList* words);
+        
+        /**
+         * Stops the search that is running, and makes any later run() return
+         * right away; it may be called from another thread.
+         */
+        void cancel();
+        
+        /**
+         * Returns the number of worker threads.
+         */
+        int getNumberOfThreads();
+        
+        /**
+         * Returns the key search engine of the first thread; the others use
+         * the same kernel.
+         */
+        AlgorithmDESBitslice& getAlgorithm();
+        
+        /**
+         * Returns the control block of the search that is running (or has
+         * run last), for its progress; NULL before the first run.
+         */
+        ControlBlock* getControlBlock();
+        
+        /**
+         * Destructor method of the class.
+         */
+        ~ThreadedSearch();
+        
+        /**
+         * Returns the number of online cores.
+         */
+        static int getNumberOfCores();
+    
+    // private attributes and methods of the class.
+    private:
+        
+        /**
+         * What a worker thread is given when it is started.
+         */
+        struct Worker
+        {
+            ThreadedSearch* search;
+            pthread_t thread;
+            int index;
+        };
+        
+        /**
+         * The known raw/encrypted string pair, shared by all threads.
+         */
+        std::string rawString;
+        std::string encryptedString;
+        
+        /**
+         * The known and the free bits of the keys searched.
+         */
+        KeyPattern pattern;
+        
+        /**
+         * Number of worker threads.
+         */
+        int numberOfThreads;
+        
+        /**
+         * The key search engines, one per thread, so that each has scratch
+         * buffers of its own; they use the same kernel.
+         */
+        std::vector<AlgorithmDESBitslice*> engines;
+        
+        /**
+         * The key space cursor, the found key, the cancel flag and the
+         * progress of the threads.
+         */
+        ControlBlock* control;
+        
+        /**
+         * Whether cancel() has been called, and what keeps it from running
+         * into run() replacing the control block.
+         */
+        bool cancelled;
+        pthread_mutex_t controlMutex;
+        
+        /**
+         * Where run() writes its progress, if anywhere, and how often.
+         */
+        Checkpoint* checkpoint;
+        int checkpointInterval;
+        
+        /**
+         * The targets of a batch search, if any.
+         */
+        TargetSet* targets;
+        
+        /**
+         * The key list searched, if any.
+         */
+        const KeyList* keys;
+        
+        /**
+         * The word list searched, if any.
+         */
+        const WordList* words;
+        
+        /**
+         * Entry point of the worker threads.
+         * 
+         * @param worker Pointer to the Worker of the thread.
+         */
+        static void* workerMain(void* worker);
+        
+        /**
+         * Searches chunk after chunk until the key space is exhausted or
+         * another thread has found the key.
+         */
+        void work(Worker* worker);
+};
+
+// end of the class signature.
+#endif	/* THREADEDSEARCH_H */
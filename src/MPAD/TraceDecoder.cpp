@@ -0,0 +1,195 @@
+/**
+ * File: TraceDecoder.cpp
+ * 
+ * Source code file for the TraceDecoder class.
+ * 
+ * @version 0.1
+ */
+
+// include standard libraries.
+#include <cstdlib>
+#include <stdio.h>
+
+// include the string library.
+#include <string.h>
+
+// include the stream related libraries.
+#include <iostream>
+#include <fstream>
+
+// include the map library.
+#include <map>
+
+// include the signature of the class.
+#include "TraceDecoder.h"
+
+/**
+ * Main entry of the trace_p tool.
+ * 
+ * @return The exit status of the application.
+ */
+int main(int argc, char **argv)
+{
+    std::string format = (1 < argc) ? argv[1] : "summary";
+    std::string path = (2 < argc) ? argv[2] : "mpad.trace";
+    
+    if ("csv" != format && "json" != format && "summary" != format) {
+        fprintf(stderr, "usage: %s [csv|json|summary] [trace file]\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    
+    TraceDecoder decoder;
+    if (! decoder.load(path)) {
+        fprintf(stderr, "Could not read the trace file %s!\n", path.c_str());
+        exit(EXIT_FAILURE);
+    }
+    
+    if ("csv" == format) {
+        decoder.writeCsv(std::cout);
+    } else if ("json" == format) {
+        decoder.writeJson(std::cout);
+    } else {
+        decoder.writeSummary(std::cout);
+    }
+    
+    // terminate the application.
+    exit(EXIT_SUCCESS);
+}
+
+/**
+ * Reads the events of a trace file.
+ * 
+ * @return Whether the file could be read; a partly written last record is
+ * ignored.
+ */
+bool TraceDecoder::load(std::string path)
+{
+    std::ifstream file(path.c_str(), std::ios::binary);
+    if (! file.is_open()) {
+        return false;
+    }
+    
+    TraceEvent event;
+    while (file.read((char*) &event, sizeof(event))) {
+        this->events.push_back(event);
+    }
+    
+    return true;
+}
+
+/**
+ * Returns the name of an event type.
+ */
+const char* TraceDecoder::getTypeName(uint16_t type)
+{
+    switch (type) {
+        case TRACE_SEARCH_START:
+            return "search_start";
+        case TRACE_CHILD_SPAWN:
+            return "child_spawn";
+        case TRACE_CHUNK_DONE:
+            return "chunk_done";
+        case TRACE_KEY_FOUND:
+            return "key_found";
+        case TRACE_CHILD_EXIT:
+            return "child_exit";
+        case TRACE_SEARCH_END:
+            return "search_end";
+        default:
+            return "unknown";
+    }
+}
+
+/**
+ * Writes the events as CSV, one line per event.
+ */
+void TraceDecoder::writeCsv(std::ostream& output)
+{
+    output << "timestamp_ns,pid,type,worker,first,last,counter,value\n";
+    for (size_t i = 0; i < this->events.size(); i++) {
+        const TraceEvent& event = this->events[i];
+        output << event.timestamp << ',' << event.processId << ',' << TraceDecoder::getTypeName(event.type) << ',' << event.worker << ','
+            << event.first << ',' << event.last << ',' << event.counter << ',' << event.value << '\n';
+    }
+}
+
+/**
+ * Writes the events as a JSON array of objects.
+ */
+void TraceDecoder::writeJson(std::ostream& output)
+{
+    output << "[\n";
+    for (size_t i = 0; i < this->events.size(); i++) {
+        const TraceEvent& event = this->events[i];
+        output << "  {\"timestamp_ns\": " << event.timestamp << ", \"pid\": " << event.processId
+            << ", \"type\": \"" << TraceDecoder::getTypeName(event.type) << "\", \"worker\": " << event.worker
+            << ", \"first\": " << event.first << ", \"last\": " << event.last
+            << ", \"counter\": " << event.counter << ", \"value\": " << event.value << "}"
+            << ((i + 1 < this->events.size()) ? ",\n" : "\n");
+    }
+    output << "]\n";
+}
+
+/**
+ * Writes the keys, the busy time and the keys/second of every worker, the
+ * total, and the time from the start of the search to the key.
+ */
+void TraceDecoder::writeSummary(std::ostream& output)
+{
+    // a worker is a child process, or a thread of the main process; the
+    // process id and the worker index tell them apart.
+    struct Throughput
+    {
+        uint64_t chunks;
+        uint64_t keys;
+        uint64_t nanoseconds;
+    };
+    std::map<std::pair<uint32_t, uint16_t>, Throughput> workers;
+    
+    uint64_t searchStart = 0, searchEnd = 0, firstResult = 0;
+    bool started = false, ended = false, found = false;
+    uint64_t foundCandidate = 0;
+    for (size_t i = 0; i < this->events.size(); i++) {
+        const TraceEvent& event = this->events[i];
+        if (TRACE_CHUNK_DONE == event.type) {
+            Throughput& worker = workers[std::make_pair(event.processId, event.worker)];
+            worker.chunks++;
+            worker.keys += event.counter;
+            worker.nanoseconds += event.value;
+        } else if (TRACE_SEARCH_START == event.type && (! started || event.timestamp < searchStart)) {
+            searchStart = event.timestamp;
+            started = true;
+        } else if (TRACE_SEARCH_END == event.type && (! ended || event.timestamp > searchEnd)) {
+            searchEnd = event.timestamp;
+            ended = true;
+        } else if (TRACE_KEY_FOUND == event.type && (! found || event.timestamp < firstResult)) {
+            firstResult = event.timestamp;
+            foundCandidate = event.first;
+            found = true;
+        }
+    }
+    
+    output << "pid,worker,chunks,keys,busy_seconds,keys_per_second\n";
+    uint64_t totalChunks = 0, totalKeys = 0;
+    double totalRate = 0;
+    std::map<std::pair<uint32_t, uint16_t>, Throughput>::iterator worker;
+    for (worker = workers.begin(); worker != workers.end(); ++worker) {
+        double seconds = worker->second.nanoseconds / 1e9;
+        double rate = (0 < seconds) ? worker->second.keys / seconds : 0;
+        output << worker->first.first << ',' << worker->first.second << ',' << worker->second.chunks << ',' << worker->second.keys << ','
+            << seconds << ',' << (uint64_t) rate << '\n';
+        
+        totalChunks += worker->second.chunks;
+        totalKeys += worker->second.keys;
+        totalRate += rate;
+    }
+    output << "total," << workers.size() << ',' << totalChunks << ',' << totalKeys << ",," << (uint64_t) totalRate << '\n';
+    
+    if (started && ended) {
+        output << "search_seconds," << (searchEnd - searchStart) / 1e9 << '\n';
+    }
+    if (started && found) {
+        output << "time_to_first_result_seconds," << (firstResult - searchStart) / 1e9 << '\n';
+        output << "found_candidate," << foundCandidate << '\n';
+    }
+}
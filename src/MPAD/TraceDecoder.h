@@ -0,0 +1,82 @@
+/**
+ * File: TraceDecoder.h
+ * 
+ * Header file for the TraceDecoder class.
+ * 
+ * @version 0.1
+ */
+
+// make sure that the signature of the class is defined only once.
+#ifndef TRACEDECODER_H
+#define	TRACEDECODER_H
+
+// include the string library for the std::string class.
+#include <string>
+
+// include the vector library.
+#include <vector>
+
+// include the output stream library.
+#include <ostream>
+
+// include the TraceEvent structure.
+#include "TraceEvent.h"
+
+/**
+ * Signature of the TraceDecoder class.
+ * 
+ * TraceDecoder reads the binary search trace (mpad.trace) and turns it into
+ * CSV or JSON, or summarizes it: the throughput of every worker and the time
+ * it took to find the key. It is the trace_p tool:
+ * 
+ *     trace_p [csv|json|summary] [trace file]
+ * 
+ * @since version 0.1
+ * @see TraceEvent
+ * @see Logger
+ */
+class TraceDecoder
+{
+    // public attributes and methods of the class.
+    public:
+        
+        /**
+         * Reads the events of a trace file.
+         * 
+         * @return Whether the file could be read; a partly written last
+         * record is ignored.
+         */
+        bool load(std::string path);
+        
+        /**
+         * Writes the events as CSV, one line per event.
+         */
+        void writeCsv(std::ostream& output);
+        
+        /**
+         * Writes the events as a JSON array of objects.
+         */
+        void writeJson(std::ostream& output);
+        
+        /**
+         * Writes the keys, the busy time and the keys/second of every worker,
+         * the total, and the time from the start of the search to the key.
+         */
+        void writeSummary(std::ostream& output);
+        
+        /**
+         * Returns the name of an event type.
+         */
+        static const char* getTypeName(uint16_t type);
+    
+    // private attributes and methods of the class.
+    private:
+        
+        /**
+         * The events, in the order they are in the file.
+         */
+        std::vector<TraceEvent> events;
+};
+
+// end of the class signature.
+#endif	/* TRACEDECODER_H */
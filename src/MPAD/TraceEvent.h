@@ -0,0 +1,115 @@
+/**
+ * File: TraceEvent.h
+ * 
+ * Header file for the TraceEvent structure, the record of the binary search
+ * trace.
+ * 
+ * @version 0.1
+ */
+
+// make sure that the signature of the structure is defined only once.
+#ifndef TRACEEVENT_H
+#define	TRACEEVENT_H
+
+// include the fixed-width integer types.
+#include <stdint.h>
+
+// include the clock_gettime function.
+#include <time.h>
+
+/**
+ * Types of the trace events. What first, last, counter and value hold
+ * depends on the type.
+ */
+enum TraceEventType
+{
+    /**
+     * The main process starts a search of [first, last) with counter
+     * workers.
+     */
+    TRACE_SEARCH_START = 1,
+    
+    /**
+     * The main process has started a child: worker is its index, value its
+     * process id.
+     */
+    TRACE_CHILD_SPAWN = 2,
+    
+    /**
+     * A worker has searched [first, last): counter is the number of keys,
+     * value the time it took in nanoseconds.
+     */
+    TRACE_CHUNK_DONE = 3,
+    
+    /**
+     * A worker has found the key: first is the candidate.
+     */
+    TRACE_KEY_FOUND = 4,
+    
+    /**
+     * A child has exited: worker is its index, value its process id, counter
+     * its wait status.
+     */
+    TRACE_CHILD_EXIT = 5,
+    
+    /**
+     * The search is over: counter is the number of keys searched, value the
+     * keys/second of the workers at the end.
+     */
+    TRACE_SEARCH_END = 6
+};
+
+/**
+ * A record of the binary search trace (mpad.trace). Records have a fixed size
+ * and are written in the byte order of the machine, one after the other.
+ * 
+ * @see Logger
+ * @see TraceDecoder
+ */
+struct TraceEvent
+{
+    /**
+     * Time of the event in nanoseconds on the monotonic clock, which every
+     * process of the machine shares.
+     */
+    uint64_t timestamp;
+    
+    /**
+     * Process id of the process the event happened in.
+     */
+    uint32_t processId;
+    
+    /**
+     * The event type (see TraceEventType).
+     */
+    uint16_t type;
+    
+    /**
+     * Index of the worker (child process or thread) the event is about.
+     */
+    uint16_t worker;
+    
+    /**
+     * A key range, a counter and a value; their meaning depends on the type.
+     */
+    uint64_t first;
+    uint64_t last;
+    uint64_t counter;
+    uint64_t value;
+    
+    /**
+     * Returns the time on the monotonic clock, in nanoseconds.
+     */
+    static uint64_t now()
+    {
+        struct timespec time;
+        clock_gettime(CLOCK_MONOTONIC, &time);
+        return (uint64_t) time.tv_sec * 1000000000 + time.tv_nsec;
+    }
+};
+
+// the decoder relies on the size of a record.
+static_assert(48 == sizeof(TraceEvent), "TraceEvent must be 48 bytes");
+
+// end of the structure signature.
+#endif	/* TRACEEVENT_H */
@@ -0,0 +1,179 @@
+/**
+ * File: WordList.cpp
+ * 
+ * Source code file for the WordList class.
+ * 
+ * @version 0.1
+ */
+
+// include the string library.
+#include <string.h>
+
+// include the signature of the class.
+#include "WordList.h"
+
+/**
+ * Maps the word file at the given path.
+ * 
+ * @return Whether the file could be mapped.
+ */
+bool WordList::open(const std::string& path)
+{
+    if (! this->file.open(path)) {
+        return false;
+    }
+    this->file.adviseSequential();
+    return true;
+}
+
+/**
+ * Returns the size of the file, i.e. the end of the key space.
+ */
+uint64_t WordList::getSize() const
+{
+    return this->file.getSize();
+}
+
+/**
+ * Derives the keys of the words that start in [position, lastPosition), up
+ * to count of them. A word that starts before position belongs to the chunk
+ * before, and is skipped. Empty lines are skipped, too.
+ * 
+ * @param position Where to start; receives where to go on from.
+ * @param lastPosition End of the chunk.
+ * @param keys Receives the keys.
+ * @param positions Receives the offsets of the words.
+ * @param count Most keys to derive.
+ * @return The number of keys derived; 0 once the chunk is done.
+ */
+size_t WordList::deriveKeys(uint64_t& position, uint64_t lastPosition, uint64_t* keys, uint64_t* positions, size_t count) const
+{
+    const char* data = this->file.getData();
+    const uint64_t size = this->file.getSize();
+    if (lastPosition > size) {
+        lastPosition = size;
+    }
+    
+    // a word starts at the beginning of the file or after a newline.
+    if (0 < position && position < lastPosition && '\n' != data[position - 1]) {
+        const char* end = (const char*) memchr(data + position, '\n', size - position);
+        position = (NULL != end) ? end - data + 1 : size;
+    }
+    
+    size_t derived = 0;
+    while (derived < count && position < lastPosition) {
+        const char* word = data + position;
+        uint64_t next;
+        size_t length;
+        
+        // the word is read 8 bytes at a time, looking for the newline and
+        // folding the bytes before it in one go; only the last few bytes of
+        // the file are read one by one.
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        uint64_t folded = 0, chunk, newlines;
+        for (length = 0; 8 <= size - position - length; length += 8) {
+            memcpy(&chunk, word + length, 8);
+            newlines = chunk ^ 0x0A0A0A0A0A0A0A0AULL;
+            newlines = (newlines - 0x0101010101010101ULL) & ~newlines & 0x8080808080808080ULL;
+            if (0 != newlines) {
+                break;
+            }
+            folded ^= chunk;
+        }
+        if (8 <= size - position - length) {
+            int tail = __builtin_ctzll(newlines) / 8;
+            folded ^= chunk & ((1ULL << (8 * tail)) - 1);
+            length += tail;
+            next = position + length + 1;
+            if (0 < length && '\r' == word[length - 1]) {
+                length--;
+                folded ^= (uint64_t) '\r' << (8 * (length % 8));
+            }
+            if (0 < length) {
+                keys[derived] = WordList::foldKey(folded);
+                positions[derived] = position;
+                derived++;
+            }
+            position = next;
+            continue;
+        }
+#endif
+        
+        length = this->getLineLength(position, next);
+        if (0 < length) {
+            keys[derived] = WordList::deriveKey(word, length);
+            positions[derived] = position;
+            derived++;
+        }
+        position = next;
+    }
+    
+    return derived;
+}
+
+/**
+ * Returns the word that starts at the given offset.
+ */
+std::string WordList::getWord(uint64_t position) const
+{
+    if (position >= this->file.getSize()) {
+        return "";
+    }
+    
+    uint64_t next;
+    size_t length = this->getLineLength(position, next);
+    return std::string(this->file.getData() + position, length);
+}
+
+/**
+ * Derives the DES key of an ASCII password: the 7 bits of each character are
+ * the 7 key bits of a byte (the lowest bit of each byte is a parity bit,
+ * which DES ignores), and the characters past the eighth are folded into the
+ * key with XOR, byte by byte.
+ */
+uint64_t WordList::deriveKey(const char* word, size_t length)
+{
+    // shifting every byte commutes with folding them, so the word is folded
+    // 8 characters at a time and shifted once.
+    uint64_t folded = 0, chunk;
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        memcpy(&chunk, word + i, 8);
+        folded ^= chunk;
+    }
+    if (i < length) {
+        chunk = 0;
+        memcpy(&chunk, word + i, length - i);
+        folded ^= chunk;
+    }
+    
+    return WordList::foldKey(folded);
+}
+
+/**
+ * Turns 8 folded characters, the first one in the lowest byte of the
+ * word's memory, into a key.
+ */
+uint64_t WordList::foldKey(uint64_t folded)
+{
+    // the first character is the most significant byte of the key.
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    folded = __builtin_bswap64(folded);
+#endif
+    return (folded << 1) & 0xFEFEFEFEFEFEFEFEULL;
+}
+
+/**
+ * Returns the length of the line at the given offset, without the newline
+ * (and the carriage return before it, if any).
+ * 
+ * @param next Receives the offset of the next line.
+ */
+size_t WordList::getLineLength(uint64_t position, uint64_t& next) const
+{
+    size_t offset = position, length;
+    const char* line;
+    this->file.nextLine(offset, line, length);
+    next = offset;
+    return length;
+}
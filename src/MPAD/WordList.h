@@ -0,0 +1,105 @@
+/**
+ * File: WordList.h
+ * 
+ * Header file for the WordList class.
+ * 
+ * @version 0.1
+ */
+
+// make sure that the signature of the class is defined only once.
+#ifndef WORDLIST_H
+#define	WORDLIST_H
+
+// include the string library for the std::string class.
+#include <string>
+
+// include the fixed-width integer types.
+#include <stdint.h>
+
+// include the MappedFile class signature.
+#include "MappedFile.h"
+
+/**
+ * Signature of the WordList class.
+ * 
+ * WordList is a file of passwords, one per line, whose keys are searched
+ * instead of the keys of a key pattern. The lines are of any length, so the
+ * candidates of the search are the byte offsets in the file: the words of a
+ * chunk [first, last) of the key space are the ones that start in it. The
+ * key of a password is derived by deriveKey.
+ * 
+ * The file is mapped (see MappedFile) and read from the beginning to the end
+ * of each chunk, so the words stream in as the keys are tested.
+ * 
+ * @since version 0.1
+ * @see MappedFile
+ * @see PasswordPipeline
+ */
+class WordList
+{
+    // public attributes and methods of the class.
+    public:
+        
+        /**
+         * Maps the word file at the given path.
+         * 
+         * @return Whether the file could be mapped.
+         */
+        bool open(const std::string& path);
+        
+        /**
+         * Returns the size of the file, i.e. the end of the key space.
+         */
+        uint64_t getSize() const;
+        
+        /**
+         * Derives the keys of the words that start in [position,
+         * lastPosition), up to count of them. A word that starts before
+         * position belongs to the chunk before, and is skipped. Empty lines
+         * are skipped, too.
+         * 
+         * @param position Where to start; receives where to go on from.
+         * @param lastPosition End of the chunk.
+         * @param keys Receives the keys.
+         * @param positions Receives the offsets of the words.
+         * @param count Most keys to derive.
+         * @return The number of keys derived; 0 once the chunk is done.
+         */
+        size_t deriveKeys(uint64_t& position, uint64_t lastPosition, uint64_t* keys, uint64_t* positions, size_t count) const;
+        
+        /**
+         * Returns the word that starts at the given offset.
+         */
+        std::string getWord(uint64_t position) const;
+        
+        /**
+         * Derives the DES key of an ASCII password: the 7 bits of each
+         * character are the 7 key bits of a byte (the lowest bit of each
+         * byte is a parity bit, which DES ignores), and the characters past
+         * the eighth are folded into the key with XOR, byte by byte.
+         */
+        static uint64_t deriveKey(const char* word, size_t length);
+    
+    // private attributes and methods of the class.
+    private:
+        
+        /**
+         * The mapped file.
+         */
+        MappedFile file;
+        
+        /**
+         * Turns 8 folded characters, the first one in the lowest byte of
+         * the word's memory, into a key.
+         */
+        static uint64_t foldKey(uint64_t folded);
+        
+        /**
+         * Returns the length of the line at the given offset, without the
+         * newline (and the carriage return before it, if any).
+         */
+        size_t getLineLength(uint64_t position, uint64_t& next) const;
+};
+
+// end of the class signature.
+#endif	/* WORDLIST_H */
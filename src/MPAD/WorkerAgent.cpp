@@ -0,0 +1,252 @@
+/**
+ * File: WorkerAgent.cpp
+ * 
+ * Source code file for the WorkerAgent class.
+ * 
+ * @version 0.1
+ */
+
+// include standard libraries.
+#include <stdlib.h>
+
+// include the poll and shutdown functions.
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// include the errno library for the errno variable.
+#include <errno.h>
+
+// include the stream related libraries.
+#include <sstream>
+
+// include the signature of the class.
+#include "WorkerAgent.h"
+
+// include the Logger class signature.
+#include "Logger.h"
+
+// include the TraceEvent clock.
+#include "TraceEvent.h"
+
+/**
+ * Constructor method of the class.
+ * 
+ * @param address Address of the coordinator ("host:port" or "unix:path").
+ * @param numberOfThreads Number of worker threads; 0 means one per online
+ * core.
+ */
+WorkerAgent::WorkerAgent(std::string address, int numberOfThreads)
+{
+    this->address = address;
+    this->numberOfThreads = (0 < numberOfThreads) ? numberOfThreads : ThreadedSearch::getNumberOfCores();
+    this->channel = NULL;
+    this->search = NULL;
+    this->leaseId = 0;
+    this->stopped = false;
+    pthread_mutex_init(&this->mutex, NULL);
+    pthread_cond_init(&this->condition, NULL);
+}
+
+/**
+ * Destructor method of the class.
+ */
+WorkerAgent::~WorkerAgent()
+{
+    delete this->search;
+    delete this->channel;
+    pthread_cond_destroy(&this->condition);
+    pthread_mutex_destroy(&this->mutex);
+}
+
+/**
+ * Searches leased ranges until the coordinator says to stop or the
+ * connection is lost.
+ * 
+ * @return Whether the agent ended the way the coordinator said.
+ */
+bool WorkerAgent::run()
+{
+    int socket = SocketChannel::connectTo(this->address);
+    if (0 > socket) {
+        Logger::writeToLogFile("ERROR: The agent can't connect to the coordinator at %s!", this->address);
+        return false;
+    }
+    this->channel = new SocketChannel(socket);
+    if (0 != pthread_create(&this->listener, NULL, WorkerAgent::listenerMain, this)) {
+        Logger::writeToLogFile("ERROR: Can't create the listener thread of the agent!");
+        return false;
+    }
+    
+    std::stringstream hello;
+    hello << "HELLO " << this->numberOfThreads;
+    this->channel->sendLine(hello.str());
+    
+    // the job: the string pair and the key pattern.
+    std::istringstream job(this->nextMessage());
+    std::string command, rawHex, encryptedHex, rawString, encryptedString;
+    uint64_t knownKey, unknownMask;
+    job >> command >> rawHex >> encryptedHex >> std::hex >> knownKey >> unknownMask;
+    bool finished = false;
+    if ("JOB" != command || job.fail()
+        || ! AlgorithmInterface::decodeHex(rawHex.c_str(), rawString) || ! AlgorithmInterface::decodeHex(encryptedHex.c_str(), encryptedString)) {
+        Logger::writeToLogFile("ERROR: The agent hasn't got a job from the coordinator!");
+    } else {
+        pthread_mutex_lock(&this->mutex);
+        this->search = new ThreadedSearch(rawString, encryptedString, KeyPattern(knownKey, unknownMask), this->numberOfThreads);
+        if (this->stopped) {
+            this->search->cancel();
+        }
+        pthread_mutex_unlock(&this->mutex);
+        
+        // make sure that the kernels agree with the reference implementation
+        // before trusting them.
+        if (! this->search->getAlgorithm().selfTest()) {
+            Logger::writeToLogFile("ERROR: The bitsliced DES self-test failed. The agent exits!");
+        } else {
+            std::stringstream message;
+            message << "The agent searches with " << this->search->getNumberOfThreads() << " threads and the "
+                << this->search->getAlgorithm().getKernelName() << " bitsliced DES kernel!";
+            Logger::writeToLogFile(message.str());
+            
+            while (! finished) {
+                this->channel->sendLine("LEASE");
+                std::istringstream reply(this->nextMessage());
+                std::string answer;
+                reply >> answer;
+                
+                if ("WAIT" == answer) {
+                    sleep(1);
+                    continue;
+                }
+                if ("RANGE" != answer) {
+                    // CANCEL or FINISH, or the connection is lost.
+                    finished = ("CANCEL" == answer || "FINISH" == answer);
+                    break;
+                }
+                
+                uint64_t leaseId, first, last, candidate;
+                reply >> leaseId >> first >> last;
+                pthread_mutex_lock(&this->mutex);
+                this->leaseId = leaseId;
+                pthread_mutex_unlock(&this->mutex);
+                
+                uint64_t started = TraceEvent::now();
+                bool found = this->search->run(first, last, candidate);
+                uint64_t microseconds = (TraceEvent::now() - started) / 1000;
+                
+                pthread_mutex_lock(&this->mutex);
+                this->leaseId = 0;
+                bool stopped = this->stopped;
+                pthread_mutex_unlock(&this->mutex);
+                
+                std::stringstream report;
+                if (found) {
+                    report << "FOUND " << leaseId << ' ' << candidate;
+                    Logger::writeToLogFile("The agent has found the key!");
+                } else if (! stopped) {
+                    report << "DONE " << leaseId << ' ' << ((0 < microseconds) ? microseconds : 1);
+                } else {
+                    // the search was cancelled part of the way through.
+                    continue;
+                }
+                this->channel->sendLine(report.str());
+            }
+        }
+    }
+    
+    // the listener thread ends when the connection does.
+    shutdown(socket, SHUT_RDWR);
+    pthread_join(this->listener, NULL);
+    
+    Logger::writeToLogFile(finished ? "The agent is done!" : "ERROR: The agent has lost the coordinator!");
+    return finished;
+}
+
+/**
+ * Waits for the next message of the coordinator.
+ * 
+ * @return The message; "" if the connection is lost.
+ */
+std::string WorkerAgent::nextMessage()
+{
+    pthread_mutex_lock(&this->mutex);
+    while (this->messages.empty() && ! this->stopped) {
+        pthread_cond_wait(&this->condition, &this->mutex);
+    }
+    std::string message;
+    if (! this->messages.empty()) {
+        message = this->messages.front();
+        this->messages.pop_front();
+    }
+    pthread_mutex_unlock(&this->mutex);
+    
+    return message;
+}
+
+/**
+ * Entry point of the listener thread.
+ * 
+ * @param agent Pointer to the WorkerAgent.
+ */
+void* WorkerAgent::listenerMain(void* agent)
+{
+    ((WorkerAgent*) agent)->listen();
+    return NULL;
+}
+
+/**
+ * Receives the messages of the coordinator and renews the lease until the
+ * connection is lost. CANCEL and FINISH stop the search right away; the
+ * other messages are queued for run().
+ */
+void WorkerAgent::listen()
+{
+    bool connected = true;
+    while (connected) {
+        struct pollfd entry;
+        entry.fd = this->channel->getSocket();
+        entry.events = POLLIN;
+        int ready = poll(&entry, 1, 1000);
+        if (0 > ready && EINTR != errno) {
+            break;
+        }
+        
+        if (0 < ready) {
+            connected = this->channel->receive();
+            std::string line;
+            while (this->channel->nextLine(line)) {
+                pthread_mutex_lock(&this->mutex);
+                if (0 == line.compare(0, 6, "CANCEL") || 0 == line.compare(0, 6, "FINISH")) {
+                    this->stopped = true;
+                    if (NULL != this->search) {
+                        this->search->cancel();
+                    }
+                }
+                this->messages.push_back(line);
+                pthread_cond_signal(&this->condition);
+                pthread_mutex_unlock(&this->mutex);
+            }
+        }
+        
+        // the coordinator takes a lease that isn't renewed for a while for
+        // the one of a dead agent.
+        pthread_mutex_lock(&this->mutex);
+        uint64_t leaseId = this->leaseId;
+        pthread_mutex_unlock(&this->mutex);
+        if (connected && 0 != leaseId) {
+            std::stringstream renew;
+            renew << "RENEW " << leaseId;
+            this->channel->sendLine(renew.str());
+        }
+    }
+    
+    // without the coordinator, there is nothing left to search for.
+    pthread_mutex_lock(&this->mutex);
+    this->stopped = true;
+    if (NULL != this->search) {
+        this->search->cancel();
+    }
+    pthread_cond_signal(&this->condition);
+    pthread_mutex_unlock(&this->mutex);
+}
@@ -0,0 +1,141 @@
+/**
+ * File: WorkerAgent.h
+ * 
+ * Header file for the WorkerAgent class.
+ * 
+ * @version 0.1
+ */
+
+// make sure that the signature of the class is defined only once.
+#ifndef WORKERAGENT_H
+#define	WORKERAGENT_H
+
+// include the string library for the std::string class.
+#include <string>
+
+// include the fixed-width integer types.
+#include <stdint.h>
+
+// include the pthread library for the listener thread.
+#include <pthread.h>
+
+// include the deque library for the message queue.
+#include <deque>
+
+// include the SocketChannel class signature.
+#include "SocketChannel.h"
+
+// include the ThreadedSearch class signature.
+#include "ThreadedSearch.h"
+
+/**
+ * Signature of the WorkerAgent class.
+ * 
+ * WorkerAgent searches the key space of a Coordinator on another machine
+ * (or on the same one): it connects to the coordinator, takes the job and
+ * then searches one leased range after the other with the worker threads of
+ * a ThreadedSearch, which go through the range chunk by chunk just as the
+ * child processes do. A listener thread renews the lease every second while
+ * the range is searched, and stops the search as soon as the coordinator
+ * says the key is found. It is started with "main_p agent <address>
+ * [threads]".
+ * 
+ * @since version 0.1
+ * @see Coordinator
+ * @see ThreadedSearch
+ */
+class WorkerAgent
+{
+    // public attributes and methods of the class.
+    public:
+        
+        /**
+         * Constructor method of the class.
+         * 
+         * @param address Address of the coordinator ("host:port" or
+         * "unix:path").
+         * @param numberOfThreads Number of worker threads; 0 means one per
+         * online core.
+         */
+        WorkerAgent(std::string address, int numberOfThreads);
+        
+        /**
+         * Destructor method of the class.
+         */
+        ~WorkerAgent();
+        
+        /**
+         * Searches leased ranges until the coordinator says to stop or the
+         * connection is lost.
+         * 
+         * @return Whether the agent ended the way the coordinator said.
+         */
+        bool run();
+    
+    // private attributes and methods of the class.
+    private:
+        
+        /**
+         * Address of the coordinator, and the number of worker threads.
+         */
+        std::string address;
+        int numberOfThreads;
+        
+        /**
+         * The connection to the coordinator; NULL until connected.
+         */
+        SocketChannel* channel;
+        
+        /**
+         * The search of the job; NULL until the job has come.
+         */
+        ThreadedSearch* search;
+        
+        /**
+         * The lease being searched (0 for none), renewed by the listener
+         * thread.
+         */
+        uint64_t leaseId;
+        
+        /**
+         * Whether the coordinator has said to stop, or the connection is
+         * lost.
+         */
+        bool stopped;
+        
+        /**
+         * The messages the listener thread has received and the agent hasn't
+         * handled yet; everything above is guarded by the mutex.
+         */
+        std::deque<std::string> messages;
+        pthread_mutex_t mutex;
+        pthread_cond_t condition;
+        
+        /**
+         * The listener thread.
+         */
+        pthread_t listener;
+        
+        /**
+         * Waits for the next message of the coordinator.
+         * 
+         * @return The message; "" if the connection is lost.
+         */
+        std::string nextMessage();
+        
+        /**
+         * Entry point of the listener thread.
+         * 
+         * @param agent Pointer to the WorkerAgent.
+         */
+        static void* listenerMain(void* agent);
+        
+        /**
+         * Receives the messages of the coordinator and renews the lease until
+         * the connection is lost.
+         */
+        void listen();
+};
+
+// end of the class signature.
+#endif	/* WORKERAGENT_H */
@@ -36,11 +36,41 @@ OBJECTDIR=${CND_BUILDDIR}/${CND_CONF}/${CND_PLATFORM}
 OBJECTFILES= \
 	${OBJECTDIR}/AlgorithmDES.o \
 	${OBJECTDIR}/Config.o \
-	${OBJECTDIR}/ChildProcess.o \
 	${OBJECTDIR}/Logger.o \
-	${OBJECTDIR}/MainProcess.o
+	${OBJECTDIR}/AlgorithmDESBitslice.o \
+	${OBJECTDIR}/BitsliceAVX2.o \
+	${OBJECTDIR}/BitsliceAVX512.o \
+	${OBJECTDIR}/AlgorithmDESLegacy.o \
+	${OBJECTDIR}/DESCore.o \
+	${OBJECTDIR}/ThreadedSearch.o \
+	${OBJECTDIR}/KeyspaceScheduler.o \
+	${OBJECTDIR}/ControlBlock.o \
+	${OBJECTDIR}/SelfTest.o \
+	${OBJECTDIR}/KeyPattern.o \
+	${OBJECTDIR}/Checkpoint.o \
+	${OBJECTDIR}/SocketChannel.o \
+	${OBJECTDIR}/Coordinator.o \
+	${OBJECTDIR}/WorkerAgent.o \
+	${OBJECTDIR}/TargetSet.o \
+	${OBJECTDIR}/MappedFile.o \
+	${OBJECTDIR}/KeyList.o \
+	${OBJECTDIR}/WordList.o \
+	${OBJECTDIR}/PasswordPipeline.o \
+	${OBJECTDIR}/AlgorithmRegistry.o \
+	${OBJECTDIR}/AlgorithmTripleDES.o \
+	${OBJECTDIR}/MeetInTheMiddle.o \
+	${OBJECTDIR}/CipherStream.o \
+	${OBJECTDIR}/FileCipher.o \
+	${OBJECTDIR}/Arena.o \
+	${OBJECTDIR}/AllocationCounter.o
 
 
+# Object Files with a main of their own, one per binary
+MAIN_OBJECTFILE=${OBJECTDIR}/MainProcess.o
+CHILD_OBJECTFILE=${OBJECTDIR}/ChildProcess.o
+TRACE_OBJECTFILE=${OBJECTDIR}/TraceDecoder.o
+BENCH_OBJECTFILE=${OBJECTDIR}/Benchmark.o
+
 # C Compiler Flags
 CFLAGS=
 
@@ -55,15 +85,27 @@ FFLAGS=
 ASFLAGS=
 
 # Link Libraries and Options
-LDLIBSOPTIONS=
+LDLIBSOPTIONS=-lpthread
 
 # Build Targets
 .build-conf: ${BUILD_SUBPROJECTS}
-	"${MAKE}"  -f nbproject/Makefile-${CND_CONF}.mk ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/mpad
+	"${MAKE}"  -f nbproject/Makefile-${CND_CONF}.mk ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/main_p ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/child_p ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/trace_p ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/mpad-bench
+
+${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/main_p: ${MAIN_OBJECTFILE} ${OBJECTFILES}
+	${MKDIR} -p ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}
+	${LINK.cc} -o ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/main_p ${MAIN_OBJECTFILE} ${OBJECTFILES} ${LDLIBSOPTIONS} 
+
+${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/child_p: ${CHILD_OBJECTFILE} ${OBJECTFILES}
+	${MKDIR} -p ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}
+	${LINK.cc} -o ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/child_p ${CHILD_OBJECTFILE} ${OBJECTFILES} ${LDLIBSOPTIONS} 
+
+${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/trace_p: ${TRACE_OBJECTFILE}
+	${MKDIR} -p ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}
+	${LINK.cc} -o ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/trace_p ${TRACE_OBJECTFILE} ${LDLIBSOPTIONS} 
 
-${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/mpad: ${OBJECTFILES}
+${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/mpad-bench: ${BENCH_OBJECTFILE} ${OBJECTFILES}
 	${MKDIR} -p ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}
-	${LINK.cc} -o ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/mpad ${OBJECTFILES} ${LDLIBSOPTIONS} 
+	${LINK.cc} -o ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/mpad-bench ${BENCH_OBJECTFILE} ${OBJECTFILES} ${LDLIBSOPTIONS} 
 
 ${OBJECTDIR}/AlgorithmDES.o: AlgorithmDES.cpp 
 	${MKDIR} -p ${OBJECTDIR}
@@ -90,13 +132,156 @@ ${OBJECTDIR}/MainProcess.o: MainProcess.cpp
 	${RM} $@.d
 	$(COMPILE.cc) -g -MMD -MP -MF $@.d -o ${OBJECTDIR}/MainProcess.o MainProcess.cpp
 
+${OBJECTDIR}/AlgorithmDESBitslice.o: AlgorithmDESBitslice.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} $@.d
+	$(COMPILE.cc) -g -MMD -MP -MF $@.d -o ${OBJECTDIR}/AlgorithmDESBitslice.o AlgorithmDESBitslice.cpp
+
+${OBJECTDIR}/BitsliceAVX2.o: BitsliceAVX2.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} $@.d
+	$(COMPILE.cc) -g -mavx2 -MMD -MP -MF $@.d -o ${OBJECTDIR}/BitsliceAVX2.o BitsliceAVX2.cpp
+
+${OBJECTDIR}/BitsliceAVX512.o: BitsliceAVX512.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} $@.d
+	$(COMPILE.cc) -g -mavx512f -MMD -MP -MF $@.d -o ${OBJECTDIR}/BitsliceAVX512.o BitsliceAVX512.cpp
+
+${OBJECTDIR}/AlgorithmDESLegacy.o: AlgorithmDESLegacy.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} $@.d
+	$(COMPILE.cc) -g -MMD -MP -MF $@.d -o ${OBJECTDIR}/AlgorithmDESLegacy.o AlgorithmDESLegacy.cpp
+
+${OBJECTDIR}/DESCore.o: DESCore.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} $@.d
+	$(COMPILE.cc) -g -MMD -MP -MF $@.d -o ${OBJECTDIR}/DESCore.o DESCore.cpp
+
+${OBJECTDIR}/ThreadedSearch.o: ThreadedSearch.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} $@.d
+	$(COMPILE.cc) -g -MMD -MP -MF $@.d -o ${OBJECTDIR}/ThreadedSearch.o ThreadedSearch.cpp
+
+${OBJECTDIR}/KeyspaceScheduler.o: KeyspaceScheduler.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} $@.d
+	$(COMPILE.cc) -g -MMD -MP -MF $@.d -o ${OBJECTDIR}/KeyspaceScheduler.o KeyspaceScheduler.cpp
+
+${OBJECTDIR}/ControlBlock.o: ControlBlock.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} $@.d
+	$(COMPILE.cc) -g -MMD -MP -MF $@.d -o ${OBJECTDIR}/ControlBlock.o ControlBlock.cpp
+
+${OBJECTDIR}/TraceDecoder.o: TraceDecoder.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} $@.d
+	$(COMPILE.cc) -g -MMD -MP -MF $@.d -o ${OBJECTDIR}/TraceDecoder.o TraceDecoder.cpp
+
+${OBJECTDIR}/Benchmark.o: Benchmark.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} $@.d
+	$(COMPILE.cc) -g -MMD -MP -MF $@.d -o ${OBJECTDIR}/Benchmark.o Benchmark.cpp
+
+${OBJECTDIR}/SelfTest.o: SelfTest.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} $@.d
+	$(COMPILE.cc) -g -MMD -MP -MF $@.d -o ${OBJECTDIR}/SelfTest.o SelfTest.cpp
+
+${OBJECTDIR}/KeyPattern.o: KeyPattern.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} $@.d
+	$(COMPILE.cc) -g -MMD -MP -MF $@.d -o ${OBJECTDIR}/KeyPattern.o KeyPattern.cpp
+
+${OBJECTDIR}/Checkpoint.o: Checkpoint.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} $@.d
+	$(COMPILE.cc) -g -MMD -MP -MF $@.d -o ${OBJECTDIR}/Checkpoint.o Checkpoint.cpp
+
+${OBJECTDIR}/SocketChannel.o: SocketChannel.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} $@.d
+	$(COMPILE.cc) -g -MMD -MP -MF $@.d -o ${OBJECTDIR}/SocketChannel.o SocketChannel.cpp
+
+${OBJECTDIR}/Coordinator.o: Coordinator.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} $@.d
+	$(COMPILE.cc) -g -MMD -MP -MF $@.d -o ${OBJECTDIR}/Coordinator.o Coordinator.cpp
+
+${OBJECTDIR}/WorkerAgent.o: WorkerAgent.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} $@.d
+	$(COMPILE.cc) -g -MMD -MP -MF $@.d -o ${OBJECTDIR}/WorkerAgent.o WorkerAgent.cpp
+
+${OBJECTDIR}/TargetSet.o: TargetSet.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} $@.d
+	$(COMPILE.cc) -g -MMD -MP -MF $@.d -o ${OBJECTDIR}/TargetSet.o TargetSet.cpp
+
+${OBJECTDIR}/MappedFile.o: MappedFile.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} $@.d
+	$(COMPILE.cc) -g -MMD -MP -MF $@.d -o ${OBJECTDIR}/MappedFile.o MappedFile.cpp
+
+${OBJECTDIR}/KeyList.o: KeyList.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} $@.d
+	$(COMPILE.cc) -g -MMD -MP -MF $@.d -o ${OBJECTDIR}/KeyList.o KeyList.cpp
+
+${OBJECTDIR}/WordList.o: WordList.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} $@.d
+	$(COMPILE.cc) -g -MMD -MP -MF $@.d -o ${OBJECTDIR}/WordList.o WordList.cpp
+
+${OBJECTDIR}/PasswordPipeline.o: PasswordPipeline.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} $@.d
+	$(COMPILE.cc) -g -MMD -MP -MF $@.d -o ${OBJECTDIR}/PasswordPipeline.o PasswordPipeline.cpp
+
+${OBJECTDIR}/AlgorithmRegistry.o: AlgorithmRegistry.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} $@.d
+	$(COMPILE.cc) -g -MMD -MP -MF $@.d -o ${OBJECTDIR}/AlgorithmRegistry.o AlgorithmRegistry.cpp
+
+${OBJECTDIR}/AlgorithmTripleDES.o: AlgorithmTripleDES.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} $@.d
+	$(COMPILE.cc) -g -MMD -MP -MF $@.d -o ${OBJECTDIR}/AlgorithmTripleDES.o AlgorithmTripleDES.cpp
+
+${OBJECTDIR}/MeetInTheMiddle.o: MeetInTheMiddle.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} $@.d
+	$(COMPILE.cc) -g -MMD -MP -MF $@.d -o ${OBJECTDIR}/MeetInTheMiddle.o MeetInTheMiddle.cpp
+
+${OBJECTDIR}/CipherStream.o: CipherStream.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} $@.d
+	$(COMPILE.cc) -g -MMD -MP -MF $@.d -o ${OBJECTDIR}/CipherStream.o CipherStream.cpp
+
+${OBJECTDIR}/FileCipher.o: FileCipher.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} $@.d
+	$(COMPILE.cc) -g -MMD -MP -MF $@.d -o ${OBJECTDIR}/FileCipher.o FileCipher.cpp
+
+${OBJECTDIR}/Arena.o: Arena.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} $@.d
+	$(COMPILE.cc) -g -MMD -MP -MF $@.d -o ${OBJECTDIR}/Arena.o Arena.cpp
+
+${OBJECTDIR}/AllocationCounter.o: AllocationCounter.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} $@.d
+	$(COMPILE.cc) -g -MMD -MP -MF $@.d -o ${OBJECTDIR}/AllocationCounter.o AllocationCounter.cpp
+
 # Subprojects
 .build-subprojects:
 
 # Clean Targets
 .clean-conf: ${CLEAN_SUBPROJECTS}
 	${RM} -r ${CND_BUILDDIR}/${CND_CONF}
-	${RM} ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/mpad
+	${RM} ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/main_p
+	${RM} ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/child_p
+	${RM} ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/trace_p
+	${RM} ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/mpad-bench
 
 # Subprojects
 .clean-subprojects:
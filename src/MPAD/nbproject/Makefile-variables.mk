@@ -9,18 +9,18 @@ CND_DISTDIR=dist
 # Debug configuration
 CND_PLATFORM_Debug=GNU-MacOSX
 CND_ARTIFACT_DIR_Debug=dist/Debug/GNU-MacOSX
-CND_ARTIFACT_NAME_Debug=mpad
-CND_ARTIFACT_PATH_Debug=dist/Debug/GNU-MacOSX/mpad
+CND_ARTIFACT_NAME_Debug=main_p
+CND_ARTIFACT_PATH_Debug=dist/Debug/GNU-MacOSX/main_p
 CND_PACKAGE_DIR_Debug=dist/Debug/GNU-MacOSX/package
-CND_PACKAGE_NAME_Debug=mpad.tar
+CND_PACKAGE_NAME_Debug=main_p.tar
 CND_PACKAGE_PATH_Debug=dist/Debug/GNU-MacOSX/package/mpad.tar
 # Release configuration
 CND_PLATFORM_Release=GNU-MacOSX
 CND_ARTIFACT_DIR_Release=dist/Release/GNU-MacOSX
-CND_ARTIFACT_NAME_Release=mpad
-CND_ARTIFACT_PATH_Release=dist/Release/GNU-MacOSX/mpad
+CND_ARTIFACT_NAME_Release=main_p
+CND_ARTIFACT_PATH_Release=dist/Release/GNU-MacOSX/main_p
 CND_PACKAGE_DIR_Release=dist/Release/GNU-MacOSX/package
-CND_PACKAGE_NAME_Release=mpad.tar
+CND_PACKAGE_NAME_Release=main_p.tar
 CND_PACKAGE_PATH_Release=dist/Release/GNU-MacOSX/package/mpad.tar
 #
 # include compiler specific variables
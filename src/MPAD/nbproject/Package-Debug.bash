@@ -12,8 +12,8 @@ CND_DISTDIR=dist
 CND_BUILDDIR=build
 NBTMPDIR=${CND_BUILDDIR}/${CND_CONF}/${CND_PLATFORM}/tmp-packaging
 TMPDIRNAME=tmp-packaging
-OUTPUT_PATH=${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/mpad
-OUTPUT_BASENAME=mpad
+OUTPUT_PATH=${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/main_p
+OUTPUT_BASENAME=main_p
 PACKAGE_TOP_DIR=mpad/
 
 # Functions
@@ -61,6 +61,7 @@ mkdir -p ${NBTMPDIR}
 cd "${TOP}"
 makeDirectory "${NBTMPDIR}/mpad/bin"
 copyFileToTmpDir "${OUTPUT_PATH}" "${NBTMPDIR}/${PACKAGE_TOP_DIR}bin/${OUTPUT_BASENAME}" 0755
+copyFileToTmpDir "${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/child_p" "${NBTMPDIR}/${PACKAGE_TOP_DIR}bin/child_p" 0755
 
 
 # Generate tar file